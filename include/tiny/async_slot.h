@@ -0,0 +1,173 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "atomic_optional.h"
+#include "optional.h"
+
+#if !defined(TINY_OPTIONAL_CPP20) || !defined(__cpp_impl_coroutine)
+  #error tiny/async_slot.h requires C++20 with coroutine support.
+#endif
+
+#include <atomic>
+#include <coroutine>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// A single-assignment result slot for coroutines: One producer sets the value once via emplace(), and any number of
+// consumers co_await it. The 'not ready' state is the sentinel of 'OptionalType', so apart from the value the slot only
+// stores the head of the list of waiting coroutines (no state enum, no allocation). 'OptionalType' has the same
+// requirements as for tiny::atomic_optional, e.g. tiny::optional<T*> or tiny::optional<std::uint64_t, ~0ull>.
+//
+// co_await suspends only while the slot is empty. The waiting coroutines form a lock-free intrusive stack whose nodes
+// live in the awaiters, i.e. in the coroutine frames. emplace() stores the value, closes the stack and resumes all
+// waiting coroutines on the calling thread. The slot must outlive all coroutines waiting on it. A resumed coroutine may
+// destroy the slot, though: emplace() copies the value into every node before resuming its coroutine, so the remaining
+// waiters do not access the slot anymore.
+template <class OptionalType>
+class async_slot
+{
+private:
+  struct WaiterNode
+  {
+    WaiterNode * next = nullptr;
+    std::coroutine_handle<> handle;
+    // Set by emplace() before resuming 'handle'. Remains empty if the coroutine did not suspend.
+    OptionalType value;
+  };
+
+public:
+  using value_type = OptionalType;
+  using payload_type = typename OptionalType::value_type;
+
+  class awaiter
+  {
+  public:
+    explicit awaiter(async_slot const & slot) noexcept
+      : mSlot(slot)
+    {
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+      return mSlot.mValue.has_value(std::memory_order_acquire);
+    }
+
+    // Returns false (i.e. does not suspend) if the value was emplaced in the meantime.
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+      mNode.handle = handle;
+      WaiterNode * head = mSlot.mWaiters.load(std::memory_order_acquire);
+      do {
+        if (head == mSlot.GetClosedMarker()) {
+          return false;
+        }
+        mNode.next = head;
+      } while (!mSlot.mWaiters.compare_exchange_weak(
+          head, &mNode, std::memory_order_acq_rel, std::memory_order_acquire));
+      return true;
+    }
+
+    [[nodiscard]] payload_type await_resume() const noexcept
+    {
+      if (mNode.value.has_value()) {
+        return *mNode.value;
+      }
+      return *mSlot.mValue.load(std::memory_order_acquire);
+    }
+
+  private:
+    async_slot const & mSlot;
+    WaiterNode mNode;
+  };
+
+  async_slot() noexcept = default;
+
+  async_slot(async_slot const &) = delete;
+  async_slot & operator=(async_slot const &) = delete;
+
+  // Stores the value if the slot is still empty, and resumes all waiting coroutines (on the calling thread). Returns
+  // false if a value was already emplaced before.
+  bool emplace(payload_type const & value)
+  {
+    if (!mValue.try_emplace(value, std::memory_order_release)) {
+      return false;
+    }
+
+    // Coroutines that try to wait from now on see the marker and do not suspend.
+    WaiterNode * node = mWaiters.exchange(GetClosedMarker(), std::memory_order_acq_rel);
+    // A resumed coroutine may destroy the slot and thus also the object referenced by 'value'. Hence neither is accessed
+    // after the first resumption.
+    payload_type const valueCopy = value;
+    while (node != nullptr) {
+      // The resumed coroutine may also destroy its frame, which contains the node.
+      WaiterNode * const next = node->next;
+      node->value = valueCopy;
+      node->handle.resume();
+      node = next;
+    }
+    return true;
+  }
+
+  // Synchronous fast path: Returns the value if it was already emplaced, and an empty optional otherwise.
+  [[nodiscard]] OptionalType try_get() const noexcept
+  {
+    return mValue.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] bool is_ready() const noexcept
+  {
+    return mValue.has_value(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] awaiter operator co_await() const noexcept
+  {
+    return awaiter(*this);
+  }
+
+private:
+  static WaiterNode * GetClosedMarker() noexcept
+  {
+    // Only its address is used. Being static, it does not increase the size of the slot.
+    static WaiterNode closedMarker;
+    return &closedMarker;
+  }
+
+  atomic_optional<OptionalType> mValue;
+  mutable std::atomic<WaiterNode *> mWaiters{nullptr};
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
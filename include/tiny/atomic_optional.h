@@ -0,0 +1,237 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "bulk_conversions.h"
+#include "optional.h"
+
+#include <atomic>
+#include <type_traits>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// An optional that can be accessed concurrently from multiple threads, similar to std::atomic<OptionalType>.
+// 'OptionalType' must be a tiny optional that stores the empty state as sentinel in the whole scalar payload, e.g.
+// tiny::optional<double>, tiny::optional<T*> or tiny::optional<std::uint64_t, ~0ull>. Such an optional is nothing but
+// its payload, so atomic_optional stores the raw bits of the payload (or of the sentinel) in a std::atomic of an
+// unsigned integer of the same size. Consequently, it is lock-free on all common platforms for payloads of up to 8
+// bytes, and it needs no separate flag. (std::atomic<std::optional<double>>, in contrast, is 16 bytes large and
+// typically not lock-free.)
+//
+// As for std::atomic<double>, the compare-exchange operations compare the object representations, not the values via
+// operator==. E.g. 0.0 and -0.0 are different.
+template <class OptionalType>
+class atomic_optional
+{
+  static_assert(
+      is_tiny_optional_v<OptionalType>,
+      "atomic_optional: The template argument must be a tiny optional, e.g. tiny::optional<double>.");
+  static_assert(
+      impl::BulkConversionTraits<OptionalType>::isVectorizable,
+      "atomic_optional: The tiny optional must store the empty state as sentinel in the whole payload, and the payload "
+      "must be a scalar of size 1, 2, 4 or 8 bytes (e.g. tiny::optional<double> or tiny::optional<int, -1>).");
+
+private:
+  using Operations = impl::SentinelRawBitsOperationsFor<OptionalType>;
+  using RawBits = typename Operations::RawBits;
+
+public:
+  using value_type = OptionalType;
+  using payload_type = typename OptionalType::value_type;
+
+  static constexpr bool is_always_lock_free = std::atomic<RawBits>::is_always_lock_free;
+
+  // Constructs an empty optional. The construction itself is not atomic (as for std::atomic).
+  atomic_optional() noexcept
+    : mBits(Operations::GetSentinelBits())
+  {
+  }
+
+  explicit atomic_optional(OptionalType const & initial) noexcept
+    : mBits(ToBits(initial))
+  {
+  }
+
+  atomic_optional(atomic_optional const &) = delete;
+  atomic_optional & operator=(atomic_optional const &) = delete;
+
+  [[nodiscard]] bool is_lock_free() const noexcept
+  {
+    return mBits.is_lock_free();
+  }
+
+  [[nodiscard]] OptionalType load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+  {
+    return FromBits(mBits.load(order));
+  }
+
+  [[nodiscard]] bool has_value(std::memory_order order = std::memory_order_seq_cst) const noexcept
+  {
+    return !Operations::IsEmpty(mBits.load(order));
+  }
+
+  void store(OptionalType const & desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    mBits.store(ToBits(desired), order);
+  }
+
+  [[nodiscard]] OptionalType
+      exchange(OptionalType const & desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    return FromBits(mBits.exchange(ToBits(desired), order));
+  }
+
+  // Atomically replaces the content with an empty optional and returns the previous content. I.e. at most one thread
+  // receives a value that was stored.
+  [[nodiscard]] OptionalType take(std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    return FromBits(mBits.exchange(Operations::GetSentinelBits(), order));
+  }
+
+  // Stores 'value' if and only if the optional is currently empty. Returns true if the value was stored. If several
+  // threads race, exactly one of them succeeds.
+  bool try_emplace(payload_type const & value, std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    RawBits expected = Operations::GetSentinelBits();
+    return mBits.compare_exchange_strong(expected, ToBits(OptionalType(value)), order);
+  }
+
+  // Same semantics as std::atomic::compare_exchange_strong/weak: If the content equals 'expected', it is replaced by
+  // 'desired' and true is returned. Otherwise, 'expected' receives the current content and false is returned.
+  bool compare_exchange_strong(
+      OptionalType & expected,
+      OptionalType const & desired,
+      std::memory_order success,
+      std::memory_order failure) noexcept
+  {
+    RawBits expectedBits = ToBits(expected);
+    bool const exchanged = mBits.compare_exchange_strong(expectedBits, ToBits(desired), success, failure);
+    if (!exchanged) {
+      expected = FromBits(expectedBits);
+    }
+    return exchanged;
+  }
+
+  bool compare_exchange_strong(
+      OptionalType & expected,
+      OptionalType const & desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    RawBits expectedBits = ToBits(expected);
+    bool const exchanged = mBits.compare_exchange_strong(expectedBits, ToBits(desired), order);
+    if (!exchanged) {
+      expected = FromBits(expectedBits);
+    }
+    return exchanged;
+  }
+
+  bool compare_exchange_weak(
+      OptionalType & expected,
+      OptionalType const & desired,
+      std::memory_order success,
+      std::memory_order failure) noexcept
+  {
+    RawBits expectedBits = ToBits(expected);
+    bool const exchanged = mBits.compare_exchange_weak(expectedBits, ToBits(desired), success, failure);
+    if (!exchanged) {
+      expected = FromBits(expectedBits);
+    }
+    return exchanged;
+  }
+
+  bool compare_exchange_weak(
+      OptionalType & expected,
+      OptionalType const & desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept
+  {
+    RawBits expectedBits = ToBits(expected);
+    bool const exchanged = mBits.compare_exchange_weak(expectedBits, ToBits(desired), order);
+    if (!exchanged) {
+      expected = FromBits(expectedBits);
+    }
+    return exchanged;
+  }
+
+#ifdef TINY_OPTIONAL_CPP20
+  // Blocks until the content is no longer equal to 'old' (compared bitwise), as std::atomic::wait.
+  void wait(OptionalType const & old, std::memory_order order = std::memory_order_seq_cst) const noexcept
+  {
+    mBits.wait(ToBits(old), order);
+  }
+
+  // Blocks until the optional contains a value and returns it. This is the typical use case of publishing a result
+  // computed by another thread: The producer calls store() or try_emplace() followed by notify_all().
+  [[nodiscard]] payload_type wait_for_value(std::memory_order order = std::memory_order_seq_cst) const noexcept
+  {
+    RawBits bits = mBits.load(order);
+    while (Operations::IsEmpty(bits)) {
+      mBits.wait(bits, order);
+      bits = mBits.load(order);
+    }
+    return *FromBits(bits);
+  }
+
+  void notify_one() noexcept
+  {
+    mBits.notify_one();
+  }
+
+  void notify_all() noexcept
+  {
+    mBits.notify_all();
+  }
+#endif
+
+private:
+  [[nodiscard]] static RawBits ToBits(OptionalType const & opt) noexcept
+  {
+    return opt.has_value() ? impl::LoadRawBits<RawBits>(*opt) : Operations::GetSentinelBits();
+  }
+
+  [[nodiscard]] static OptionalType FromBits(RawBits bits) noexcept
+  {
+    if (Operations::IsEmpty(bits)) {
+      return OptionalType{};
+    }
+    payload_type value;
+    impl::StoreRawBits(value, bits);
+    return OptionalType(value);
+  }
+
+  std::atomic<RawBits> mBits;
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
@@ -0,0 +1,352 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "optional.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+namespace impl
+{
+  // Reads and writes the object representation of some object as unsigned integer. Used to move payloads and sentinels
+  // in and out of the optionals in a way that compilers can vectorize. As elsewhere in the library, this is type
+  // punning: With TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS the tiny optionals are not trivially copyable, so
+  // formally the std::memcpy is not covered by the standard for them. It is for the payloads.
+  template <class RawBits, class T>
+  [[nodiscard]] RawBits LoadRawBits(T const & object) noexcept
+  {
+    static_assert(sizeof(RawBits) == sizeof(T));
+    RawBits bits;
+    std::memcpy(&bits, static_cast<void const *>(std::addressof(object)), sizeof(RawBits));
+    return bits;
+  }
+
+  template <class RawBits, class T>
+  void StoreRawBits(T & object, RawBits bits) noexcept
+  {
+    static_assert(sizeof(RawBits) == sizeof(T));
+    std::memcpy(static_cast<void *>(std::addressof(object)), &bits, sizeof(RawBits));
+  }
+
+
+  // Operations on the raw bits of tiny optionals whose empty state is a compile-time sentinel occupying the whole
+  // (scalar) payload. For them, a conversion boils down to comparisons and selects of integers, which the compiler
+  // can turn into SIMD instructions.
+  template <class PayloadType, class SentinelInfo>
+  struct SentinelRawBitsOperations
+  {
+    using RawBits = typename UnsignedIntegerOfSize<sizeof(PayloadType)>::type;
+
+    // Floating point sentinels specified by the user (AssignmentFlagManipulator) are compared via operator==, so e.g.
+    // a sentinel of 0.0 also matches -0.0. Everything else can be compared bitwise.
+    static constexpr bool compareAsValue = !SentinelInfo::comparesRawBits && std::is_floating_point_v<PayloadType>;
+
+    [[nodiscard]] static RawBits GetSentinelBits() noexcept
+    {
+      if constexpr (SentinelInfo::comparesRawBits) {
+        // MemcpyAndCmpFlagManipulator compares the bytes of the integer SentinelValue::value.
+        return static_cast<RawBits>(SentinelInfo::SentinelValue::value);
+      }
+      else {
+        // AssignmentFlagManipulator stores the sentinel converted to the payload type. The conversion was already
+        // checked by the AssignmentFlagManipulator.
+        PayloadType const sentinel = static_cast<PayloadType>(SentinelInfo::SentinelValue::value);
+        return LoadRawBits<RawBits>(sentinel);
+      }
+    }
+
+    [[nodiscard]] static bool IsEmpty(RawBits bits) noexcept
+    {
+      if constexpr (compareAsValue) {
+        PayloadType value;
+        StoreRawBits(value, bits);
+        return value == static_cast<PayloadType>(SentinelInfo::SentinelValue::value);
+      }
+      else {
+        return bits == GetSentinelBits();
+      }
+    }
+  };
+
+
+  template <class SentinelInfo, class PayloadType>
+  constexpr bool IsRawBitsSentinelOfSameSize() noexcept
+  {
+    using SentinelType = std::remove_cv_t<decltype(SentinelInfo::SentinelValue::value)>;
+    return std::is_integral_v<SentinelType> && sizeof(SentinelType) == sizeof(PayloadType);
+  }
+
+
+  // Decides whether the conversions for the given optional type can use SentinelRawBitsOperations. That is the case
+  // for the types with known SentinelForExploitingUnusedBits (float, double, bool, pointers) and for scalar payloads
+  // with a sentinel given by the user (i.e. AssignmentFlagManipulator). Other optionals (separate bool, custom flag
+  // manipulators, sentinels in members, class types) use a generic element-wise loop.
+  template <class OptionalType, bool = is_tiny_optional_v<OptionalType>>
+  struct BulkConversionTraits
+  {
+    static constexpr bool isVectorizable = false;
+  };
+
+  template <class OptionalType>
+  struct BulkConversionTraits<OptionalType, true>
+  {
+    using PayloadType = typename OptionalType::value_type;
+    using LayoutTraits = SentinelLayoutTraits<OptionalType>;
+    using SentinelInfo = typename LayoutTraits::SentinelInfo;
+
+    static constexpr bool isVectorizable = [] {
+      if constexpr (
+          LayoutTraits::isWholePayloadTheFlag && std::is_scalar_v<PayloadType> && !std::is_const_v<PayloadType>
+          && !std::is_volatile_v<PayloadType> && !std::is_same_v<PayloadType, long double>
+          && !std::is_member_pointer_v<PayloadType> && sizeof(OptionalType) == sizeof(PayloadType)
+          && (sizeof(PayloadType) == 1 || sizeof(PayloadType) == 2 || sizeof(PayloadType) == 4
+              || sizeof(PayloadType) == 8)) {
+        if constexpr (SentinelInfo::comparesRawBits) {
+          return IsRawBitsSentinelOfSameSize<SentinelInfo, PayloadType>();
+        }
+        else {
+          return true;
+        }
+      }
+      else {
+        return false;
+      }
+    }();
+  };
+
+
+  template <class OptionalType>
+  using SentinelRawBitsOperationsFor = SentinelRawBitsOperations<
+      typename BulkConversionTraits<OptionalType>::PayloadType,
+      typename BulkConversionTraits<OptionalType>::SentinelInfo>;
+
+
+  template <class OptionalType>
+  inline constexpr bool IsSupportedBulkOptional
+      = is_tiny_optional_v<OptionalType> || IsStdOptional<std::remove_cv_t<OptionalType>>;
+
+
+  // Writes the validity bits and values of the optionals [begin, begin + numBits) into one byte of the bitmap.
+  // Called with a compile-time constant 'numBits' for all but the last byte, so that the inner loop can be unrolled.
+  template <class OptionalType, class ValueType>
+  [[nodiscard]] std::uint8_t OptionalsToBitmapByte(
+      OptionalType const * source,
+      std::size_t begin,
+      unsigned numBits,
+      ValueType * values) noexcept
+  {
+    std::uint8_t mask = 0;
+    if constexpr (BulkConversionTraits<OptionalType>::isVectorizable) {
+      using Ops = SentinelRawBitsOperationsFor<OptionalType>;
+      using RawBits = typename Ops::RawBits;
+      for (unsigned bit = 0; bit < numBits; ++bit) {
+        RawBits const bits = LoadRawBits<RawBits>(source[begin + bit]);
+        bool const isValid = !Ops::IsEmpty(bits);
+        mask = static_cast<std::uint8_t>(mask | (static_cast<unsigned>(isValid) << bit));
+        StoreRawBits(values[begin + bit], isValid ? bits : RawBits{0});
+      }
+    }
+    else {
+      for (unsigned bit = 0; bit < numBits; ++bit) {
+        OptionalType const & opt = source[begin + bit];
+        bool const isValid = opt.has_value();
+        mask = static_cast<std::uint8_t>(mask | (static_cast<unsigned>(isValid) << bit));
+        values[begin + bit] = isValid ? *opt : ValueType{};
+      }
+    }
+    return mask;
+  }
+
+
+  template <class OptionalType, class ValueType>
+  void BitmapByteToOptionals(
+      ValueType const * values,
+      std::uint8_t mask,
+      std::size_t begin,
+      unsigned numBits,
+      OptionalType * destination)
+  {
+    if constexpr (BulkConversionTraits<OptionalType>::isVectorizable) {
+      using Ops = SentinelRawBitsOperationsFor<OptionalType>;
+      using RawBits = typename Ops::RawBits;
+      RawBits const sentinelBits = Ops::GetSentinelBits();
+      for (unsigned bit = 0; bit < numBits; ++bit) {
+        bool const isValid = ((mask >> bit) & 1u) != 0;
+        RawBits const bits = LoadRawBits<RawBits>(values[begin + bit]);
+        // Same precondition as when assigning a value to the optional: The value must not be the sentinel.
+        assert(!isValid || !Ops::IsEmpty(bits));
+        StoreRawBits(destination[begin + bit], isValid ? bits : sentinelBits);
+      }
+    }
+    else {
+      for (unsigned bit = 0; bit < numBits; ++bit) {
+        if ((mask >> bit) & 1u) {
+          destination[begin + bit] = values[begin + bit];
+        }
+        else {
+          destination[begin + bit] = std::nullopt;
+        }
+      }
+    }
+  }
+} // namespace impl
+
+
+// Converts 'count' optionals from 'source' into the 'count' existing optionals at 'destination' (which must not
+// overlap with the source). Both can be any tiny optional or std::optional with the same value_type. The main use case
+// is converting between std::optional (e.g. in some external API) and tiny::optional. If the tiny optional stores its
+// empty state as sentinel in the payload (i.e. for floats, doubles, bools and pointers, and for optionals with
+// user specified sentinels such as tiny::optional<int, -1>), the loops work on the raw bits and are vectorizable.
+// Values in the source that are equal to the sentinel of a target tiny optional are not allowed (as usual).
+template <class SourceOptional, class DestinationOptional>
+void convert_optionals(SourceOptional const * source, std::size_t count, DestinationOptional * destination)
+{
+  static_assert(
+      impl::IsSupportedBulkOptional<SourceOptional> && impl::IsSupportedBulkOptional<DestinationOptional>,
+      "convert_optionals: Source and destination must be tiny optionals or std::optionals.");
+  static_assert(
+      std::is_same_v<
+          std::remove_cv_t<typename SourceOptional::value_type>,
+          std::remove_cv_t<typename DestinationOptional::value_type>>,
+      "convert_optionals: Source and destination optionals must have the same value_type.");
+
+  constexpr bool isSourceVectorizable = impl::BulkConversionTraits<SourceOptional>::isVectorizable;
+  constexpr bool isDestinationVectorizable = impl::BulkConversionTraits<DestinationOptional>::isVectorizable;
+
+  if constexpr (isSourceVectorizable && isDestinationVectorizable) {
+    using SourceOps = impl::SentinelRawBitsOperationsFor<SourceOptional>;
+    using DestinationOps = impl::SentinelRawBitsOperationsFor<DestinationOptional>;
+    using RawBits = typename SourceOps::RawBits;
+    RawBits const destinationSentinel = DestinationOps::GetSentinelBits();
+    for (std::size_t i = 0; i < count; ++i) {
+      RawBits const bits = impl::LoadRawBits<RawBits>(source[i]);
+      bool const isEmpty = SourceOps::IsEmpty(bits);
+      assert(isEmpty || !DestinationOps::IsEmpty(bits));
+      impl::StoreRawBits(destination[i], isEmpty ? destinationSentinel : bits);
+    }
+  }
+  else if constexpr (isDestinationVectorizable) {
+    // Typically std::optional -> tiny optional.
+    using DestinationOps = impl::SentinelRawBitsOperationsFor<DestinationOptional>;
+    using RawBits = typename DestinationOps::RawBits;
+    RawBits const destinationSentinel = DestinationOps::GetSentinelBits();
+    for (std::size_t i = 0; i < count; ++i) {
+      RawBits const bits = source[i].has_value() ? impl::LoadRawBits<RawBits>(*source[i]) : destinationSentinel;
+      assert(!source[i].has_value() || !DestinationOps::IsEmpty(bits));
+      impl::StoreRawBits(destination[i], bits);
+    }
+  }
+  else if constexpr (isSourceVectorizable) {
+    // Typically tiny optional -> std::optional.
+    using SourceOps = impl::SentinelRawBitsOperationsFor<SourceOptional>;
+    using RawBits = typename SourceOps::RawBits;
+    using ValueType = std::remove_cv_t<typename SourceOptional::value_type>;
+    for (std::size_t i = 0; i < count; ++i) {
+      RawBits const bits = impl::LoadRawBits<RawBits>(source[i]);
+      ValueType value;
+      impl::StoreRawBits(value, bits);
+      destination[i] = SourceOps::IsEmpty(bits) ? DestinationOptional{} : DestinationOptional{value};
+    }
+  }
+  else {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (source[i].has_value()) {
+        destination[i] = *source[i];
+      }
+      else {
+        destination[i] = std::nullopt;
+      }
+    }
+  }
+}
+
+
+// Converts 'count' optionals (tiny optionals or std::optionals) into the layout used e.g. by Apache Arrow: An array of
+// 'count' values and a validity bitmap with 1 bit per value. Bit i%8 (counting from the least significant bit) of
+// byte i/8 is set if and only if source[i] has a value. The bitmap must have room for (count + 7) / 8 bytes; unused
+// bits of the last byte are set to 0. The value of an empty optional is written as value-initialized value (e.g. 0).
+template <class OptionalType>
+void optionals_to_bitmap(
+    OptionalType const * source,
+    std::size_t count,
+    std::remove_cv_t<typename OptionalType::value_type> * values,
+    std::uint8_t * validityBitmap)
+{
+  static_assert(
+      impl::IsSupportedBulkOptional<OptionalType>,
+      "optionals_to_bitmap: The source must be tiny optionals or std::optionals.");
+
+  std::size_t const numFullBytes = count / 8;
+  for (std::size_t byteIdx = 0; byteIdx < numFullBytes; ++byteIdx) {
+    validityBitmap[byteIdx] = impl::OptionalsToBitmapByte(source, byteIdx * 8, 8, values);
+  }
+  if (unsigned const numRemaining = static_cast<unsigned>(count % 8); numRemaining != 0) {
+    validityBitmap[numFullBytes] = impl::OptionalsToBitmapByte(source, numFullBytes * 8, numRemaining, values);
+  }
+}
+
+
+// The inverse of optionals_to_bitmap(): Assigns the 'count' existing optionals at 'destination' from an array of
+// values and a validity bitmap (see optionals_to_bitmap() for its format). Values whose bit is not set are ignored.
+// Values whose bit is set must not be equal to the sentinel of a destination tiny optional.
+template <class OptionalType>
+void optionals_from_bitmap(
+    typename OptionalType::value_type const * values,
+    std::uint8_t const * validityBitmap,
+    std::size_t count,
+    OptionalType * destination)
+{
+  static_assert(
+      impl::IsSupportedBulkOptional<OptionalType>,
+      "optionals_from_bitmap: The destination must be tiny optionals or std::optionals.");
+
+  std::size_t const numFullBytes = count / 8;
+  for (std::size_t byteIdx = 0; byteIdx < numFullBytes; ++byteIdx) {
+    impl::BitmapByteToOptionals(values, validityBitmap[byteIdx], byteIdx * 8, 8, destination);
+  }
+  if (unsigned const numRemaining = static_cast<unsigned>(count % 8); numRemaining != 0) {
+    impl::BitmapByteToOptionals(values, validityBitmap[numFullBytes], numFullBytes * 8, numRemaining, destination);
+  }
+}
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
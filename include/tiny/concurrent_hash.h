@@ -0,0 +1,395 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "atomic_optional.h"
+#include "optional.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception> // Required for std::exception_ptr
+#include <functional>
+#include <memory>
+#include <stdexcept> // Required for std::length_error
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+namespace impl
+{
+  // The open-addressing core of concurrent_hash_set and concurrent_hash_map: An array of buckets, each a
+  // tiny::atomic_optional holding a key. An empty bucket is marked by the sentinel of the key's optional type. Keys are
+  // only ever inserted, never removed, so a bucket changes its state at most once (from empty to some key). This
+  // makes lookups wait-free: They probe linearly until they find the key or an empty bucket.
+  template <class OptionalKey, class Hash>
+  class ConcurrentHashTable
+  {
+  public:
+    using KeyType = typename OptionalKey::value_type;
+    using SizeType = std::size_t;
+
+    static constexpr SizeType npos = static_cast<SizeType>(-1);
+
+    explicit ConcurrentHashTable(SizeType minCapacity)
+    {
+      SizeType capacity = 1;
+      while (capacity < minCapacity) {
+        capacity *= 2;
+      }
+      mBuckets = std::make_unique<atomic_optional<OptionalKey>[]>(capacity);
+      mMask = capacity - 1;
+      unsigned log2Capacity = 0;
+      while ((SizeType{1} << log2Capacity) < capacity) {
+        ++log2Capacity;
+      }
+      mShift = log2Capacity == 0 ? 63 : 64 - log2Capacity;
+    }
+
+    [[nodiscard]] SizeType GetCapacity() const noexcept
+    {
+      return mMask + 1;
+    }
+
+    // Returns the bucket index of the key, or npos if it is not contained.
+    [[nodiscard]] SizeType Find(KeyType const & key) const noexcept
+    {
+      SizeType index = GetHomeBucket(key);
+      for (SizeType numProbes = 0; numProbes <= mMask; ++numProbes) {
+        OptionalKey const bucketKey = mBuckets[index].load(std::memory_order_acquire);
+        if (!bucketKey.has_value()) {
+          return npos;
+        }
+        if (*bucketKey == key) {
+          return index;
+        }
+        index = (index + 1) & mMask;
+      }
+      return npos;
+    }
+
+    // Returns the bucket index of the key, inserting it via compare-and-swap if it is not yet contained. The bool is
+    // true if this call inserted the key. Throws std::length_error if the table is full.
+    std::pair<SizeType, bool> FindOrInsert(KeyType const & key)
+    {
+      OptionalKey const desired(key);
+      SizeType index = GetHomeBucket(key);
+      for (SizeType numProbes = 0; numProbes <= mMask; ++numProbes) {
+        OptionalKey bucketKey = mBuckets[index].load(std::memory_order_acquire);
+        if (!bucketKey.has_value()) {
+          if (mBuckets[index].compare_exchange_strong(
+                  bucketKey, desired, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return {index, true};
+          }
+          // Another thread claimed the bucket meanwhile. 'bucketKey' now contains its key.
+        }
+        if (*bucketKey == key) {
+          return {index, false};
+        }
+        index = (index + 1) & mMask;
+      }
+      throw std::length_error("Concurrent hash table is full.");
+    }
+
+    [[nodiscard]] OptionalKey GetKey(SizeType index) const noexcept
+    {
+      return mBuckets[index].load(std::memory_order_acquire);
+    }
+
+  private:
+    // Fibonacci hashing: std::hash of integers and pointers is often the identity, which would result in long probe
+    // sequences for regular keys. Multiplying with 2^64/phi and taking the upper bits spreads them.
+    [[nodiscard]] SizeType GetHomeBucket(KeyType const & key) const noexcept
+    {
+      std::uint64_t const hash = static_cast<std::uint64_t>(Hash{}(OptionalKey(key)));
+      return static_cast<SizeType>((hash * 0x9e3779b97f4a7c15ull) >> mShift) & mMask;
+    }
+
+    std::unique_ptr<atomic_optional<OptionalKey>[]> mBuckets;
+    SizeType mMask = 0;
+    unsigned mShift = 0;
+  };
+
+
+  // Calls func(begin, end) for disjoint ranges covering [0, count), distributed over 'numThreads' threads (including
+  // the calling one). If func throws, the exception is rethrown in the calling thread after all threads finished. If a
+  // thread cannot be started, the calling thread processes its chunk.
+  template <class Func>
+  void RunChunksInParallel(std::size_t count, unsigned numThreads, Func const & func)
+  {
+    if (numThreads <= 1 || count < 2 * std::size_t{numThreads}) {
+      func(std::size_t{0}, count);
+      return;
+    }
+    std::size_t const chunkSize = (count + numThreads - 1) / numThreads;
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    auto const runChunk = [&func, &exceptions](unsigned t, std::size_t begin, std::size_t end) noexcept {
+      try {
+        func(begin, end);
+      }
+      catch (...) {
+        exceptions[t] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (unsigned t = 1; t < numThreads; ++t) {
+      std::size_t const begin = t * chunkSize;
+      std::size_t const end = begin + chunkSize < count ? begin + chunkSize : count;
+      if (begin < end) {
+        try {
+          threads.emplace_back(runChunk, t, begin, end); // No reallocation thanks to reserve().
+        }
+        catch (...) {
+          // E.g. std::system_error if no more threads can be created. Propagating it would destroy the threads started
+          // so far while they are still joinable. So the calling thread processes the chunk itself.
+          runChunk(t, begin, end);
+        }
+      }
+    }
+    runChunk(0, 0, chunkSize);
+    for (std::thread & t : threads) {
+      t.join();
+    }
+
+    for (std::exception_ptr const & exception : exceptions) {
+      if (exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+  }
+} // namespace impl
+
+
+// A hash set that supports concurrent insertions and lookups from any number of threads without locks. Elements can
+// only be inserted, not erased. 'OptionalKey' is a tiny optional that stores the empty state as sentinel in the whole
+// scalar payload (same requirements as for tiny::atomic_optional), e.g. tiny::optional<std::uint64_t, ~0ull> or
+// tiny::optional<T*>. The sentinel marks the empty buckets and thus cannot be inserted as key.
+// The hash function is applied to the optional, so by default the std::hash specialization of tiny optionals is used.
+//
+// The capacity is fixed while the set is used concurrently. Since the lookups and insertions probe linearly, it should
+// be chosen so that the set is at most about half full. rehash() changes the capacity, using several threads, but it
+// must not run concurrently with any other member function.
+template <class OptionalKey, class Hash = std::hash<OptionalKey>>
+class concurrent_hash_set
+{
+private:
+  using Table = impl::ConcurrentHashTable<OptionalKey, Hash>;
+
+public:
+  using value_type = OptionalKey;
+  using key_type = typename OptionalKey::value_type;
+  using size_type = std::size_t;
+
+  // The capacity is rounded up to the next power of 2.
+  explicit concurrent_hash_set(size_type minCapacity)
+    : mTable(minCapacity)
+  {
+  }
+
+  concurrent_hash_set(concurrent_hash_set const &) = delete;
+  concurrent_hash_set & operator=(concurrent_hash_set const &) = delete;
+
+  [[nodiscard]] size_type capacity() const noexcept
+  {
+    return mTable.GetCapacity();
+  }
+
+  // Inserts the key if it is not yet contained, via a single compare-and-swap on an empty bucket. Returns true if this
+  // call inserted the key. Throws std::length_error if the set is full.
+  bool insert(key_type const & key)
+  {
+    return mTable.FindOrInsert(key).second;
+  }
+
+  // Wait-free.
+  [[nodiscard]] bool contains(key_type const & key) const noexcept
+  {
+    return mTable.Find(key) != Table::npos;
+  }
+
+  // Calls func(key) for all keys. If called concurrently with insert(), keys inserted meanwhile may or may not be
+  // visited.
+  template <class Func>
+  void for_each(Func && func) const
+  {
+    for (size_type i = 0; i < mTable.GetCapacity(); ++i) {
+      if (OptionalKey const key = mTable.GetKey(i)) {
+        func(*key);
+      }
+    }
+  }
+
+  // Counts the keys. O(capacity), since no shared counter is maintained (it would be a point of contention).
+  [[nodiscard]] size_type size() const noexcept
+  {
+    size_type result = 0;
+    for_each([&result](key_type const &) { ++result; });
+    return result;
+  }
+
+  // Moves all keys into a new table with at least 'minCapacity' buckets, distributing the work over 'numThreads'
+  // threads. Must not be called concurrently with any other member function. Throws std::length_error if the keys do
+  // not fit into the new table; the set is unchanged then.
+  void rehash(size_type minCapacity, unsigned numThreads = 1)
+  {
+    Table newTable(minCapacity);
+    impl::RunChunksInParallel(mTable.GetCapacity(), numThreads, [&](size_type begin, size_type end) {
+      for (size_type i = begin; i < end; ++i) {
+        if (OptionalKey const key = mTable.GetKey(i)) {
+          newTable.FindOrInsert(*key);
+        }
+      }
+    });
+    mTable = std::move(newTable);
+  }
+
+private:
+  Table mTable;
+};
+
+
+// A hash map that supports concurrent insertions and lookups from any number of threads without locks. Keys can only
+// be inserted, not erased. Both 'OptionalKey' and 'OptionalValue' must be tiny optionals fulfilling the requirements
+// of tiny::atomic_optional, e.g. tiny::optional<std::uint64_t, ~0ull> or tiny::optional<T*>. Neither keys nor values
+// can be the sentinel. Each bucket consists of the key and the value, without any additional flag.
+//
+// An insertion first claims the key's bucket and then stores the value. A find() for the key in between returns an
+// empty optional, i.e. the insertion becomes visible with the store of the value. insert() stores the value only if
+// the bucket is still empty, so it never overwrites the value of a concurrent insert_or_assign() for the same key.
+// Capacity and rehash(): See concurrent_hash_set.
+template <class OptionalKey, class OptionalValue, class Hash = std::hash<OptionalKey>>
+class concurrent_hash_map
+{
+private:
+  using Table = impl::ConcurrentHashTable<OptionalKey, Hash>;
+
+public:
+  using key_type = typename OptionalKey::value_type;
+  using mapped_type = typename OptionalValue::value_type;
+  using size_type = std::size_t;
+
+  // The capacity is rounded up to the next power of 2.
+  explicit concurrent_hash_map(size_type minCapacity)
+    : mTable(minCapacity)
+    , mValues(std::make_unique<atomic_optional<OptionalValue>[]>(mTable.GetCapacity()))
+  {
+  }
+
+  concurrent_hash_map(concurrent_hash_map const &) = delete;
+  concurrent_hash_map & operator=(concurrent_hash_map const &) = delete;
+
+  [[nodiscard]] size_type capacity() const noexcept
+  {
+    return mTable.GetCapacity();
+  }
+
+  // Inserts the key with the value if the key is not yet contained. Returns true if this call inserted the key.
+  // Throws std::length_error if the map is full.
+  bool insert(key_type const & key, mapped_type const & value)
+  {
+    auto const [index, inserted] = mTable.FindOrInsert(key);
+    if (inserted) {
+      // Does not overwrite a value stored meanwhile by a concurrent insert_or_assign() for the same key.
+      mValues[index].try_emplace(value, std::memory_order_release);
+    }
+    return inserted;
+  }
+
+  // Inserts the key if necessary, and (atomically) replaces its value.
+  void insert_or_assign(key_type const & key, mapped_type const & value)
+  {
+    mValues[mTable.FindOrInsert(key).first].store(value, std::memory_order_release);
+  }
+
+  // Wait-free. Returns an empty optional if the key is not contained (or its insertion is still in progress).
+  [[nodiscard]] OptionalValue find(key_type const & key) const noexcept
+  {
+    size_type const index = mTable.Find(key);
+    return index != Table::npos ? mValues[index].load(std::memory_order_acquire) : OptionalValue{};
+  }
+
+  [[nodiscard]] bool contains(key_type const & key) const noexcept
+  {
+    return find(key).has_value();
+  }
+
+  // Calls func(key, value) for all entries. If called concurrently with insertions, entries inserted meanwhile may or
+  // may not be visited.
+  template <class Func>
+  void for_each(Func && func) const
+  {
+    for (size_type i = 0; i < mTable.GetCapacity(); ++i) {
+      if (OptionalKey const key = mTable.GetKey(i)) {
+        if (OptionalValue const value = mValues[i].load(std::memory_order_acquire)) {
+          func(*key, *value);
+        }
+      }
+    }
+  }
+
+  // Counts the entries. O(capacity), see concurrent_hash_set::size().
+  [[nodiscard]] size_type size() const noexcept
+  {
+    size_type result = 0;
+    for_each([&result](key_type const &, mapped_type const &) { ++result; });
+    return result;
+  }
+
+  // See concurrent_hash_set::rehash().
+  void rehash(size_type minCapacity, unsigned numThreads = 1)
+  {
+    Table newTable(minCapacity);
+    auto newValues = std::make_unique<atomic_optional<OptionalValue>[]>(newTable.GetCapacity());
+    impl::RunChunksInParallel(mTable.GetCapacity(), numThreads, [&](size_type begin, size_type end) {
+      for (size_type i = begin; i < end; ++i) {
+        if (OptionalKey const key = mTable.GetKey(i)) {
+          size_type const newIndex = newTable.FindOrInsert(*key).first;
+          newValues[newIndex].store(mValues[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+      }
+    });
+    mTable = std::move(newTable);
+    mValues = std::move(newValues);
+  }
+
+private:
+  Table mTable;
+  std::unique_ptr<atomic_optional<OptionalValue>[]> mValues;
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
@@ -0,0 +1,144 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+
+#include "bulk_conversions.h"
+#include "optional.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+namespace impl
+{
+  // The finalizer of splitmix64 ("Mix13" by David Stafford). Every input bit affects every output bit, so that also
+  // consecutive integers or pointers (for which std::hash is the identity in libstdc++ and libc++) are distributed well
+  // over the buckets of hash tables.
+  [[nodiscard]] constexpr std::uint64_t MixHashBits(std::uint64_t x) noexcept
+  {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+  }
+
+
+  // Hashed (i.e. mixed) for empty optionals that do not store a sentinel in the payload.
+  inline constexpr std::uint64_t cEmptyOptionalHashSeed = 0x9e3779b97f4a7c15ull;
+
+
+  // Returns the raw bits of a non-empty or empty optional, such that optionals comparing equal get the same bits.
+  // Floating point payloads compare -0.0 and +0.0 equal, so -0.0 is mapped to +0.0. NaNs never compare equal, so their
+  // bits can be left alone.
+  template <class OptionalType>
+  [[nodiscard]] std::uint64_t LoadCanonicalRawBits(OptionalType const & o) noexcept
+  {
+    using Ops = SentinelRawBitsOperationsFor<OptionalType>;
+    using RawBits = typename Ops::RawBits;
+    RawBits const bits = LoadRawBits<RawBits>(o);
+    if constexpr (std::is_floating_point_v<typename BulkConversionTraits<OptionalType>::PayloadType>) {
+      // Clears the sign bit if it is the only set bit. Written without a ternary operator since compilers tend to
+      // turn it into a branch.
+      constexpr unsigned signBitPos = 8 * sizeof(RawBits) - 1;
+      constexpr RawBits negativeZeroBits = static_cast<RawBits>(RawBits{1} << signBitPos);
+      return static_cast<RawBits>(bits ^ (static_cast<RawBits>(bits == negativeZeroBits) << signBitPos));
+    }
+    else {
+      return bits;
+    }
+  }
+
+
+  template <class OptionalType>
+  [[nodiscard]] std::uint64_t HashOptional(OptionalType const & o)
+  {
+    if constexpr (BulkConversionTraits<OptionalType>::isVectorizable) {
+      return MixHashBits(LoadCanonicalRawBits(o));
+    }
+    else {
+      using PayloadType = std::remove_cv_t<typename OptionalType::value_type>;
+      return MixHashBits(
+          o.has_value() ? static_cast<std::uint64_t>(std::hash<PayloadType>{}(*o)) : cEmptyOptionalHashSeed);
+    }
+  }
+} // namespace impl
+
+
+// Hash function object for tiny optionals and std::optional, as an alternative to std::hash. Can be used e.g. as
+// third template argument of std::unordered_map.
+// If the tiny optional stores the empty state as sentinel in the whole (scalar) payload (e.g. tiny::optional<double>,
+// tiny::optional<int *> or tiny::optional<int, -1>), the raw bits of the optional are hashed without a branch on
+// has_value(). The empty state then hashes to the mixed bits of the sentinel, i.e. a well-distributed constant.
+// Floating point values are hashed via their bits, except that -0.0 is hashed like +0.0 (since they compare equal).
+// For all other optionals, the result of std::hash for the payload is mixed. Either way, the result is distributed
+// well even for integers and pointers (in contrast to std::hash, which is the identity for them in some standard
+// libraries). The hash values are not the same as the ones of std::hash.
+template <class OptionalType>
+struct hash
+{
+  static_assert(
+      impl::IsSupportedBulkOptional<OptionalType>, "tiny::hash: The type must be a tiny optional or std::optional.");
+
+  [[nodiscard]] std::size_t operator()(OptionalType const & o) const
+      noexcept(impl::BulkConversionTraits<OptionalType>::isVectorizable)
+  {
+    return static_cast<std::size_t>(impl::HashOptional(o));
+  }
+};
+
+
+// Computes the hashes of 'count' optionals as tiny::hash would, and writes them to 'hashes'. Useful e.g. to partition
+// the rows of a table by hash. For the optionals that tiny::hash handles via the raw bits, the loop does not contain
+// any branches and can be vectorized by the compiler.
+template <class OptionalType>
+void hash_span(OptionalType const * source, std::size_t count, std::size_t * hashes)
+{
+  static_assert(
+      impl::IsSupportedBulkOptional<OptionalType>,
+      "hash_span: The source must be tiny optionals or std::optionals.");
+
+  for (std::size_t i = 0; i < count; ++i) {
+    hashes[i] = static_cast<std::size_t>(impl::HashOptional(source[i]));
+  }
+}
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
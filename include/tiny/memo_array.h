@@ -0,0 +1,290 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "bulk_conversions.h"
+#include "once_cell.h"
+#include "optional.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// Counters collected by a memo_array with 'CollectStatistics' set to true.
+struct memo_array_statistics
+{
+  std::uint64_t calls = 0; // Calls of get_or_compute() that returned a value.
+  std::uint64_t hits = 0; // Calls of get_or_compute() that found the value already computed.
+  std::uint64_t computations = 0; // Calls of the compute function that completed.
+  std::uint64_t collisions = 0; // Calls that raced with another thread computing the same element.
+
+  [[nodiscard]] double hit_rate() const noexcept
+  {
+    return calls == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(calls);
+  }
+};
+
+
+// A dense memoization table for f(i) with i in [0, size()), which can be filled concurrently from multiple threads
+// without locks. Typical use cases are dynamic programming and graph algorithms.
+// 'OptionalType' has the same requirements as for tiny::once_cell (e.g. tiny::optional<double> or
+// tiny::optional<int, -1>), and every element behaves like a once_cell: The 'not computed' state is the sentinel, so an
+// element is as large as the payload (8 bytes for double instead of 16 bytes for std::optional<double>).
+//
+// Concurrent calls of get_or_compute() for the same element either de-duplicate the computation via the second niche
+// described by 'BusyValue' (see tiny::once_cell), or compute the value in every racing thread and keep the first result
+// stored.
+// If 'CollectStatistics' is true, every call of get_or_compute() increments a counter shared by all threads. This is
+// meant for tuning and costs some scalability.
+template <class OptionalType, bool CollectStatistics = false, class BusyValue = void>
+class memo_array
+{
+  static_assert(
+      is_tiny_optional_v<OptionalType>,
+      "memo_array: The template argument must be a tiny optional, e.g. tiny::optional<double>.");
+  static_assert(
+      impl::BulkConversionTraits<OptionalType>::isVectorizable,
+      "memo_array: The tiny optional must store the empty state as sentinel in the whole payload, and the payload "
+      "must be a scalar of size 1, 2, 4 or 8 bytes (e.g. tiny::optional<double> or tiny::optional<int, -1>).");
+
+private:
+  using Operations = impl::SentinelRawBitsOperationsFor<OptionalType>;
+  using RawBits = typename Operations::RawBits;
+  using BusyState = impl::OnceCellBusyState<OptionalType, BusyValue>;
+
+public:
+  using value_type = OptionalType;
+  using payload_type = typename OptionalType::value_type;
+  using size_type = std::size_t;
+
+  // True if concurrent computations of the same element are de-duplicated.
+  static constexpr bool has_busy_state = BusyState::hasBusyState;
+  static constexpr bool collects_statistics = CollectStatistics;
+
+  memo_array()
+    : memo_array(0)
+  {
+  }
+
+  // Creates 'size' elements that are not yet computed.
+  explicit memo_array(size_type size)
+    : mBits(new std::atomic<RawBits>[size]) // Value-initialized (i.e. zeroed) only since C++20.
+    , mSize(size)
+  {
+#ifdef __cpp_lib_atomic_value_initialization
+    if (Operations::GetSentinelBits() != 0) {
+      clear();
+    }
+#else
+    clear();
+#endif
+    if constexpr (CollectStatistics) {
+      mCounters = std::make_unique<Counters>();
+    }
+  }
+
+  memo_array(memo_array const &) = delete;
+  memo_array & operator=(memo_array const &) = delete;
+
+  // The moved-from array is empty.
+  memo_array(memo_array && rhs) noexcept
+    : mBits(std::move(rhs.mBits))
+    , mSize(rhs.mSize)
+    , mCounters(std::move(rhs.mCounters))
+  {
+    rhs.mSize = 0;
+  }
+
+  memo_array & operator=(memo_array && rhs) noexcept
+  {
+    if (this != &rhs) {
+      mBits = std::move(rhs.mBits);
+      mSize = rhs.mSize;
+      mCounters = std::move(rhs.mCounters);
+      rhs.mSize = 0;
+    }
+    return *this;
+  }
+
+  [[nodiscard]] size_type size() const noexcept
+  {
+    return mSize;
+  }
+
+  // Returns the value of element 'index'. If it is not yet computed, calls compute(index) (which must return something
+  // convertible to payload_type) to compute it first. If 'compute' throws, the element remains not computed and the
+  // exception propagates.
+  template <class Compute>
+  [[nodiscard]] payload_type get_or_compute(size_type index, Compute && compute)
+  {
+    assert(index < mSize);
+    std::atomic<RawBits> & element = mBits[index];
+    RawBits const bits = element.load(std::memory_order_acquire);
+    if (!BusyState::IsSentinelOrBusy(bits)) {
+      if constexpr (CollectStatistics) {
+        mCounters->hits.fetch_add(1, std::memory_order_relaxed);
+      }
+      return ToPayload(bits);
+    }
+
+    impl::OnceInitOutcome outcome;
+    RawBits const finalBits = impl::InitializeOnceSlow<BusyState>(
+        element, [&compute, index]() { return std::forward<Compute>(compute)(index); }, outcome);
+    if constexpr (CollectStatistics) {
+      // Exactly one counter per call, so that statistics() can combine them without counting a call twice.
+      if (outcome == impl::OnceInitOutcome::Computed) {
+        mCounters->computed.fetch_add(1, std::memory_order_relaxed);
+      }
+      else if (outcome == impl::OnceInitOutcome::Waited) {
+        mCounters->waited.fetch_add(1, std::memory_order_relaxed);
+      }
+      else {
+        mCounters->discarded.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    return ToPayload(finalBits);
+  }
+
+  // Returns the value of element 'index' if it was computed, and an empty optional otherwise. Never blocks.
+  [[nodiscard]] OptionalType get(size_type index) const noexcept
+  {
+    assert(index < mSize);
+    RawBits const bits = mBits[index].load(std::memory_order_acquire);
+    return BusyState::IsSentinelOrBusy(bits) ? OptionalType{} : OptionalType(ToPayload(bits));
+  }
+
+  [[nodiscard]] bool is_computed(size_type index) const noexcept
+  {
+    assert(index < mSize);
+    return !BusyState::IsSentinelOrBusy(mBits[index].load(std::memory_order_acquire));
+  }
+
+  // Stores 'value' for element 'index' if it is neither computed nor being computed. Returns true if 'value' was
+  // stored.
+  bool set(size_type index, payload_type const & value) noexcept
+  {
+    assert(index < mSize);
+    RawBits const bits = impl::LoadRawBits<RawBits>(value);
+    assert(
+        !BusyState::IsSentinelOrBusy(bits) && "memo_array: The value must be neither the sentinel nor the BusyValue.");
+    RawBits expected = Operations::GetSentinelBits();
+    bool const stored = mBits[index].compare_exchange_strong(expected, bits, std::memory_order_acq_rel);
+    if constexpr (has_busy_state) {
+      if (stored) {
+        impl::NotifyOnceInitWaiters(mBits[index]);
+      }
+    }
+    return stored;
+  }
+
+  // Marks all elements as not computed. Must not run concurrently with other member functions.
+  void clear() noexcept
+  {
+    RawBits const sentinelBits = Operations::GetSentinelBits();
+    for (size_type i = 0; i < mSize; ++i) {
+      mBits[i].store(sentinelBits, std::memory_order_relaxed);
+    }
+  }
+
+  // Number of computed elements. O(size()).
+  [[nodiscard]] size_type count_computed() const noexcept
+  {
+    size_type count = 0;
+    for (size_type i = 0; i < mSize; ++i) {
+      count += BusyState::IsSentinelOrBusy(mBits[i].load(std::memory_order_relaxed)) ? 0 : 1;
+    }
+    return count;
+  }
+
+  // All counters are zero for a moved-from array.
+  [[nodiscard]] memo_array_statistics statistics() const noexcept
+  {
+    static_assert(CollectStatistics, "memo_array: Statistics are only collected if 'CollectStatistics' is true.");
+    memo_array_statistics result;
+    if (mCounters) {
+      std::uint64_t const hits = mCounters->hits.load(std::memory_order_relaxed);
+      std::uint64_t const computed = mCounters->computed.load(std::memory_order_relaxed);
+      std::uint64_t const discarded = mCounters->discarded.load(std::memory_order_relaxed);
+      std::uint64_t const waited = mCounters->waited.load(std::memory_order_relaxed);
+      result.calls = hits + computed + discarded + waited;
+      result.hits = hits;
+      result.computations = computed + discarded;
+      result.collisions = discarded + waited;
+    }
+    return result;
+  }
+
+  void reset_statistics() noexcept
+  {
+    static_assert(CollectStatistics, "memo_array: Statistics are only collected if 'CollectStatistics' is true.");
+    if (mCounters) {
+      mCounters->hits.store(0, std::memory_order_relaxed);
+      mCounters->computed.store(0, std::memory_order_relaxed);
+      mCounters->discarded.store(0, std::memory_order_relaxed);
+      mCounters->waited.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  [[nodiscard]] static payload_type ToPayload(RawBits bits) noexcept
+  {
+    payload_type value;
+    impl::StoreRawBits(value, bits);
+    return value;
+  }
+
+  struct Counters
+  {
+    // Outcomes of get_or_compute(), see impl::OnceInitOutcome for the last three.
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> computed{0};
+    std::atomic<std::uint64_t> discarded{0};
+    std::atomic<std::uint64_t> waited{0};
+  };
+
+  std::unique_ptr<std::atomic<RawBits>[]> mBits;
+  size_type mSize = 0;
+  // Heap allocated so that the memo_array remains movable. Null if 'CollectStatistics' is false, and in a moved-from
+  // array.
+  std::unique_ptr<Counters> mCounters;
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
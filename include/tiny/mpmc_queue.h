@@ -0,0 +1,195 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "atomic_optional.h"
+#include "optional.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// A bounded multi-producer/multi-consumer queue for payloads such as pointers or handles. The well-known design by
+// Dmitry Vyukov stores a sequence counter next to every value, so that a slot of e.g. 8 byte pointers is 16 bytes
+// large. Here, every slot is merely a tiny::atomic_optional: The sentinel marks a free slot. The same requirements as
+// for tiny::atomic_optional apply to 'OptionalType', e.g. tiny::optional<T*> or tiny::optional<std::uint64_t, ~0ull>.
+// Values must not equal the sentinel (checked via assert()).
+//
+// Producers and consumers draw tickets from an enqueue and a dequeue index. The ticket determines the slot. Without
+// the sequence counter, a slot does not know to which round of the ring buffer its value belongs. Instead, values are
+// written into and taken from the slots via compare-and-swap: A producer waits until its slot is free, a consumer until
+// its slot is occupied. Thus, every value is delivered exactly once. The order is FIFO, except when the queue wraps
+// around while an earlier producer of the same slot has not finished yet: Then the two values of that slot can be
+// delivered in swapped order.
+//
+// try_push() and try_pop() fail immediately if the queue is full or empty, respectively. They only ever wait (briefly)
+// for other push and pop operations that are already in progress. push() and pop() block until they succeed, via
+// std::atomic::wait in C++20 and by spinning and yielding before.
+template <class OptionalType>
+class mpmc_queue
+{
+private:
+  using Slot = atomic_optional<OptionalType>;
+
+  // Typical size of a cache line, see spsc_ring.
+  static constexpr std::size_t cCacheLineSize = 64;
+
+public:
+  using value_type = OptionalType;
+  using payload_type = typename OptionalType::value_type;
+  using size_type = std::size_t;
+
+  // The capacity is rounded up to the next power of 2.
+  explicit mpmc_queue(size_type minCapacity)
+  {
+    size_type capacity = 1;
+    while (capacity < minCapacity) {
+      capacity *= 2;
+    }
+    mSlots = std::make_unique<Slot[]>(capacity);
+    mMask = capacity - 1;
+  }
+
+  mpmc_queue(mpmc_queue const &) = delete;
+  mpmc_queue & operator=(mpmc_queue const &) = delete;
+
+  [[nodiscard]] size_type capacity() const noexcept
+  {
+    return mMask + 1;
+  }
+
+  // Appends 'value' and returns true, or returns false if the queue is full.
+  bool try_push(payload_type const & value) noexcept
+  {
+    size_type ticket = mEnqueueIndex.load(std::memory_order_relaxed);
+    do {
+      // Signed difference, since blocking pop() calls can draw tickets before the corresponding values are pushed.
+      if (static_cast<std::ptrdiff_t>(ticket - mDequeueIndex.load(std::memory_order_acquire))
+          >= static_cast<std::ptrdiff_t>(capacity())) {
+        return false;
+      }
+    } while (!mEnqueueIndex.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed));
+
+    Put(mSlots[ticket & mMask], value);
+    return true;
+  }
+
+  // Removes and returns the oldest value, or returns an empty optional if the queue is empty.
+  [[nodiscard]] OptionalType try_pop() noexcept
+  {
+    size_type ticket = mDequeueIndex.load(std::memory_order_relaxed);
+    do {
+      if (static_cast<std::ptrdiff_t>(mEnqueueIndex.load(std::memory_order_acquire) - ticket) <= 0) {
+        return OptionalType{};
+      }
+    } while (!mDequeueIndex.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed));
+
+    return Take(mSlots[ticket & mMask]);
+  }
+
+  // Appends 'value', waiting for a free slot if the queue is full.
+  void push(payload_type const & value) noexcept
+  {
+    size_type const ticket = mEnqueueIndex.fetch_add(1, std::memory_order_relaxed);
+    Put(mSlots[ticket & mMask], value);
+  }
+
+  // Removes and returns the oldest value, waiting for a value if the queue is empty.
+  [[nodiscard]] payload_type pop() noexcept
+  {
+    size_type const ticket = mDequeueIndex.fetch_add(1, std::memory_order_relaxed);
+    return *Take(mSlots[ticket & mMask]);
+  }
+
+private:
+  static void Put(Slot & slot, payload_type const & value) noexcept
+  {
+    OptionalType const desired(value);
+    OptionalType expected;
+    while (!slot.compare_exchange_weak(expected, desired, std::memory_order_release, std::memory_order_relaxed)) {
+      // The slot still contains the value of the previous round (or the compare-exchange failed spuriously).
+      if (expected.has_value()) {
+        Wait(slot, expected);
+      }
+      expected.reset();
+    }
+    Notify(slot);
+  }
+
+  static OptionalType Take(Slot & slot) noexcept
+  {
+    OptionalType current = slot.load(std::memory_order_acquire);
+    for (;;) {
+      if (!current.has_value()) {
+        // The producer of this slot has not yet stored its value.
+        Wait(slot, current);
+        current = slot.load(std::memory_order_acquire);
+      }
+      else if (slot.compare_exchange_weak(
+                   current, OptionalType{}, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        Notify(slot);
+        return current;
+      }
+    }
+  }
+
+  static void Wait([[maybe_unused]] Slot const & slot, [[maybe_unused]] OptionalType const & old) noexcept
+  {
+#ifdef TINY_OPTIONAL_CPP20
+    slot.wait(old, std::memory_order_acquire);
+#else
+    std::this_thread::yield();
+#endif
+  }
+
+  static void Notify([[maybe_unused]] Slot & slot) noexcept
+  {
+#ifdef TINY_OPTIONAL_CPP20
+    slot.notify_all();
+#endif
+  }
+
+  std::unique_ptr<Slot[]> mSlots;
+  size_type mMask = 0;
+
+  alignas(cCacheLineSize) std::atomic<size_type> mEnqueueIndex{0};
+  alignas(cCacheLineSize) std::atomic<size_type> mDequeueIndex{0};
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
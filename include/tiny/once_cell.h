@@ -0,0 +1,359 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "bulk_conversions.h"
+#include "optional.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+namespace impl
+{
+  // Describes the optional 'initializing' state of a once_cell: A second niche besides the sentinel that is also never
+  // a valid payload. By default, it is available only if the sentinel was chosen by the library
+  // (SentinelForExploitingUnusedBits): Flipping the lowest bit of such a sentinel results in another unused bit
+  // pattern (another unusual NaN for floating point types, another non-canonical address for pointers, another invalid
+  // value for bool). For sentinels specified by the user, the library cannot know any other invalid value. A BusyValue
+  // specified by the user must differ from the sentinel in exactly one bit. Then both states are detected with a single
+  // masked comparison.
+  template <class OptionalType, class BusyValue>
+  struct OnceCellBusyState
+  {
+    using Operations = SentinelRawBitsOperationsFor<OptionalType>;
+    using RawBits = typename Operations::RawBits;
+    using PayloadType = typename OptionalType::value_type;
+
+    static constexpr bool hasBusyState = true;
+    static constexpr bool differsFromSentinelOnlyInLowestBit = false;
+
+    [[nodiscard]] static RawBits GetBits() noexcept
+    {
+      PayloadType const busy = static_cast<PayloadType>(BusyValue::value);
+      return LoadRawBits<RawBits>(busy);
+    }
+
+    [[nodiscard]] static bool IsSentinelOrBusy(RawBits bits) noexcept
+    {
+      // Sentinel and busy state in one comparison. Both are compile-time constants, so the compiler folds the masks.
+      RawBits const differingBit = static_cast<RawBits>(Operations::GetSentinelBits() ^ GetBits());
+      assert(
+          differingBit != 0 && (differingBit & (differingBit - 1)) == 0
+          && "once_cell: The BusyValue must differ from the sentinel in exactly one bit.");
+      RawBits const sentinelBitsWithDifferingBit = static_cast<RawBits>(Operations::GetSentinelBits() | differingBit);
+      return static_cast<RawBits>(bits | differingBit) == sentinelBitsWithDifferingBit;
+    }
+
+  private:
+    // For integer payloads, the bits are known at compile time. For other payloads, IsSentinelOrBusy() asserts.
+    static constexpr bool DiffersFromSentinelInOneBitOrUnknown() noexcept
+    {
+      if constexpr (std::is_integral_v<PayloadType>) {
+        // Same bits as Operations::GetSentinelBits() and GetBits(), but computed without std::memcpy.
+        using SentinelInfo = typename SentinelLayoutTraits<OptionalType>::SentinelInfo;
+        auto const sentinel = SentinelInfo::SentinelValue::value;
+        RawBits const sentinelBits = SentinelInfo::comparesRawBits
+                                         ? static_cast<RawBits>(sentinel)
+                                         : static_cast<RawBits>(static_cast<PayloadType>(sentinel));
+        RawBits const busyBits = static_cast<RawBits>(static_cast<PayloadType>(BusyValue::value));
+        RawBits const differingBit = static_cast<RawBits>(sentinelBits ^ busyBits);
+        return differingBit != 0 && (differingBit & (differingBit - 1)) == 0;
+      }
+      else {
+        return true;
+      }
+    }
+
+    static_assert(
+        DiffersFromSentinelInOneBitOrUnknown(),
+        "once_cell: The BusyValue must differ from the sentinel in exactly one bit (e.g. -2 for the sentinel -1), so "
+        "that sentinel and busy state can be detected with a single comparison.");
+  };
+
+  template <class OptionalType>
+  struct OnceCellBusyState<OptionalType, void>
+  {
+    using Operations = SentinelRawBitsOperationsFor<OptionalType>;
+    using RawBits = typename Operations::RawBits;
+    using PayloadType = typename OptionalType::value_type;
+
+    static constexpr bool hasBusyState = std::is_same_v<
+        typename SentinelLayoutTraits<OptionalType>::SentinelInfo::SentinelValue,
+        SentinelForExploitingUnusedBits<PayloadType>>;
+    static constexpr bool differsFromSentinelOnlyInLowestBit = hasBusyState;
+
+    [[nodiscard]] static RawBits GetBits() noexcept
+    {
+      return static_cast<RawBits>(Operations::GetSentinelBits() ^ RawBits{1});
+    }
+
+    [[nodiscard]] static bool IsSentinelOrBusy(RawBits bits) noexcept
+    {
+      if constexpr (differsFromSentinelOnlyInLowestBit) {
+        // Sentinel and busy state in one comparison.
+        RawBits const sentinelBitsWithLowestBit = static_cast<RawBits>(Operations::GetSentinelBits() | RawBits{1});
+        return static_cast<RawBits>(bits | RawBits{1}) == sentinelBitsWithLowestBit;
+      }
+      else {
+        return bits == Operations::GetSentinelBits();
+      }
+    }
+  };
+
+
+  // How a call of InitializeOnceSlow() obtained the returned value.
+  enum class OnceInitOutcome
+  {
+    Computed, // This thread called the initialization function and stored its result.
+    ComputedButDiscarded, // This thread called the initialization function, but another thread stored its result first.
+    Waited // Another thread called the initialization function, and this thread waited for it.
+  };
+
+
+  template <class RawBits>
+  void WaitWhileOnceInitBusy(
+      [[maybe_unused]] std::atomic<RawBits> const & bits,
+      [[maybe_unused]] RawBits busyBits) noexcept
+  {
+#ifdef TINY_OPTIONAL_CPP20
+    bits.wait(busyBits, std::memory_order_acquire);
+#else
+    std::this_thread::yield();
+#endif
+  }
+
+
+  template <class RawBits>
+  void NotifyOnceInitWaiters([[maybe_unused]] std::atomic<RawBits> & bits) noexcept
+  {
+#ifdef TINY_OPTIONAL_CPP20
+    bits.notify_all();
+#endif
+  }
+
+
+  // The slow path of initializing 'bits' (which must be the sentinel or the busy state) exactly once with the result of
+  // 'init', shared by once_cell and memo_array. See once_cell for the semantics. Returns the bits of the final value.
+  template <class BusyState, class Init>
+  [[nodiscard]] typename BusyState::RawBits InitializeOnceSlow(
+      std::atomic<typename BusyState::RawBits> & bits,
+      Init && init,
+      OnceInitOutcome & outcome)
+  {
+    using RawBits = typename BusyState::RawBits;
+    using PayloadType = typename BusyState::PayloadType;
+    RawBits const sentinelBits = BusyState::Operations::GetSentinelBits();
+
+    auto const computeBits = [&init]() {
+      RawBits const newBits = LoadRawBits<RawBits>(static_cast<PayloadType>(std::forward<Init>(init)()));
+      assert(!BusyState::IsSentinelOrBusy(newBits) && "The value must be neither the sentinel nor the BusyValue.");
+      return newBits;
+    };
+
+    if constexpr (BusyState::hasBusyState) {
+      RawBits const busyBits = BusyState::GetBits();
+      for (;;) {
+        RawBits expected = sentinelBits;
+        if (bits.compare_exchange_strong(expected, busyBits, std::memory_order_acquire)) {
+          // This thread initializes the value.
+          RawBits newBits;
+          try {
+            newBits = computeBits();
+          }
+          catch (...) {
+            bits.store(sentinelBits, std::memory_order_release);
+            NotifyOnceInitWaiters(bits);
+            throw;
+          }
+          bits.store(newBits, std::memory_order_release);
+          NotifyOnceInitWaiters(bits);
+          outcome = OnceInitOutcome::Computed;
+          return newBits;
+        }
+
+        // Another thread initializes the value (or did so already). If it fails, 'expected' becomes the sentinel again
+        // and this thread tries to take over.
+        while (expected == busyBits) {
+          WaitWhileOnceInitBusy(bits, busyBits);
+          expected = bits.load(std::memory_order_acquire);
+        }
+        if (expected != sentinelBits) {
+          outcome = OnceInitOutcome::Waited;
+          return expected;
+        }
+      }
+    }
+    else {
+      RawBits const newBits = computeBits();
+      RawBits expected = sentinelBits;
+      if (bits.compare_exchange_strong(expected, newBits, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        outcome = OnceInitOutcome::Computed;
+        return newBits;
+      }
+      // Another thread was faster. Its value wins, so that all threads observe the same value.
+      outcome = OnceInitOutcome::ComputedButDiscarded;
+      return expected;
+    }
+  }
+} // namespace impl
+
+
+// A value that is initialized at most once, and that can be read and initialized concurrently from multiple threads
+// without locks. Typical use case: Memoizing an expensive per-object value such as a cached norm.
+// 'OptionalType' must be a tiny optional that stores the empty state as sentinel in the whole scalar payload, e.g.
+// tiny::optional<double> or tiny::optional<int, -1> (the same requirement as for tiny::atomic_optional). The
+// 'uninitialized' state is the sentinel, so the once_cell has the size of the payload and needs no separate flag.
+//
+// Concurrent calls of get_or_init() for an uninitialized cell behave in one of two ways:
+// - If an 'initializing' state is available (see impl::OnceCellBusyState), one thread marks the cell as initializing
+//   via a CAS and runs the initialization function. The other threads wait for it (via std::atomic::wait in C++20,
+//   by spinning and yielding before).
+//   This is the default for payloads with a sentinel chosen by the library (e.g. double, float, bool and pointers).
+//   For other payloads, an invalid value can be specified via 'BusyValue', which must be a type with a static member
+//   'value' and differ from the sentinel in exactly one bit (e.g. std::integral_constant<int, -2> for
+//   tiny::optional<int, -1>).
+// - Otherwise, every thread runs the initialization function, and the first one to store its result via a CAS wins.
+//   All threads return the winning value. This is fine for idempotent and cheap-enough initializations.
+// In both cases, the fast path after the initialization is a single acquire load plus a single comparison.
+template <class OptionalType, class BusyValue = void>
+class once_cell
+{
+  static_assert(
+      is_tiny_optional_v<OptionalType>,
+      "once_cell: The template argument must be a tiny optional, e.g. tiny::optional<double>.");
+  static_assert(
+      impl::BulkConversionTraits<OptionalType>::isVectorizable,
+      "once_cell: The tiny optional must store the empty state as sentinel in the whole payload, and the payload "
+      "must be a scalar of size 1, 2, 4 or 8 bytes (e.g. tiny::optional<double> or tiny::optional<int, -1>).");
+
+private:
+  using Operations = impl::SentinelRawBitsOperationsFor<OptionalType>;
+  using RawBits = typename Operations::RawBits;
+  using BusyState = impl::OnceCellBusyState<OptionalType, BusyValue>;
+
+public:
+  using value_type = OptionalType;
+  using payload_type = typename OptionalType::value_type;
+
+  // True if concurrent initializers wait for the one that runs the initialization function.
+  static constexpr bool has_busy_state = BusyState::hasBusyState;
+
+  once_cell() noexcept
+    : mBits(Operations::GetSentinelBits())
+  {
+    if constexpr (has_busy_state) {
+      assert(BusyState::GetBits() != Operations::GetSentinelBits() && "once_cell: BusyValue equals the sentinel.");
+    }
+  }
+
+  once_cell(once_cell const &) = delete;
+  once_cell & operator=(once_cell const &) = delete;
+
+  // Returns the value. If the cell is not yet initialized, calls 'init' (a function without parameters returning
+  // something convertible to payload_type) to initialize it first. If 'init' throws, the cell remains uninitialized
+  // and the exception propagates.
+  template <class Init>
+  [[nodiscard]] payload_type get_or_init(Init && init)
+  {
+    RawBits const bits = mBits.load(std::memory_order_acquire);
+    if (!IsUninitialized(bits)) {
+      return ToPayload(bits);
+    }
+    return InitializeSlow(std::forward<Init>(init));
+  }
+
+  // Returns the value if the cell is initialized, and an empty optional otherwise (also while another thread is
+  // initializing it). Never blocks.
+  [[nodiscard]] OptionalType get() const noexcept
+  {
+    RawBits const bits = mBits.load(std::memory_order_acquire);
+    return IsUninitialized(bits) ? OptionalType{} : OptionalType(ToPayload(bits));
+  }
+
+  [[nodiscard]] bool is_initialized() const noexcept
+  {
+    return !IsUninitialized(mBits.load(std::memory_order_acquire));
+  }
+
+  // Initializes the cell with 'value' if it is neither initialized nor being initialized. Returns true if 'value' was
+  // stored.
+  bool set(payload_type const & value) noexcept
+  {
+    RawBits expected = Operations::GetSentinelBits();
+    bool const stored = mBits.compare_exchange_strong(expected, ToBits(value), std::memory_order_acq_rel);
+    if constexpr (has_busy_state) {
+      if (stored) {
+        impl::NotifyOnceInitWaiters(mBits);
+      }
+    }
+    return stored;
+  }
+
+private:
+  [[nodiscard]] static bool IsUninitialized(RawBits bits) noexcept
+  {
+    return BusyState::IsSentinelOrBusy(bits);
+  }
+
+  [[nodiscard]] static RawBits ToBits(payload_type const & value) noexcept
+  {
+    RawBits const bits = impl::LoadRawBits<RawBits>(value);
+    assert(!IsUninitialized(bits) && "once_cell: The value must be neither the sentinel nor the BusyValue.");
+    return bits;
+  }
+
+  [[nodiscard]] static payload_type ToPayload(RawBits bits) noexcept
+  {
+    payload_type value;
+    impl::StoreRawBits(value, bits);
+    return value;
+  }
+
+  template <class Init>
+  payload_type InitializeSlow(Init && init)
+  {
+    impl::OnceInitOutcome outcome;
+    return ToPayload(impl::InitializeOnceSlow<BusyState>(mBits, std::forward<Init>(init), outcome));
+  }
+
+  std::atomic<RawBits> mBits;
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
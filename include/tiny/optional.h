@@ -65,6 +65,7 @@ Original repository: https://github.com/Sedeniono/tiny-optional
 
 #if (defined(__cplusplus) && __cplusplus >= 202002L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
   #define TINY_OPTIONAL_CPP20
+  #include <bit> // Required for std::bit_cast
 #endif
 
 #if (defined(__cplusplus) && __cplusplus >= 202302L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 202302L)
@@ -112,17 +113,67 @@ Original repository: https://github.com/Sedeniono/tiny-optional
   #define TINY_OPTIONAL_ENABLE_ORELSE
 #endif
 
-// In C++20 the tiny::optional destructor becomes trivial if the destructor of the payload is trivial, as required by
-// the C++ standard for std::optional. Similarly, we make the copy/move constructor and copy/move assignment trivial if
-// possible; additional conditions apply there, however (see IsCandidateForInplaceTrivialCopyAndMove).
-// It would be possible to do this also in C++17, however, this requires more conditional inheritance
-// and for simplicity we do not implement it. In C++20 it is much easier thanks to `requires`.
-// clang <=14 does not support multiple destructors (https://github.com/llvm/llvm-project/issues/45614).
+// The tiny::optional destructor is trivial if the destructor of the payload is trivial, as required by the C++ standard
+// for std::optional. Similarly, we make the copy/move constructor and copy/move assignment trivial if possible (see
+// StorageBase). In C++20 this is implemented via `requires`. In C++17 (and for clang <=14, which does not support
+// multiple destructors, https://github.com/llvm/llvm-project/issues/45614), we need conditional inheritance instead
+// (see DestructionBase, MoveConstructionBase, etc.). TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS selects the
+// conditional inheritance and disables the triviality; it exists mainly to compare compilation times.
 #if defined(__cpp_concepts) && (!defined(__clang__) || __clang_major__ >= 15)                                          \
     && !defined(TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS)
   #define TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
 #endif
 
+// In C++20, std::construct_at and std::bit_cast make it possible to implement the member functions as constexpr (see
+// ConstructAt() and MemcpyAndCmpFlagManipulator). Note that std::construct_at is available via <optional>.
+#if defined(TINY_OPTIONAL_CPP20) && defined(__cpp_lib_bit_cast) && defined(__cpp_constexpr_dynamic_alloc)
+  #define TINY_OPTIONAL_ENABLE_CONSTEXPR
+  #define TINY_OPTIONAL_CONSTEXPR constexpr
+#else
+  #define TINY_OPTIONAL_CONSTEXPR
+#endif
+
+// Opt-in: Without optimizations, a call such as has_value() goes through several layers of tiny helper functions
+// (TinyOptionalImpl, StorageBase, the decomposition and the flag manipulator), each of which is a real call in a debug
+// build. Defining TINY_OPTIONAL_FORCE_INLINE_DEBUG forces the inlining of these helpers on the hot paths (has_value(),
+// operator*, operator->, value() and value_or()), and replaces std::addressof there by the builtin. For gcc and clang,
+// the helpers are additionally marked as 'artificial', so that debuggers step over them (e.g. with -Og). For MSVC,
+// __forceinline has no effect with /Od alone; it additionally requires /Ob1.
+#ifdef TINY_OPTIONAL_FORCE_INLINE_DEBUG
+  #if defined(__GNUC__) || defined(__clang__)
+    #if __has_attribute(artificial)
+      #define TINY_OPTIONAL_IMPL_FORCE_INLINE __attribute__((always_inline, artificial)) inline
+    #else
+      #define TINY_OPTIONAL_IMPL_FORCE_INLINE __attribute__((always_inline)) inline
+    #endif
+    #define TINY_OPTIONAL_IMPL_ADDRESSOF(x) __builtin_addressof(x)
+  #elif defined(_MSC_VER)
+    #define TINY_OPTIONAL_IMPL_FORCE_INLINE __forceinline
+    #define TINY_OPTIONAL_IMPL_ADDRESSOF(x) __builtin_addressof(x)
+  #endif
+#endif
+#ifndef TINY_OPTIONAL_IMPL_FORCE_INLINE
+  #define TINY_OPTIONAL_IMPL_FORCE_INLINE
+  #define TINY_OPTIONAL_IMPL_ADDRESSOF(x) std::addressof(x)
+#endif
+
+// gcc and clang expand __builtin_memcpy with a small constant size inline at every optimization level, also with
+// -fno-builtin. See MemcpyAndCmpFlagManipulator.
+#if defined(__GNUC__) || defined(__clang__)
+  #define TINY_OPTIONAL_IMPL_MEMCPY __builtin_memcpy
+#else
+  #define TINY_OPTIONAL_IMPL_MEMCPY std::memcpy
+#endif
+
+// Tells the optimizer the expected value of a bool, which mainly affects the code layout (the unexpected branch is
+// moved out of the hot path). MSVC has no such builtin; its [[likely]] can only be applied to statements.
+#if defined(__GNUC__) || defined(__clang__)
+  #define TINY_OPTIONAL_IMPL_EXPECT(cond, expected)                                                                    \
+    (__builtin_expect(static_cast<long>(cond), static_cast<long>(expected)) != 0)
+#else
+  #define TINY_OPTIONAL_IMPL_EXPECT(cond, expected) (cond)
+#endif
+
 #ifdef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
   #define TINY_OPTIONAL_UNUSED_BITS_NS_PART noBit
 #else
@@ -190,6 +241,42 @@ enum UseDefaultType
 template <class PayloadType_, auto sentinelOrMemPtr = UseDefaultValue, auto irrelevantOrSentinel = UseDefaultValue>
 class optional;
 
+// Tag for transform<TargetOptional>(f): The result is a tiny::optional_aip of the type returned by f.
+struct UseOptionalAip
+{
+};
+
+
+// Hint for the compiler how likely it is that an optional is empty. See optional_with_hint.
+enum class emptiness_hint
+{
+  none, // No hint, i.e. the compiler decides on its own.
+  rarely_empty,
+  mostly_empty
+};
+
+
+// What a conversion between different optional types (converting constructors and assignments, optional_cast(),
+// assign_optional()) does if the source contains a value that the target uses as sentinel, i.e. if the target cannot
+// represent the value.
+enum class sentinel_collision
+{
+  assert_not_sentinel, // assert() if NDEBUG is not defined (as when storing the sentinel directly). Otherwise empty.
+  throw_exception, // Throws a tiny::bad_optional_conversion. The target is empty afterwards.
+  make_empty // The target is empty afterwards.
+};
+
+
+// Thrown by conversions with sentinel_collision::throw_exception.
+class bad_optional_conversion : public std::exception
+{
+public:
+  [[nodiscard]] char const * what() const noexcept override
+  {
+    return "tiny::bad_optional_conversion: The value is the sentinel of the target optional.";
+  }
+};
+
 
 namespace impl
 {
@@ -197,6 +284,27 @@ namespace impl
   struct NoCustomInplaceFlagManipulator
   {
   };
+
+
+  // Placement new, but usable in constant expressions in C++20 (where placement new is not allowed, but
+  // std::construct_at is).
+  template <class T, class... ArgsT>
+  TINY_OPTIONAL_CONSTEXPR void ConstructAt(T & uninitializedMemory, ArgsT &&... args) noexcept(
+      std::is_nothrow_constructible_v<T, ArgsT...>)
+  {
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+    if constexpr (!std::is_volatile_v<T>) {
+      if (std::is_constant_evaluated()) {
+        std::construct_at(
+            const_cast<std::remove_const_t<T> *>(std::addressof(uninitializedMemory)), std::forward<ArgsT>(args)...);
+        return;
+      }
+    }
+#endif
+    // Regarding the cast: https://stackoverflow.com/q/63325244/3740047
+    ::new (const_cast<void *>(static_cast<void volatile const *>(std::addressof(uninitializedMemory))))
+        T(std::forward<ArgsT>(args)...);
+  }
 } // namespace impl
 TINY_OPTIONAL_INLINE_NS_END
 
@@ -250,17 +358,19 @@ TINY_OPTIONAL_INLINE_NS_BEGIN
 template <class PayloadType, auto SentinelValue>
 struct sentinel_flag_manipulator
 {
-  static bool is_empty(PayloadType const & payload) noexcept
+  TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR bool is_empty(PayloadType const & payload) noexcept
   {
     return payload == SentinelValue;
   }
 
-  static void init_empty_flag(PayloadType & uninitializedPayloadMemory) noexcept
+  TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void
+      init_empty_flag(PayloadType & uninitializedPayloadMemory) noexcept
   {
-    ::new (std::addressof(uninitializedPayloadMemory)) PayloadType(SentinelValue);
+    impl::ConstructAt(uninitializedPayloadMemory, SentinelValue);
   }
 
-  static void invalidate_empty_flag(PayloadType & emptyPayload) noexcept
+  TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void
+      invalidate_empty_flag(PayloadType & emptyPayload) noexcept
   {
     emptyPayload.~PayloadType();
   }
@@ -408,6 +518,61 @@ namespace impl
   };
 
 
+  // Helper tag for the converting constructors of optionals, which passes on the sentinel_collision policy.
+  template <sentinel_collision policy>
+  struct ConvertFromOptionalTag
+  {
+  };
+
+
+  // The optional type returned by transform<TargetOptional>(func) if func() returns a U. By default, this is
+  // tiny::optional<U>. See below for the specializations.
+  template <class TargetOptional, class U>
+  struct TransformResult
+  {
+    static_assert(
+        is_tiny_optional_v<TargetOptional>,
+        "transform<TargetOptional>(f): TargetOptional must be a tiny optional type, e.g. tiny::optional<int, -1>.");
+    static_assert(
+        std::is_same_v<std::remove_cv_t<typename TargetOptional::value_type>, U>
+            || std::is_constructible_v<typename TargetOptional::value_type, U>,
+        "transform<TargetOptional>(f): The payload of TargetOptional must be constructible from the result of f.");
+    using type = TargetOptional;
+  };
+
+  template <class U>
+  struct TransformResult<UseDefaultType, U>
+  {
+    using type = ::tiny::optional<U>;
+  };
+
+
+  // True if converting the optional type Source to Target is a plain conversion of the payload bits, including the
+  // empty state. Defined below.
+  template <class Target, class Source>
+  constexpr bool IsBitwiseOptionalConversion();
+
+
+  // True if converting the argument U of value_or() to the PayloadType can neither have side effects nor undefined
+  // behavior (e.g. not double to int, which is UB if out of range). value_or() can then perform the conversion even if
+  // the optional contains a value.
+  template <class U, class PayloadType>
+  constexpr bool IsConversionFreeOfSideEffects()
+  {
+    using From = my_remove_cvref_t<U>;
+    using To = std::remove_cv_t<PayloadType>;
+    if constexpr (std::is_volatile_v<std::remove_reference_t<U>>) {
+      return false; // Reading a volatile is a side effect.
+    }
+    else {
+      return std::is_same_v<From, To> || (std::is_integral_v<From> && std::is_integral_v<To>)
+             || (std::is_same_v<From, std::nullptr_t> && std::is_pointer_v<To>)
+             || (std::is_integral_v<From> && sizeof(From) <= sizeof(long long) && std::is_floating_point_v<To>)
+             || (std::is_floating_point_v<From> && std::is_floating_point_v<To> && sizeof(To) >= sizeof(From));
+    }
+  }
+
+
   //====================================================================================
   // SentinelForExploitingUnusedBits
   //====================================================================================
@@ -551,15 +716,53 @@ namespace impl
   // Types used as storage in the optional.
   //====================================================================================
 
+#ifndef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+  // C++17: The conditions under which the special member functions of tiny::optional are trivial. They are the same as
+  // in C++20, compare StorageBase.
+  template <class PayloadType>
+  struct TrivialSpecialMemberFunctions
+  {
+  #ifdef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+    static constexpr bool enabled = false;
+  #else
+    static constexpr bool enabled = true;
+  #endif
+
+    static constexpr bool destructor = enabled && std::is_trivially_destructible_v<PayloadType>;
+    static constexpr bool moveConstructor = enabled && std::is_trivially_move_constructible_v<PayloadType>;
+    static constexpr bool copyConstructor = enabled && std::is_trivially_copy_constructible_v<PayloadType>;
+    static constexpr bool moveAssignment = enabled && std::is_trivially_move_constructible_v<PayloadType>
+                                           && std::is_trivially_move_assignable_v<PayloadType>
+                                           && std::is_trivially_destructible_v<PayloadType>;
+    static constexpr bool copyAssignment = enabled && std::is_trivially_copy_constructible_v<PayloadType>
+                                           && std::is_trivially_copy_assignable_v<PayloadType>
+                                           && std::is_trivially_destructible_v<PayloadType>;
+  };
+#endif
+
+
   // When optional is not doing anything special, i.e. in cases where it behaves just like std::optional, it uses
   // this wrapper to store the 'IsEmpty'-Flag outside of the payload.
+#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
   template <class PayloadType>
+#else
+  // C++17: This primary template is used if the destructor of tiny::optional can be trivial. Then the storage must not
+  // have a user-provided destructor. See the specialization below for the other case.
+  template <class PayloadType, bool = TrivialSpecialMemberFunctions<PayloadType>::destructor>
+#endif
   struct SeparateFlagStorage
   {
+    struct EmptyAlternative
+    {
+    };
+
     // Union to prevent automatic initialization of mStorage. I.e. this only allocates the memory without
     // calling the constructor of PayloadType.
+    // The empty alternative is active while there is no payload. This does not cost anything, but a constant expression
+    // must not contain a union without active member (relevant for constexpr in C++20).
     union
     {
+      EmptyAlternative emptyAlternative{};
       std::remove_const_t<PayloadType> payload;
     };
 
@@ -568,7 +771,7 @@ namespace impl
 
 #ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
     // Non-trivial constructor required if the payload is non-trivally constructible due to the union.
-    SeparateFlagStorage()
+    TINY_OPTIONAL_CONSTEXPR SeparateFlagStorage()
       requires(!std::is_trivially_constructible_v<PayloadType>)
     {
     }
@@ -588,7 +791,7 @@ namespace impl
     SeparateFlagStorage & operator=(SeparateFlagStorage &&) = default;
 
     // Non-trivial destructor required if the payload is non-trivally destructible due to the union.
-    ~SeparateFlagStorage()
+    TINY_OPTIONAL_CONSTEXPR ~SeparateFlagStorage()
       requires(!std::is_trivially_destructible_v<PayloadType>)
     {
     }
@@ -598,14 +801,45 @@ namespace impl
       requires(std::is_trivially_destructible_v<PayloadType>)
     = default;
 #else
-    SeparateFlagStorage() { }
-    ~SeparateFlagStorage() { }
+    TINY_OPTIONAL_CONSTEXPR SeparateFlagStorage() { }
 #endif
   };
 
 
+#ifndef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+  // C++17: Version if the destructor of tiny::optional is non-trivial. The union requires a user-provided destructor,
+  // and thus the copy and move constructors/assignments need to be defaulted explicitly.
+  template <class PayloadType>
+  struct SeparateFlagStorage<PayloadType, false>
+  {
+    struct EmptyAlternative
+    {
+    };
+
+    union
+    {
+      EmptyAlternative emptyAlternative{};
+      std::remove_const_t<PayloadType> payload;
+    };
+
+    bool isEmptyFlag;
+
+    TINY_OPTIONAL_CONSTEXPR SeparateFlagStorage() { }
+    SeparateFlagStorage(SeparateFlagStorage const &) = default;
+    SeparateFlagStorage(SeparateFlagStorage &&) = default;
+    SeparateFlagStorage & operator=(SeparateFlagStorage const &) = default;
+    SeparateFlagStorage & operator=(SeparateFlagStorage &&) = default;
+    TINY_OPTIONAL_CONSTEXPR ~SeparateFlagStorage() { }
+  };
+#endif
+
+
   // Used by the optional if the IsEmpty flag is stored within the payload.
+#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
   template <class PayloadType>
+#else
+  template <class PayloadType, bool = TrivialSpecialMemberFunctions<PayloadType>::destructor>
+#endif
   struct InplaceStorage
   {
     // In analogy to SeparateFlagStorage.
@@ -618,7 +852,7 @@ namespace impl
     // In analogy to SeparateFlagStorage: Used for trivial versions.
 #ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
     // Non-trivial constructor required if the payload is non-trivally constructible due to the union.
-    InplaceStorage()
+    TINY_OPTIONAL_CONSTEXPR InplaceStorage()
       requires(!std::is_trivially_constructible_v<PayloadType>)
     {
     }
@@ -634,7 +868,7 @@ namespace impl
     InplaceStorage & operator=(InplaceStorage &&) = default;
 
     // Non-trivial destructor required if the payload is non-trivally destructible due to the union.
-    ~InplaceStorage()
+    TINY_OPTIONAL_CONSTEXPR ~InplaceStorage()
       requires(!std::is_trivially_destructible_v<PayloadType>)
     {
     }
@@ -644,12 +878,31 @@ namespace impl
       requires(std::is_trivially_destructible_v<PayloadType>)
     = default;
 #else
-    InplaceStorage() { }
-    ~InplaceStorage() { }
+    TINY_OPTIONAL_CONSTEXPR InplaceStorage() { }
 #endif
   };
 
 
+#ifndef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+  // In analogy to SeparateFlagStorage.
+  template <class PayloadType>
+  struct InplaceStorage<PayloadType, false>
+  {
+    union
+    {
+      std::remove_const_t<PayloadType> storage;
+    };
+
+    TINY_OPTIONAL_CONSTEXPR InplaceStorage() { }
+    InplaceStorage(InplaceStorage const &) = default;
+    InplaceStorage(InplaceStorage &&) = default;
+    InplaceStorage & operator=(InplaceStorage const &) = default;
+    InplaceStorage & operator=(InplaceStorage &&) = default;
+    TINY_OPTIONAL_CONSTEXPR ~InplaceStorage() { }
+  };
+#endif
+
+
   //====================================================================================
   // StoredTypeDecomposition
   //====================================================================================
@@ -681,12 +934,12 @@ namespace impl
     using PayloadType = PayloadType_;
     using StoredType = SeparateFlagStorage<PayloadType>;
 
-    [[nodiscard]] static constexpr bool & GetIsEmptyFlag(StoredType & v) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static constexpr bool & GetIsEmptyFlag(StoredType & v) noexcept
     {
       return v.isEmptyFlag;
     }
 
-    [[nodiscard]] static constexpr PayloadType & GetPayload(StoredType & v) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static constexpr PayloadType & GetPayload(StoredType & v) noexcept
     {
       return v.payload;
     }
@@ -702,12 +955,12 @@ namespace impl
     using StoredType = InplaceStorage<PayloadType_>;
     using PayloadType = PayloadType_;
 
-    [[nodiscard]] static constexpr auto & GetIsEmptyFlag(StoredType & v) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static constexpr auto & GetIsEmptyFlag(StoredType & v) noexcept
     {
       return v.storage;
     }
 
-    [[nodiscard]] static constexpr PayloadType & GetPayload(StoredType & v) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static constexpr PayloadType & GetPayload(StoredType & v) noexcept
     {
       return v.storage;
     }
@@ -740,12 +993,12 @@ namespace impl
     using StoredType = InplaceStorage<PayloadType_>;
     using PayloadType = PayloadType_;
 
-    [[nodiscard]] static constexpr auto & GetIsEmptyFlag(StoredType & v) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static constexpr auto & GetIsEmptyFlag(StoredType & v) noexcept
     {
       return v.storage.*memPtrToIsEmptyFlag;
     }
 
-    [[nodiscard]] static constexpr PayloadType & GetPayload(StoredType & v) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static constexpr PayloadType & GetPayload(StoredType & v) noexcept
     {
       return v.storage;
     }
@@ -778,19 +1031,32 @@ namespace impl
    * We are using snake_case for the function names since users of the library might need to use
    * the concept (via tiny::optional_flag_manipulator or optional_inplace), and the whole public
    * interface of the library uses snake_case (because std::optional does).
+   *
+   * Additionally, a FlagManipulator can define a 'static constexpr emptiness_hint emptinessHint'
+   * (see optional_with_hint). It defaults to emptiness_hint::none.
    */
 
 
+  template <class FlagManipulator, class = void>
+  inline constexpr emptiness_hint EmptinessHintOf = emptiness_hint::none;
+
+  template <class FlagManipulator>
+  inline constexpr emptiness_hint
+      EmptinessHintOf<FlagManipulator, std::void_t<decltype(FlagManipulator::emptinessHint)>>
+      = FlagManipulator::emptinessHint;
+
+
   // Used when the optional is behaving as a std::optional, i.e. when the 'IsEmpty' flag is
   // stored in a separate bool variable (via SeparateFlagStorage).
   struct SeparateFlagManipulator
   {
-    [[nodiscard]] static bool is_empty(bool isEmptyFlag) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR bool
+        is_empty(bool isEmptyFlag) noexcept
     {
       return isEmptyFlag;
     }
 
-    static void init_empty_flag(bool & isEmptyFlag) noexcept
+    TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void init_empty_flag(bool & isEmptyFlag) noexcept
     {
       // Using placement new would be wrong here: The constructor of SeparateFlagStorage already pops the bool object
       // into existence (but with an indeterminate value). Also, invalidate_empty_flag() does not destroy the
@@ -798,7 +1064,8 @@ namespace impl
       isEmptyFlag = true;
     }
 
-    static void invalidate_empty_flag(bool & isEmptyFlag) noexcept
+    TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void
+        invalidate_empty_flag(bool & isEmptyFlag) noexcept
     {
       // We do not destruct the bool object, since SeparateFlagStorage::isEmptyFlag should remain valid during the whole
       // lifetime of the optional. That is the whole point of the SeparateFlagStorage.
@@ -807,11 +1074,49 @@ namespace impl
   };
 
 
+  template <std::size_t size>
+  struct UnsignedIntegerOfSize
+  {
+  };
+
+  template <>
+  struct UnsignedIntegerOfSize<1>
+  {
+    using type = std::uint8_t;
+  };
+
+  template <>
+  struct UnsignedIntegerOfSize<2>
+  {
+    using type = std::uint16_t;
+  };
+
+  template <>
+  struct UnsignedIntegerOfSize<4>
+  {
+    using type = std::uint32_t;
+  };
+
+  template <>
+  struct UnsignedIntegerOfSize<8>
+  {
+    using type = std::uint64_t;
+  };
+
+
   // Used when we exploit that the payload (or a member variable within the payload) has unused bit patterns.
   // In this case we use type punning and set the flag's bits directly to SentinelValue::value, which is typically
   // given by SentinelForExploitingUnusedBits.
   // Note that FlagType and the type of the given SentinelValue::value can have different types. They are compared
   // and copied 'raw' (in the sense of std::memcmp and std::memcpy).
+  // In constant expressions (C++20), std::bit_cast replaces std::memcpy and std::memcmp. This works only if the flag
+  // and the sentinel have the same size, and only if the sentinel is a valid value of the flag type during constant
+  // evaluation. E.g. the NaN sentinels of floating point types are fine, but the sentinels of bool and pointers are
+  // not.
+  // At runtime, if the flag has the size of an integer and the sentinel is an integer of the same size (which is the
+  // case for all the sentinels in SentinelForExploitingUnusedBits), the flag is loaded into an unsigned integer and
+  // compared with the sentinel. Compilers turn this into a single 'cmp' with optimizations, and even without
+  // optimizations there is no call to std::memcmp.
   template <class FlagType, class SentinelValue>
   struct MemcpyAndCmpFlagManipulator
   {
@@ -819,6 +1124,19 @@ namespace impl
     static constexpr auto valueToIndicateEmpty = SentinelValue::value;
     static_assert(sizeof(valueToIndicateEmpty) <= sizeof(FlagType));
 
+    // Volatile flags always go through std::memcmp and std::memcpy below.
+    static constexpr bool canCompareAsInteger = sizeof(valueToIndicateEmpty) == sizeof(FlagType)
+                                                && (sizeof(FlagType) == 1 || sizeof(FlagType) == 2
+                                                    || sizeof(FlagType) == 4 || sizeof(FlagType) == 8)
+                                                && std::is_integral_v<decltype(valueToIndicateEmpty)>
+                                                && !std::is_volatile_v<FlagType>;
+
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+    static constexpr bool canBitCast = sizeof(valueToIndicateEmpty) == sizeof(FlagType)
+                                       && std::is_integral_v<decltype(valueToIndicateEmpty)>
+                                       && !std::is_volatile_v<FlagType>;
+#endif
+
     // Required so that we can use std::memcpy and std::memcmp in a way that is covered by the C++ standard.
     // Compare https://stackoverflow.com/a/59522771/3740047 and https://en.cppreference.com/w/cpp/string/byte/memcmp.
     // Until gcc <=9, however, CWG 2094 was not implemented (https://stackoverflow.com/q/36098055/3740047),
@@ -830,29 +1148,66 @@ namespace impl
 #endif
 
   public:
-    [[nodiscard]] static bool is_empty(FlagType const & isEmptyFlag) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR bool
+        is_empty(FlagType const & isEmptyFlag) noexcept
     {
-      // Regarding the cast: https://stackoverflow.com/q/63325244/3740047
-      return std::memcmp(
-                 const_cast<void *>(static_cast<void volatile const *>(std::addressof(isEmptyFlag))),
-                 &valueToIndicateEmpty,
-                 sizeof(valueToIndicateEmpty))
-             == 0;
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+      if constexpr (canBitCast) {
+        if (std::is_constant_evaluated()) {
+          return std::bit_cast<std::remove_const_t<decltype(valueToIndicateEmpty)>>(isEmptyFlag)
+                 == valueToIndicateEmpty;
+        }
+      }
+#endif
+      if constexpr (canCompareAsInteger) {
+        using Bits = typename UnsignedIntegerOfSize<sizeof(FlagType)>::type;
+        Bits flagBits;
+        TINY_OPTIONAL_IMPL_MEMCPY(&flagBits, TINY_OPTIONAL_IMPL_ADDRESSOF(isEmptyFlag), sizeof(Bits));
+        return flagBits == static_cast<Bits>(valueToIndicateEmpty);
+      }
+      else {
+        // Regarding the cast: https://stackoverflow.com/q/63325244/3740047
+        return std::memcmp(
+                   const_cast<void *>(static_cast<void volatile const *>(std::addressof(isEmptyFlag))),
+                   &valueToIndicateEmpty,
+                   sizeof(valueToIndicateEmpty))
+               == 0;
+      }
     }
 
-    static void init_empty_flag(FlagType & uninitializedIsEmptyFlagMemory) noexcept
+    TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void
+        init_empty_flag(FlagType & uninitializedIsEmptyFlagMemory) noexcept
     {
-      // Similar to placement new, memcpy pops the flag object into existence:
-      // https://en.cppreference.com/w/cpp/string/byte/memcpy
-      // To this end note the static_asserts above: The flag is trivially copyable.
-      // Regarding the cast: https://stackoverflow.com/q/63325244/3740047
-      std::memcpy(
-          const_cast<void *>(static_cast<void volatile const *>(std::addressof(uninitializedIsEmptyFlagMemory))),
-          &valueToIndicateEmpty,
-          sizeof(valueToIndicateEmpty));
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+      if constexpr (canBitCast) {
+        if (std::is_constant_evaluated()) {
+          ConstructAt(uninitializedIsEmptyFlagMemory, std::bit_cast<std::remove_cv_t<FlagType>>(valueToIndicateEmpty));
+          return;
+        }
+      }
+#endif
+      if constexpr (canCompareAsInteger) {
+        using Bits = typename UnsignedIntegerOfSize<sizeof(FlagType)>::type;
+        Bits const sentinelBits = static_cast<Bits>(valueToIndicateEmpty);
+        TINY_OPTIONAL_IMPL_MEMCPY(
+            const_cast<void *>(static_cast<void const *>(TINY_OPTIONAL_IMPL_ADDRESSOF(uninitializedIsEmptyFlagMemory))),
+            &sentinelBits,
+            sizeof(Bits));
+      }
+      else {
+        // Similar to placement new, memcpy pops the flag object into existence:
+        // https://en.cppreference.com/w/cpp/string/byte/memcpy
+        // To this end note the static_asserts above: The flag is trivially copyable.
+        // Regarding the cast: https://stackoverflow.com/q/63325244/3740047
+        std::memcpy(
+            const_cast<void *>(static_cast<void volatile const *>(std::addressof(uninitializedIsEmptyFlagMemory))),
+            &valueToIndicateEmpty,
+            sizeof(valueToIndicateEmpty));
+      }
     }
 
-    static void invalidate_empty_flag(FlagType & isEmptyFlag) noexcept
+    TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void
+        invalidate_empty_flag(FlagType & isEmptyFlag) noexcept
     {
       // Destroy the flag object. In cases such as a simple 'double', this does not really translate to any
       // instructions. But it ensures that we formally destroy the object that was previously created in
@@ -919,7 +1274,8 @@ namespace impl
 
 
   public:
-    [[nodiscard]] static bool is_empty(FlagType const & isEmptyFlag) noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR bool
+        is_empty(FlagType const & isEmptyFlag) noexcept
     {
       // static_assert: Because tiny::optional requires is_empty() to be noexcept; otherwise, it could not give the same
       // noexcept guarantees as std::optional.
@@ -933,19 +1289,19 @@ namespace impl
       return isEmptyFlag == valueToIndicateEmpty;
     }
 
-    static void init_empty_flag(FlagType & uninitializedIsEmptyFlagMemory) noexcept
+    TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void
+        init_empty_flag(FlagType & uninitializedIsEmptyFlagMemory) noexcept
     {
       // static_assert: Because tiny::optional requires init_empty_flag() to be noexcept; otherwise, it could not
       // give the same noexcept guarantees as std::optional.
       static_assert(
           noexcept(*const_cast<std::remove_cv_t<FlagType> *>(&uninitializedIsEmptyFlagMemory) = valueToIndicateEmpty),
           "The assignment operator of the flag type must be noexcept.");
-      // Regarding the cast: https://stackoverflow.com/q/63325244/3740047
-      ::new (const_cast<void *>(static_cast<void volatile const *>(std::addressof(uninitializedIsEmptyFlagMemory))))
-          FlagType(valueToIndicateEmpty);
+      ConstructAt(uninitializedIsEmptyFlagMemory, valueToIndicateEmpty);
     }
 
-    static void invalidate_empty_flag(FlagType & isEmptyFlag) noexcept
+    TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR void
+        invalidate_empty_flag(FlagType & isEmptyFlag) noexcept
     {
       // Destroy the object that was previously created in init_empty_flag() (but do not free the
       // associated memory!).
@@ -994,6 +1350,18 @@ struct optional_flag_manipulator<
 
 
 TINY_OPTIONAL_INLINE_NS_BEGIN
+// Helper similar to sentinel_flag_manipulator, but the empty state is indicated by a specific bit pattern that is
+// compared 'raw' (in the sense of std::memcmp) instead of via operator==. This allows e.g. to use the specific NaN of
+// some existing data format as sentinel for doubles:
+//      tiny::optional_inplace<double, tiny::bit_pattern_flag_manipulator<double, UINT64_C(0x7ff80000deadbeef)>>
+// The type of 'bitPattern' must not be larger than the payload. If it is smaller, only the first bytes are compared.
+template <class PayloadType, auto bitPattern>
+struct bit_pattern_flag_manipulator
+  : impl::MemcpyAndCmpFlagManipulator<PayloadType, std::integral_constant<decltype(bitPattern), bitPattern>>
+{
+};
+
+
 namespace impl
 {
   // True if there is a custom flag manipulator was 'registered' for the given payload type.
@@ -1056,14 +1424,14 @@ namespace impl
         std::is_object_v<PayloadType> && std::is_destructible_v<PayloadType> && !std::is_array_v<PayloadType>,
         "The payload type must meet the C++ requirement 'Destructible'.");
 
-    StorageBase() noexcept
+    TINY_OPTIONAL_CONSTEXPR StorageBase() noexcept
     {
       FlagManipulator::init_empty_flag(GetIsEmptyFlag());
       assert(!has_value());
     }
 
     template <class... ArgsT>
-    explicit StorageBase(std::in_place_t, ArgsT &&... args)
+    explicit TINY_OPTIONAL_CONSTEXPR StorageBase(std::in_place_t, ArgsT &&... args)
     {
       // Initialize the IsEmpty flag first since invalidate_empty_flag() might depend on it.
       FlagManipulator::init_empty_flag(GetIsEmptyFlag());
@@ -1071,7 +1439,7 @@ namespace impl
     }
 
     template <class FuncT, class ArgT>
-    StorageBase(DirectInitializationFromFunctionTag, FuncT && func, ArgT && arg)
+    TINY_OPTIONAL_CONSTEXPR StorageBase(DirectInitializationFromFunctionTag, FuncT && func, ArgT && arg)
     {
       // Initialize the IsEmpty flag first since invalidate_empty_flag() might depend on it.
       FlagManipulator::init_empty_flag(GetIsEmptyFlag());
@@ -1083,7 +1451,7 @@ namespace impl
     // Moreover, we implement trivial special member functions since it is easily possible.
 #ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
     // Non-trivial destructor.
-    ~StorageBase()
+    TINY_OPTIONAL_CONSTEXPR ~StorageBase()
       requires(!std::is_trivially_destructible_v<PayloadType>)
     {
       if (has_value()) {
@@ -1157,7 +1525,7 @@ namespace impl
     = default;
 
     // Non-trivial move constructor
-    StorageBase(StorageBase && rhs) noexcept(std::is_nothrow_move_constructible_v<PayloadType>)
+    TINY_OPTIONAL_CONSTEXPR StorageBase(StorageBase && rhs) noexcept(std::is_nothrow_move_constructible_v<PayloadType>)
       requires(hasMoveConstructor && !hasTrivialMoveConstructor)
       : StorageBase() // Basic initialization via default constructor
     {
@@ -1178,7 +1546,7 @@ namespace impl
     = default;
 
     // Non-trivial copy constructor
-    StorageBase(StorageBase const & rhs)
+    TINY_OPTIONAL_CONSTEXPR StorageBase(StorageBase const & rhs)
       requires(hasCopyConstructor && !hasTrivialCopyConstructor)
       : StorageBase() // Basic initialization via default constructor
     {
@@ -1201,7 +1569,7 @@ namespace impl
     = default;
 
     // Non-trivial move assignment
-    StorageBase & operator=(StorageBase && rhs) noexcept(
+    TINY_OPTIONAL_CONSTEXPR StorageBase & operator=(StorageBase && rhs) noexcept(
         std::is_nothrow_move_assignable_v<PayloadType> && std::is_nothrow_move_constructible_v<PayloadType>)
       requires(hasMoveAssignment && !hasTrivialMoveAssignment)
     {
@@ -1225,7 +1593,7 @@ namespace impl
     = default;
 
     // Non-trivial copy assignment
-    StorageBase & operator=(StorageBase const & rhs)
+    TINY_OPTIONAL_CONSTEXPR StorageBase & operator=(StorageBase const & rhs)
       requires(hasCopyAssignment && !hasTrivialCopyAssignment)
     {
       CopyAssignmentImpl(rhs);
@@ -1233,64 +1601,109 @@ namespace impl
     }
 
 #else // TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
-    // C++17 version. Trivial versions of the special member functions are not implemented for simplicity.
-    // It would require even more conditional inheritance.
-
-    ~StorageBase()
-    {
-      if (has_value()) {
-        DestroyPayload();
-      }
-    }
-
-    // The proper implemention of the special member functions are defined in the derived classes.
-    // We delete the special member functions to ensure that they really are not called.
-    StorageBase(StorageBase const &) = delete;
-    StorageBase(StorageBase &&) = delete;
-    StorageBase & operator=(StorageBase const &) = delete;
-    StorageBase & operator=(StorageBase &&) = delete;
+    // C++17 version: The special member functions are implicitly declared and simply copy/move/destroy mStorage. This
+    // is exactly what the trivial versions need. The derived classes (DestructionBase, MoveConstructionBase, etc.)
+    // replace them with the non-trivial or deleted versions as required.
 #endif // TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
 
 
-    [[nodiscard]] bool has_value() const noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR bool has_value() const noexcept
     {
-      return !FlagManipulator::is_empty(GetIsEmptyFlag());
+      // Every check of the empty state goes through here (value(), value_or(), the monadic operations, comparisons,
+      // etc.), so the hint applies to all of them.
+      constexpr emptiness_hint hint = EmptinessHintOf<FlagManipulator>;
+      if constexpr (hint == emptiness_hint::rarely_empty) {
+        return TINY_OPTIONAL_IMPL_EXPECT(!FlagManipulator::is_empty(GetIsEmptyFlag()), true);
+      }
+      else if constexpr (hint == emptiness_hint::mostly_empty) {
+        return TINY_OPTIONAL_IMPL_EXPECT(!FlagManipulator::is_empty(GetIsEmptyFlag()), false);
+      }
+      else {
+        return !FlagManipulator::is_empty(GetIsEmptyFlag());
+      }
     }
 
-    [[nodiscard]] FlagType & GetIsEmptyFlag() noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR FlagType & GetIsEmptyFlag() noexcept
     {
       return StoredTypeDecomposition::GetIsEmptyFlag(this->mStorage);
     }
 
-    [[nodiscard]] FlagType const & GetIsEmptyFlag() const noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR FlagType const &
+        GetIsEmptyFlag() const noexcept
     {
       return const_cast<StorageBase &>(*this).GetIsEmptyFlag();
     }
 
-    [[nodiscard]] PayloadType & GetPayload() noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType & GetPayload() noexcept
     {
       return StoredTypeDecomposition::GetPayload(this->mStorage);
     }
 
-    [[nodiscard]] PayloadType const & GetPayload() const noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType const &
+        GetPayload() const noexcept
     {
       return const_cast<StorageBase &>(*this).GetPayload();
     }
 
-    void DestroyPayload() noexcept
+    TINY_OPTIONAL_CONSTEXPR void DestroyPayload() noexcept
     {
       GetPayload().~PayloadType();
     }
 
 
+    // If the optional is compressed and the payload trivially copyable, the storage always contains a valid object
+    // representation (either the value or the sentinel), and copying its bytes also copies the IsEmpty flag. So e.g.
+    // swap() can simply swap the whole storage without branching on has_value().
+    static constexpr bool isBitwiseCopyable
+        = is_compressed && std::is_trivially_copyable_v<PayloadType> && std::is_trivially_copyable_v<StoredType>
+          && !std::is_volatile_v<PayloadType>;
+
+    // Additionally, scalar payloads can be selected via their bits (see SelectPayloadOr()). Not bool, since its
+    // sentinel is not a valid bool.
+    static constexpr bool isBitwiseSelectable
+        = isBitwiseCopyable && std::is_scalar_v<PayloadType> && !std::is_same_v<std::remove_cv_t<PayloadType>, bool>
+          && (sizeof(PayloadType) == 1 || sizeof(PayloadType) == 2 || sizeof(PayloadType) == 4
+              || sizeof(PayloadType) == 8);
+
+    // Returns the payload if the optional has a value, and the given defaultValue otherwise. Selects via a bit mask
+    // instead of a branch, since for example the compilers tend to branch on a ternary operator with doubles. With
+    // many empty optionals in random order, the branch is mispredicted frequently.
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR std::remove_cv_t<PayloadType>
+        SelectPayloadOr(std::remove_cv_t<PayloadType> defaultValue) const noexcept
+    {
+      static_assert(isBitwiseSelectable);
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+      if (std::is_constant_evaluated()) {
+        return has_value() ? GetPayload() : defaultValue;
+      }
+#endif
+      using Bits = typename UnsignedIntegerOfSize<sizeof(PayloadType)>::type;
+      Bits payloadBits;
+      Bits defaultBits;
+      TINY_OPTIONAL_IMPL_MEMCPY(&payloadBits, TINY_OPTIONAL_IMPL_ADDRESSOF(GetPayload()), sizeof(Bits));
+      TINY_OPTIONAL_IMPL_MEMCPY(&defaultBits, &defaultValue, sizeof(Bits));
+      Bits const mask = static_cast<Bits>(Bits{0} - static_cast<Bits>(has_value()));
+      Bits const resultBits = static_cast<Bits>((payloadBits & mask) | (defaultBits & static_cast<Bits>(~mask)));
+      std::remove_cv_t<PayloadType> result;
+      TINY_OPTIONAL_IMPL_MEMCPY(&result, &resultBits, sizeof(Bits));
+      return result;
+    }
+
+    TINY_OPTIONAL_CONSTEXPR void SwapStorage(StorageBase & other) noexcept
+    {
+      static_assert(isBitwiseCopyable);
+      std::swap(mStorage, other.mStorage);
+    }
+
+
     struct InitializeIsEmptyFlagScope
     {
-      explicit InitializeIsEmptyFlagScope(StorageBase & opt) noexcept
+      explicit TINY_OPTIONAL_CONSTEXPR InitializeIsEmptyFlagScope(StorageBase & opt) noexcept
         : opt(opt)
       {
       }
 
-      ~InitializeIsEmptyFlagScope()
+      TINY_OPTIONAL_CONSTEXPR ~InitializeIsEmptyFlagScope()
       {
         if (!doNotInitialize) {
           FlagManipulator::init_empty_flag(opt.GetIsEmptyFlag());
@@ -1303,14 +1716,30 @@ namespace impl
 
 
     template <class... ArgsT>
-    void ConstructPayload(ArgsT &&... args) noexcept(std::is_nothrow_constructible_v<PayloadType, ArgsT...>)
+    TINY_OPTIONAL_CONSTEXPR void ConstructPayload(ArgsT &&... args) noexcept(
+        std::is_nothrow_constructible_v<PayloadType, ArgsT...>)
+    {
+      ConstructPayloadMaybeSentinel(std::forward<ArgsT>(args)...);
+
+      // For example: A tiny optional storing an int and the special value MAX_INT indicates an empty optional.
+      // If you then try to put MAX_INT directly into the optional, this assert gets triggered.
+      // You must use reset() instead. Otherwise, we could run into inconsistencies with FlagManipulator.
+      assert(
+          has_value()
+          && "Maybe the special sentinel value used to indicate an empty optional was assigned. Use reset() instead.");
+    }
+
+
+    // Like ConstructPayload(), but the caller must check has_value() afterwards and handle the case that the
+    // constructed payload is the sentinel (see MakeEmptyAfterSentinelCollision()).
+    template <class... ArgsT>
+    TINY_OPTIONAL_CONSTEXPR void ConstructPayloadMaybeSentinel(ArgsT &&... args) noexcept(
+        std::is_nothrow_constructible_v<PayloadType, ArgsT...>)
     {
       // We first need to call the prepare function because it might free memory etc.
       // But that means, if the placement new throws, we need to initialize the
       // empty flag again afterwards. This is done by means of InitializeIsEmptyFlagScope.
 
-      // Regarding the volatile casts: https://stackoverflow.com/q/63325244/3740047
-
       assert(!has_value());
       FlagManipulator::invalidate_empty_flag(GetIsEmptyFlag());
 
@@ -1321,34 +1750,55 @@ namespace impl
       if constexpr (std::is_nothrow_constructible_v<PayloadType, ArgsT...>) {
         // Don't burden the optimizer with optimizing away the InitializeIsEmptyFlagScope if the scope is unnecessary in
         // the first place (i.e. if the construction cannot throw).
-        ::new (const_cast<void *>(static_cast<void volatile const *>(std::addressof(GetPayload()))))
-            PayloadType(std::forward<ArgsT>(args)...);
+        ConstructAt(GetPayload(), std::forward<ArgsT>(args)...);
       }
       else {
         InitializeIsEmptyFlagScope initScope{*this};
-        ::new (const_cast<void *>(static_cast<void volatile const *>(std::addressof(GetPayload()))))
-            PayloadType(std::forward<ArgsT>(args)...);
+        ConstructAt(GetPayload(), std::forward<ArgsT>(args)...);
         initScope.doNotInitialize = true;
       }
 
       // NOLINTEND(clang-analyzer-core.uninitialized.Assign)
+    }
 
-      // For example: A tiny optional storing an int and the special value MAX_INT indicates an empty optional.
-      // If you then try to put MAX_INT directly into the optional, this assert gets triggered.
-      // You must use reset() instead. Otherwise, we could run into inconsistencies with FlagManipulator.
-      assert(
-          has_value()
-          && "Maybe the special sentinel value used to indicate an empty optional was assigned. Use reset() instead.");
+
+    // Called if a payload was constructed or assigned that turned out to be the sentinel, i.e. has_value() is false
+    // although the payload is alive. Ends its lifetime and restores a proper empty state. Then handles the collision
+    // as requested by the policy.
+    template <sentinel_collision policy>
+    TINY_OPTIONAL_CONSTEXPR void MakeEmptyAfterSentinelCollision()
+    {
+      assert(!has_value());
+      DestroyPayload();
+      FlagManipulator::init_empty_flag(GetIsEmptyFlag());
+
+      if constexpr (policy == sentinel_collision::assert_not_sentinel) {
+        assert(false && "The converted value is the sentinel of the target optional, which thus cannot represent it.");
+      }
+      else if constexpr (policy == sentinel_collision::throw_exception) {
+        throw bad_optional_conversion{};
+      }
     }
 
 
     template <class FuncT, class ArgT>
-    void ConstructPayloadFromFunction(FuncT && func, ArgT && arg) noexcept(
+    TINY_OPTIONAL_CONSTEXPR void ConstructPayloadFromFunction(FuncT && func, ArgT && arg) noexcept(
         std::is_nothrow_constructible_v<PayloadType, std::invoke_result_t<FuncT, ArgT>>)
     {
       assert(!has_value());
       FlagManipulator::invalidate_empty_flag(GetIsEmptyFlag());
 
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+      // Placement new constructs the payload directly from the prvalue returned by 'func'. std::construct_at cannot do
+      // this, so constant expressions require the payload to be movable.
+      if constexpr (std::is_move_constructible_v<PayloadType> && !std::is_volatile_v<PayloadType>) {
+        if (std::is_constant_evaluated()) {
+          ConstructAt(GetPayload(), std::invoke(std::forward<FuncT>(func), std::forward<ArgT>(arg)));
+          return;
+        }
+      }
+#endif
+
       // clang-tidy apparently does not correctly see placement news, resulting in false positive warnings. So suppress
       // the warning.
       // NOLINTBEGIN(clang-analyzer-core.uninitialized.Assign)
@@ -1377,7 +1827,7 @@ namespace impl
 
 
     template <class T>
-    void AssignValue(T && v)
+    TINY_OPTIONAL_CONSTEXPR void AssignValue(T && v)
     {
       if (has_value()) {
         GetPayload() = std::forward<T>(v);
@@ -1395,7 +1845,7 @@ namespace impl
     }
 
 
-    void reset() noexcept
+    TINY_OPTIONAL_CONSTEXPR void reset() noexcept
     {
       if (has_value()) {
         this->DestroyPayload();
@@ -1405,7 +1855,8 @@ namespace impl
     }
 
 
-    void MoveConstructorImpl(StorageBase && rhs) noexcept(std::is_nothrow_move_constructible_v<PayloadType>)
+    TINY_OPTIONAL_CONSTEXPR void MoveConstructorImpl(StorageBase && rhs) noexcept(
+        std::is_nothrow_move_constructible_v<PayloadType>)
     {
       if (rhs.has_value()) {
         this->ConstructPayload(std::move(rhs.GetPayload()));
@@ -1420,7 +1871,7 @@ namespace impl
     }
 
 
-    void CopyConstructorImpl(StorageBase const & rhs)
+    TINY_OPTIONAL_CONSTEXPR void CopyConstructorImpl(StorageBase const & rhs)
     {
       if (rhs.has_value()) {
         this->ConstructPayload(rhs.GetPayload());
@@ -1432,7 +1883,7 @@ namespace impl
     }
 
 
-    void MoveAssignmentImpl(StorageBase && rhs) noexcept(
+    TINY_OPTIONAL_CONSTEXPR void MoveAssignmentImpl(StorageBase && rhs) noexcept(
         std::is_nothrow_move_assignable_v<PayloadType> && std::is_nothrow_move_constructible_v<PayloadType>)
     {
       if (rhs.has_value()) {
@@ -1447,7 +1898,7 @@ namespace impl
       assert(this->has_value() == rhs.has_value());
     }
 
-    void CopyAssignmentImpl(StorageBase const & rhs)
+    TINY_OPTIONAL_CONSTEXPR void CopyAssignmentImpl(StorageBase const & rhs)
     {
       if (rhs.has_value()) {
         this->AssignValue(rhs.GetPayload());
@@ -1467,6 +1918,57 @@ namespace impl
 
 #ifndef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
 
+  // In C++17, the special member functions of tiny::optional are implemented via a conditional inheritance hierarchy:
+  //    StorageBase <- DestructionBase <- MoveConstructionBase <- CopyConstructionBase <- MoveAssignmentBase
+  //    <- CopyAssignmentBase <- TinyOptionalImpl
+  // Each class in the hierarchy is responsible for exactly one special member function. Via template specialization,
+  // it either keeps the implicitly declared trivial version, implements the non-trivial version or deletes it. All the
+  // other special member functions are defaulted explicitly, so that they simply forward to the base class. (Defaulting
+  // them explicitly is necessary because declaring e.g. a move constructor would delete the copy assignment otherwise.)
+  // Thereby, the triviality of the special member functions is the same as in C++20 (see StorageBase).
+  //
+  // In C++20 we implement everything via `requires` and therefore do not need the whole hierarchy.
+
+
+  //====================================================================================
+  // DestructionBase
+  //====================================================================================
+
+  // Version with trivial destructor: The implicitly declared special member functions are used.
+  template <
+      class StoredTypeDecomposition,
+      class FlagManipulator,
+      bool = TrivialSpecialMemberFunctions<typename StoredTypeDecomposition::PayloadType>::destructor>
+  struct DestructionBase : StorageBase<StoredTypeDecomposition, FlagManipulator>
+  {
+    using Base = StorageBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base::Base;
+  };
+
+
+  // Version with non-trivial destructor.
+  template <class StoredTypeDecomposition, class FlagManipulator>
+  struct DestructionBase<StoredTypeDecomposition, FlagManipulator, false>
+    : StorageBase<StoredTypeDecomposition, FlagManipulator>
+  {
+    using Base = StorageBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base::Base;
+
+    DestructionBase() = default;
+    DestructionBase(DestructionBase const &) = default;
+    DestructionBase(DestructionBase &&) = default;
+    DestructionBase & operator=(DestructionBase const &) = default;
+    DestructionBase & operator=(DestructionBase &&) = default;
+
+    TINY_OPTIONAL_CONSTEXPR ~DestructionBase()
+    {
+      if (this->has_value()) {
+        this->DestroyPayload();
+      }
+    }
+  };
+
+
   //====================================================================================
   // MoveConstructionBase
   //====================================================================================
@@ -1478,27 +1980,29 @@ namespace impl
   // MoveConstructionBase. Using template specialization, MoveConstructionBase either implements the move constructor or
   // deletes it, depending on whether the payload is move constructible or not. The defaulted move constructor of
   // TinyOptionalImpl will then automatically participate in overload resolution or not.
-  //
-  // In C++20 we implement everything via `requires` and therefore do not need the whole hierarchy.
 
-  // First version of MoveConstructionBase if the payload is move constructible.
+  // First version of MoveConstructionBase if the payload is move constructible, with non-trivial move constructor.
   template <
       class StoredTypeDecomposition,
       class FlagManipulator,
-      bool = std::is_move_constructible_v<typename StoredTypeDecomposition::PayloadType>>
-  struct MoveConstructionBase : StorageBase<StoredTypeDecomposition, FlagManipulator>
+      bool = std::is_move_constructible_v<typename StoredTypeDecomposition::PayloadType>,
+      bool = TrivialSpecialMemberFunctions<typename StoredTypeDecomposition::PayloadType>::moveConstructor>
+  struct MoveConstructionBase : DestructionBase<StoredTypeDecomposition, FlagManipulator>
   {
-    using Base = StorageBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base = DestructionBase<StoredTypeDecomposition, FlagManipulator>;
 
     using Base::Base;
     using PayloadType = typename Base::PayloadType;
 
     MoveConstructionBase() = default;
     MoveConstructionBase(MoveConstructionBase const &) = default;
+    MoveConstructionBase & operator=(MoveConstructionBase const &) = default;
+    MoveConstructionBase & operator=(MoveConstructionBase &&) = default;
 
-    MoveConstructionBase(MoveConstructionBase && rhs) noexcept(std::is_nothrow_move_constructible_v<PayloadType>)
-      // Call Base's **default** constructor (not the move constructor, since it is deleted). The whole purpose of the
-      // present class is to implement the proper non-trival move constructor.
+    TINY_OPTIONAL_CONSTEXPR MoveConstructionBase(MoveConstructionBase && rhs) noexcept(
+        std::is_nothrow_move_constructible_v<PayloadType>)
+      // Call Base's **default** constructor (not the move constructor, since it would copy the storage). The whole
+      // purpose of the present class is to implement the proper non-trival move constructor.
       : Base()
     {
       this->MoveConstructorImpl(std::move(rhs));
@@ -1506,17 +2010,29 @@ namespace impl
   };
 
 
-  // Version with deleted move constructor.
+  // Version with trivial move constructor.
   template <class StoredTypeDecomposition, class FlagManipulator>
-  struct MoveConstructionBase<StoredTypeDecomposition, FlagManipulator, false>
-    : StorageBase<StoredTypeDecomposition, FlagManipulator>
+  struct MoveConstructionBase<StoredTypeDecomposition, FlagManipulator, true, true>
+    : DestructionBase<StoredTypeDecomposition, FlagManipulator>
   {
-    using Base = StorageBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base = DestructionBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base::Base;
+  };
+
+
+  // Version with deleted move constructor.
+  template <class StoredTypeDecomposition, class FlagManipulator, bool trivial>
+  struct MoveConstructionBase<StoredTypeDecomposition, FlagManipulator, false, trivial>
+    : DestructionBase<StoredTypeDecomposition, FlagManipulator>
+  {
+    using Base = DestructionBase<StoredTypeDecomposition, FlagManipulator>;
     using Base::Base;
 
     MoveConstructionBase() = default;
     MoveConstructionBase(MoveConstructionBase const &) = default;
     MoveConstructionBase(MoveConstructionBase &&) = delete;
+    MoveConstructionBase & operator=(MoveConstructionBase const &) = default;
+    MoveConstructionBase & operator=(MoveConstructionBase &&) = default;
   };
 
 
@@ -1528,11 +2044,12 @@ namespace impl
   // payload is not copy constructible. Similar to MoveConstructionBase, we need to use a dedicated base class to
   // actually implement the conditional deletion.
 
-  // First version of CopyConstructionBase if the payload is copy constructible.
+  // First version of CopyConstructionBase if the payload is copy constructible, with non-trivial copy constructor.
   template <
       class StoredTypeDecomposition,
       class FlagManipulator,
-      bool = std::is_copy_constructible_v<typename StoredTypeDecomposition::PayloadType>>
+      bool = std::is_copy_constructible_v<typename StoredTypeDecomposition::PayloadType>,
+      bool = TrivialSpecialMemberFunctions<typename StoredTypeDecomposition::PayloadType>::copyConstructor>
   struct CopyConstructionBase : MoveConstructionBase<StoredTypeDecomposition, FlagManipulator>
   {
     using Base = MoveConstructionBase<StoredTypeDecomposition, FlagManipulator>;
@@ -1542,8 +2059,10 @@ namespace impl
 
     CopyConstructionBase() = default;
     CopyConstructionBase(CopyConstructionBase &&) = default;
+    CopyConstructionBase & operator=(CopyConstructionBase const &) = default;
+    CopyConstructionBase & operator=(CopyConstructionBase &&) = default;
 
-    CopyConstructionBase(CopyConstructionBase const & rhs)
+    TINY_OPTIONAL_CONSTEXPR CopyConstructionBase(CopyConstructionBase const & rhs)
       // Call Base's default constructor since the whole purpose of the present class is to implement
       // the proper copy constructor (so the base class does not have a proper one).
       : Base()
@@ -1553,9 +2072,19 @@ namespace impl
   };
 
 
-  // Version with deleted copy constructor.
+  // Version with trivial copy constructor.
   template <class StoredTypeDecomposition, class FlagManipulator>
-  struct CopyConstructionBase<StoredTypeDecomposition, FlagManipulator, false>
+  struct CopyConstructionBase<StoredTypeDecomposition, FlagManipulator, true, true>
+    : MoveConstructionBase<StoredTypeDecomposition, FlagManipulator>
+  {
+    using Base = MoveConstructionBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base::Base;
+  };
+
+
+  // Version with deleted copy constructor.
+  template <class StoredTypeDecomposition, class FlagManipulator, bool trivial>
+  struct CopyConstructionBase<StoredTypeDecomposition, FlagManipulator, false, trivial>
     : MoveConstructionBase<StoredTypeDecomposition, FlagManipulator>
   {
     using Base = MoveConstructionBase<StoredTypeDecomposition, FlagManipulator>;
@@ -1564,6 +2093,8 @@ namespace impl
     CopyConstructionBase() = default;
     CopyConstructionBase(CopyConstructionBase const &) = delete;
     CopyConstructionBase(CopyConstructionBase &&) = default;
+    CopyConstructionBase & operator=(CopyConstructionBase const &) = default;
+    CopyConstructionBase & operator=(CopyConstructionBase &&) = default;
   };
 
 
@@ -1575,12 +2106,14 @@ namespace impl
   // payload is not move constructible and move assignable. Similar to MoveConstructionBase, we need to use a dedicated
   // base class to actually implement the conditional deletion.
 
-  // First version of MoveAssignmentBase if the payload is both move constructible and move assignable.
+  // First version of MoveAssignmentBase if the payload is both move constructible and move assignable, with
+  // non-trivial move assignment operator.
   template <
       class StoredTypeDecomposition,
       class FlagManipulator,
       bool = std::is_move_constructible_v<typename StoredTypeDecomposition::PayloadType>
-             && std::is_move_assignable_v<typename StoredTypeDecomposition::PayloadType>>
+             && std::is_move_assignable_v<typename StoredTypeDecomposition::PayloadType>,
+      bool = TrivialSpecialMemberFunctions<typename StoredTypeDecomposition::PayloadType>::moveAssignment>
   struct MoveAssignmentBase : CopyConstructionBase<StoredTypeDecomposition, FlagManipulator>
   {
     using Base = CopyConstructionBase<StoredTypeDecomposition, FlagManipulator>;
@@ -1593,7 +2126,7 @@ namespace impl
     MoveAssignmentBase(MoveAssignmentBase &&) = default;
     MoveAssignmentBase & operator=(MoveAssignmentBase const &) = default;
 
-    MoveAssignmentBase & operator=(MoveAssignmentBase && rhs) noexcept(
+    TINY_OPTIONAL_CONSTEXPR MoveAssignmentBase & operator=(MoveAssignmentBase && rhs) noexcept(
         std::is_nothrow_move_assignable_v<PayloadType> && std::is_nothrow_move_constructible_v<PayloadType>)
     {
       this->MoveAssignmentImpl(std::move(rhs));
@@ -1602,9 +2135,19 @@ namespace impl
   };
 
 
-  // Version with deleted move assignment operator.
+  // Version with trivial move assignment operator.
   template <class StoredTypeDecomposition, class FlagManipulator>
-  struct MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator, false>
+  struct MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator, true, true>
+    : CopyConstructionBase<StoredTypeDecomposition, FlagManipulator>
+  {
+    using Base = CopyConstructionBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base::Base;
+  };
+
+
+  // Version with deleted move assignment operator.
+  template <class StoredTypeDecomposition, class FlagManipulator, bool trivial>
+  struct MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator, false, trivial>
     : CopyConstructionBase<StoredTypeDecomposition, FlagManipulator>
   {
     using Base = CopyConstructionBase<StoredTypeDecomposition, FlagManipulator>;
@@ -1626,12 +2169,14 @@ namespace impl
   // payload is not copy constructible or copy assignable. Similar to MoveConstructionBase, we need to use a dedicated
   // base class to actually implement the conditional deletion.
 
-  // First version of CopyAssignmentBase if the payload is copy constructible and copy assignable.
+  // First version of CopyAssignmentBase if the payload is copy constructible and copy assignable, with non-trivial
+  // copy assignment operator.
   template <
       class StoredTypeDecomposition,
       class FlagManipulator,
       bool = std::is_copy_constructible_v<typename StoredTypeDecomposition::PayloadType>
-             && std::is_copy_assignable_v<typename StoredTypeDecomposition::PayloadType>>
+             && std::is_copy_assignable_v<typename StoredTypeDecomposition::PayloadType>,
+      bool = TrivialSpecialMemberFunctions<typename StoredTypeDecomposition::PayloadType>::copyAssignment>
   struct CopyAssignmentBase : MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator>
   {
     using Base = MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator>;
@@ -1642,7 +2187,7 @@ namespace impl
     CopyAssignmentBase(CopyAssignmentBase const &) = default;
     CopyAssignmentBase & operator=(CopyAssignmentBase &&) = default;
 
-    CopyAssignmentBase & operator=(CopyAssignmentBase const & rhs)
+    TINY_OPTIONAL_CONSTEXPR CopyAssignmentBase & operator=(CopyAssignmentBase const & rhs)
     {
       this->CopyAssignmentImpl(rhs);
       return *this;
@@ -1650,9 +2195,19 @@ namespace impl
   };
 
 
-  // Version with deleted assignment operator.
+  // Version with trivial copy assignment operator.
   template <class StoredTypeDecomposition, class FlagManipulator>
-  struct CopyAssignmentBase<StoredTypeDecomposition, FlagManipulator, false>
+  struct CopyAssignmentBase<StoredTypeDecomposition, FlagManipulator, true, true>
+    : MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator>
+  {
+    using Base = MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator>;
+    using Base::Base;
+  };
+
+
+  // Version with deleted assignment operator.
+  template <class StoredTypeDecomposition, class FlagManipulator, bool trivial>
+  struct CopyAssignmentBase<StoredTypeDecomposition, FlagManipulator, false, trivial>
     : MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator>
   {
     using Base = MoveAssignmentBase<StoredTypeDecomposition, FlagManipulator>;
@@ -1675,8 +2230,8 @@ namespace impl
   // Actual implementation of optional.
   template <class StoredTypeDecomposition, class FlagManipulator>
   class TinyOptionalImpl
-  // In C++17 we need a conditional inheritance hierarchy to implement the special member functions. For simplicity, we
-  // do not implement the triviality requirement of std::optional there.
+  // In C++17 we need a conditional inheritance hierarchy to implement the special member functions (including their
+  // triviality as required for std::optional).
   // In C++20 we can implement the various versions of the special member functions via `requires`. This bypasses quite
   // a lot of complexity, and compile times might benefit from it, too.
 #ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
@@ -1724,6 +2279,24 @@ namespace impl
         // Compare https://stackoverflow.com/q/33511641/3740047
         && (!std::is_scalar_v<PayloadType> || !std::is_same_v<std::decay_t<U>, PayloadType>)>;
 
+    // For the converting constructors and assignments from other optionals. Compare the std::optional standard.
+    template <class OtherOptional>
+    using EnableConvertingFromOptional = std::bool_constant<
+        IsSomeOptional<my_remove_cvref_t<OtherOptional>>
+        // Copy and move constructors are used for the same type. Regarding the derived types, see
+        // EnableConvertingConstructor.
+        && !std::is_base_of_v<TinyOptionalImpl, my_remove_cvref_t<OtherOptional>>
+        && std::is_constructible_v<PayloadType, decltype(*std::declval<OtherOptional>())>
+        // E.g. optional<optional<int>> constructed from an optional<int> should contain the optional<int>.
+        && !std::is_constructible_v<PayloadType, OtherOptional> && !std::is_convertible_v<OtherOptional, PayloadType>>;
+
+    template <class TinyOptionalType, class OtherOptional>
+    using EnableConvertingAssignmentFromOptional = std::bool_constant<
+        !std::is_base_of_v<TinyOptionalType, my_remove_cvref_t<OtherOptional>>
+        && EnableConvertingFromOptional<OtherOptional>::value
+        && std::is_assignable_v<PayloadType &, decltype(*std::declval<OtherOptional>())>
+        && !std::is_assignable_v<PayloadType &, OtherOptional>>;
+
 
   public:
     using value_type = PayloadType;
@@ -1747,14 +2320,14 @@ namespace impl
     ~TinyOptionalImpl() = default;
 
 
-    TinyOptionalImpl(std::nullopt_t) noexcept
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(std::nullopt_t) noexcept
       : TinyOptionalImpl()
     {
     }
 
 
     template <class... ArgsT, class = std::enable_if_t<std::is_constructible_v<PayloadType, ArgsT...>>>
-    explicit TinyOptionalImpl(std::in_place_t, ArgsT &&... args)
+    explicit TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(std::in_place_t, ArgsT &&... args)
       : Base(std::in_place, std::forward<ArgsT>(args)...)
     {
     }
@@ -1764,7 +2337,7 @@ namespace impl
         class U,
         class... ArgsT,
         class = std::enable_if_t<std::is_constructible_v<PayloadType, std::initializer_list<U> &, ArgsT...>>>
-    explicit TinyOptionalImpl(std::in_place_t, std::initializer_list<U> ilist, ArgsT &&... args)
+    explicit TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(std::in_place_t, std::initializer_list<U> ilist, ArgsT &&... args)
       : Base(std::in_place, ilist, std::forward<ArgsT>(args)...)
     {
     }
@@ -1772,7 +2345,7 @@ namespace impl
 
     // Special constructor only to be used by transform().
     template <class FuncT, class ArgT>
-    TinyOptionalImpl(DirectInitializationFromFunctionTag tag, FuncT && func, ArgT && arg)
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(DirectInitializationFromFunctionTag tag, FuncT && func, ArgT && arg)
       : Base(tag, std::forward<FuncT>(func), std::forward<ArgT>(arg))
     {
     }
@@ -1782,7 +2355,7 @@ namespace impl
     template <
         class U = PayloadType,
         std::enable_if_t<EnableConvertingConstructor<U>::value && std::is_convertible_v<U, PayloadType>, int> = 0>
-    TinyOptionalImpl(U && v)
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(U && v)
       : Base(std::in_place, std::forward<U>(v))
     {
     }
@@ -1791,31 +2364,50 @@ namespace impl
     template <
         class U = PayloadType,
         std::enable_if_t<EnableConvertingConstructor<U>::value && !std::is_convertible_v<U, PayloadType>, int> = 0>
-    explicit TinyOptionalImpl(U && v)
+    explicit TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(U && v)
       : Base(std::in_place, std::forward<U>(v))
     {
     }
 
 
-    // TODO: What about the converting copy and move constructors and assignments?
-    // Problem: Assume we have
-    //    optional<unsigned, 1> o1;
-    // So the value 1 is used to indicate an empty state. And we have
-    //    optional<int, 42> o2 = 1;
-    // So o2 is not empty and contains the value 1.
-    // What should happen at 'o1 = o2'? o1 cannot contain the value 1 because it indicates an empty state,
-    // but o2 is not empty, so o1 should not be empty, too?
-    // - Throw an exception? But how to actually detect this? Querying that has_value() is the same afterwards
-    //   can be dangerous: We could run into inconsistencies with FlagManipulator.
-    // - Somehow defer to the FlagManipulator and/or StoredTypeDecomposition?
-    // - Do not implement them?
-    // - In principle we could allow all conversions if the rhs did not use any swallowed value
-    //   (meaning either the rhs exploits unused bits or uses a separate bool or is a std::optional).
-    //   If not, issue a static_assert. Or throw an exception?
-    // For now we do not implement them.
+    // Converting constructors from other optionals (tiny ones or std::optional) with a different payload or layout,
+    // e.g. from optional<int, -1> to optional<long, INT_MIN>. The source might contain a value that is the sentinel of
+    // this optional (e.g. INT_MIN in the example). This triggers an assert, as when storing the sentinel directly. Use
+    // optional_cast() to select another behavior.
+    template <
+        class OtherOptional,
+        std::enable_if_t<
+            EnableConvertingFromOptional<OtherOptional>::value
+                && std::is_convertible_v<decltype(*std::declval<OtherOptional>()), PayloadType>,
+            int> = 0>
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(OtherOptional && other)
+      : TinyOptionalImpl(
+            ConvertFromOptionalTag<sentinel_collision::assert_not_sentinel>{}, std::forward<OtherOptional>(other))
+    {
+    }
 
+    template <
+        class OtherOptional,
+        std::enable_if_t<
+            EnableConvertingFromOptional<OtherOptional>::value
+                && !std::is_convertible_v<decltype(*std::declval<OtherOptional>()), PayloadType>,
+            int> = 0>
+    explicit TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(OtherOptional && other)
+      : TinyOptionalImpl(
+            ConvertFromOptionalTag<sentinel_collision::assert_not_sentinel>{}, std::forward<OtherOptional>(other))
+    {
+    }
 
-    TinyOptionalImpl & operator=(std::nullopt_t) noexcept
+    // Special constructor only to be used by the converting constructors and optional_cast().
+    template <sentinel_collision policy, class OtherOptional>
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl(ConvertFromOptionalTag<policy>, OtherOptional && other)
+      : Base()
+    {
+      AssignFromOptional<policy>(std::forward<OtherOptional>(other));
+    }
+
+
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl & operator=(std::nullopt_t) noexcept
     {
       reset();
       return *this;
@@ -1823,15 +2415,71 @@ namespace impl
 
 
     template <class U = PayloadType, std::enable_if_t<EnableConvertingAssignment<TinyOptionalImpl, U>::value, int> = 0>
-    TinyOptionalImpl & operator=(U && v)
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl & operator=(U && v)
     {
       this->AssignValue(std::forward<U>(v));
       return *this;
     }
 
+    // Converting assignment from other optionals. Regarding the sentinel, see the converting constructors.
+    template <
+        class OtherOptional,
+        std::enable_if_t<EnableConvertingAssignmentFromOptional<TinyOptionalImpl, OtherOptional>::value, int> = 0>
+    TINY_OPTIONAL_CONSTEXPR TinyOptionalImpl & operator=(OtherOptional && other)
+    {
+      AssignFromOptional<sentinel_collision::assert_not_sentinel>(std::forward<OtherOptional>(other));
+      return *this;
+    }
+
+
+    // Used by the converting constructors and assignments as well as by optional_cast() and assign_optional().
+    template <sentinel_collision policy, class OtherOptional>
+    TINY_OPTIONAL_CONSTEXPR void AssignFromOptional(OtherOptional && other)
+    {
+      using Source = my_remove_cvref_t<OtherOptional>;
+      if constexpr (IsBitwiseOptionalConversion<TinyOptionalImpl, Source>()) {
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+        if (!std::is_constant_evaluated())
+#endif
+        {
+          // Fast path: The sentinel of the source converts to the sentinel of this optional, and no other value does.
+          // So a single conversion of the payload bits (e.g. a sign extension) also converts the empty state.
+          using SourcePayload = std::remove_cv_t<typename Source::value_type>;
+          SourcePayload sourceBits;
+          TINY_OPTIONAL_IMPL_MEMCPY(&sourceBits, TINY_OPTIONAL_IMPL_ADDRESSOF(other), sizeof(SourcePayload));
+          PayloadType const converted = static_cast<PayloadType>(sourceBits);
+          TINY_OPTIONAL_IMPL_MEMCPY(TINY_OPTIONAL_IMPL_ADDRESSOF(GetPayload()), &converted, sizeof(PayloadType));
+          return;
+        }
+      }
+
+      if (other.has_value()) {
+        if constexpr (std::is_assignable_v<PayloadType &, decltype(*std::forward<OtherOptional>(other))>) {
+          if (has_value()) {
+            GetPayload() = *std::forward<OtherOptional>(other);
+          }
+          else {
+            this->ConstructPayloadMaybeSentinel(*std::forward<OtherOptional>(other));
+          }
+        }
+        else {
+          // E.g. for the converting constructors if the payload is only constructible from the source payload.
+          reset();
+          this->ConstructPayloadMaybeSentinel(*std::forward<OtherOptional>(other));
+        }
+
+        if (!has_value()) {
+          this->template MakeEmptyAfterSentinelCollision<policy>();
+        }
+      }
+      else {
+        reset();
+      }
+    }
+
 
     template <class... ArgsT>
-    PayloadType & emplace(ArgsT &&... args)
+    TINY_OPTIONAL_CONSTEXPR PayloadType & emplace(ArgsT &&... args)
     {
       reset();
       ConstructPayload(std::forward<ArgsT>(args)...);
@@ -1844,7 +2492,7 @@ namespace impl
         class U,
         class... ArgsT,
         class = std::enable_if_t<std::is_constructible_v<PayloadType, std::initializer_list<U> &, ArgsT...>>>
-    PayloadType & emplace(std::initializer_list<U> ilist, ArgsT &&... args)
+    TINY_OPTIONAL_CONSTEXPR PayloadType & emplace(std::initializer_list<U> ilist, ArgsT &&... args)
     {
       reset();
       ConstructPayload(ilist, std::forward<ArgsT>(args)...);
@@ -1853,51 +2501,54 @@ namespace impl
     }
 
 
-    explicit operator bool() const noexcept
+    TINY_OPTIONAL_IMPL_FORCE_INLINE explicit TINY_OPTIONAL_CONSTEXPR operator bool() const noexcept
     {
       return has_value();
     }
 
 
-    [[nodiscard]] PayloadType * operator->() noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType * operator->() noexcept
     {
       assert(has_value() && "operator->() called on an empty optional");
-      return std::addressof(GetPayload());
+      return TINY_OPTIONAL_IMPL_ADDRESSOF(GetPayload());
     }
 
-    [[nodiscard]] PayloadType const * operator->() const noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType const *
+        operator->() const noexcept
     {
       assert(has_value() && "operator->() called on an empty optional");
-      return std::addressof(GetPayload());
+      return TINY_OPTIONAL_IMPL_ADDRESSOF(GetPayload());
     }
 
 
-    [[nodiscard]] PayloadType & operator*() & noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType & operator*() & noexcept
     {
       assert(has_value() && "operator*() called on an empty optional");
       return GetPayload();
     }
 
-    [[nodiscard]] PayloadType const & operator*() const & noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType const &
+        operator*() const & noexcept
     {
       assert(has_value() && "operator*() called on an empty optional");
       return GetPayload();
     }
 
-    [[nodiscard]] PayloadType && operator*() && noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType && operator*() && noexcept
     {
       assert(has_value() && "operator*() called on an empty optional");
       return std::move(GetPayload());
     }
 
-    [[nodiscard]] PayloadType const && operator*() const && noexcept
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType const &&
+        operator*() const && noexcept
     {
       assert(has_value() && "operator*() called on an empty optional");
       return std::move(GetPayload());
     }
 
 
-    [[nodiscard]] PayloadType & value() &
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType & value() &
     {
       if (!has_value()) {
         throw std::bad_optional_access{};
@@ -1905,7 +2556,7 @@ namespace impl
       return GetPayload();
     }
 
-    [[nodiscard]] PayloadType const & value() const &
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType const & value() const &
     {
       if (!has_value()) {
         throw std::bad_optional_access{};
@@ -1913,7 +2564,7 @@ namespace impl
       return GetPayload();
     }
 
-    [[nodiscard]] PayloadType && value() &&
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType && value() &&
     {
       if (!has_value()) {
         throw std::bad_optional_access{};
@@ -1921,7 +2572,7 @@ namespace impl
       return std::move(GetPayload());
     }
 
-    [[nodiscard]] PayloadType const && value() const &&
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR PayloadType const && value() const &&
     {
       if (!has_value()) {
         throw std::bad_optional_access{};
@@ -1931,34 +2582,53 @@ namespace impl
 
 
     template <class U>
-    [[nodiscard]] std::remove_cv_t<PayloadType> value_or(U && defaultValue) const &
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR std::remove_cv_t<PayloadType>
+        value_or(U && defaultValue) const &
     {
       static_assert(
           std::is_copy_constructible_v<PayloadType>,
           "PayloadType must be copy constructible for value_or().");
       static_assert(std::is_convertible_v<U, PayloadType>, "U must be convertible to PayloadType for value_or().");
 
-      return has_value() ? GetPayload() : static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue));
+      if constexpr (Base::isBitwiseSelectable && IsConversionFreeOfSideEffects<U, PayloadType>()) {
+        // The conversion has no side effects, so it can be done unconditionally.
+        return this->SelectPayloadOr(static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue)));
+      }
+      else {
+        return has_value() ? GetPayload() : static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue));
+      }
     }
 
     template <class U>
-    [[nodiscard]] std::remove_cv_t<PayloadType> value_or(U && defaultValue) &&
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE TINY_OPTIONAL_CONSTEXPR std::remove_cv_t<PayloadType>
+        value_or(U && defaultValue) &&
     {
       static_assert(
           std::is_move_constructible_v<PayloadType>,
           "PayloadType must be move constructible for value_or().");
       static_assert(std::is_convertible_v<U, PayloadType>, "U must be convertible to PayloadType for value_or().");
 
-      return has_value() ? std::move(GetPayload())
-                         : static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue));
+      if constexpr (Base::isBitwiseSelectable && IsConversionFreeOfSideEffects<U, PayloadType>()) {
+        return this->SelectPayloadOr(static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue)));
+      }
+      else {
+        return has_value() ? std::move(GetPayload())
+                           : static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue));
+      }
     }
 
 
-    void swap(TinyOptionalImpl & other) noexcept(
+    TINY_OPTIONAL_CONSTEXPR void swap(TinyOptionalImpl & other) noexcept(
         std::is_nothrow_move_constructible_v<PayloadType> && std::is_nothrow_swappable_v<PayloadType>)
     {
       static_assert(std::is_move_constructible_v<PayloadType> && std::is_swappable_v<PayloadType>);
 
+      if constexpr (Base::isBitwiseCopyable) {
+        // Swaps the IsEmpty flags, too.
+        this->SwapStorage(other);
+        return;
+      }
+
       bool const thisHasValue = has_value();
       if (thisHasValue == other.has_value()) {
         if (thisHasValue) {
@@ -2031,7 +2701,7 @@ namespace impl
       }
     }
 
-    template <class F>
+    template <class TargetOptional = UseDefaultType, class F>
     constexpr auto transform(F && f) &
     {
       using U = std::remove_cv_t<std::invoke_result_t<F, PayloadType &>>;
@@ -2042,19 +2712,21 @@ namespace impl
           std::is_object_v<U> && !std::is_array_v<U>,
           "The standard requires 'f' to return a non-array object type.");
 
-      // We need to return some optional type. The standard does not allow the user to influence it. Nevertheless, we
-      // could probably add additional template parameters to transform() to allow some customization. But for now
-      // we simply use the generic one of this library, i.e. tiny::optional. The user can always simply use and_then()
-      // to return a specific optional type.
+      // The standard does not allow the user to influence the returned optional type. By default, we use the generic
+      // one of this library, i.e. tiny::optional<U>. But that wastes memory if e.g. a tiny::optional<int, -1> is
+      // wanted, so the optional type can be specified as TargetOptional (or UseOptionalAip to get a
+      // tiny::optional_aip<U>). The payload is still directly initialized from the return value of f, without any
+      // intermediate.
+      using ResultType = typename TransformResult<TargetOptional, U>::type;
       if (has_value()) {
-        return ::tiny::optional<U>(DirectInitializationFromFunctionTag{}, std::forward<F>(f), **this);
+        return ResultType(DirectInitializationFromFunctionTag{}, std::forward<F>(f), **this);
       }
       else {
-        return ::tiny::optional<U>();
+        return ResultType();
       }
     }
 
-    template <class F>
+    template <class TargetOptional = UseDefaultType, class F>
     constexpr auto transform(F && f) const &
     {
       using U = std::remove_cv_t<std::invoke_result_t<F, PayloadType const &>>;
@@ -2065,16 +2737,17 @@ namespace impl
           std::is_object_v<U> && !std::is_array_v<U>,
           "The standard requires 'f' to return a non-array object type.");
 
-      // Regarding the return of ::tiny::optional, see first overload.
+      // Regarding the ResultType, see first overload.
+      using ResultType = typename TransformResult<TargetOptional, U>::type;
       if (has_value()) {
-        return ::tiny::optional<U>(DirectInitializationFromFunctionTag{}, std::forward<F>(f), **this);
+        return ResultType(DirectInitializationFromFunctionTag{}, std::forward<F>(f), **this);
       }
       else {
-        return ::tiny::optional<U>();
+        return ResultType();
       }
     }
 
-    template <class F>
+    template <class TargetOptional = UseDefaultType, class F>
     constexpr auto transform(F && f) &&
     {
       using U = std::remove_cv_t<std::invoke_result_t<F, PayloadType>>;
@@ -2085,16 +2758,17 @@ namespace impl
           std::is_object_v<U> && !std::is_array_v<U>,
           "The standard requires 'f' to return a non-array object type.");
 
-      // Regarding the return of ::tiny::optional, see first overload.
+      // Regarding the ResultType, see first overload.
+      using ResultType = typename TransformResult<TargetOptional, U>::type;
       if (has_value()) {
-        return ::tiny::optional<U>(DirectInitializationFromFunctionTag{}, std::forward<F>(f), std::move(**this));
+        return ResultType(DirectInitializationFromFunctionTag{}, std::forward<F>(f), std::move(**this));
       }
       else {
-        return ::tiny::optional<U>();
+        return ResultType();
       }
     }
 
-    template <class F>
+    template <class TargetOptional = UseDefaultType, class F>
     constexpr auto transform(F && f) const &&
     {
       using U = std::remove_cv_t<std::invoke_result_t<F, PayloadType const>>;
@@ -2105,12 +2779,13 @@ namespace impl
           std::is_object_v<U> && !std::is_array_v<U>,
           "The standard requires 'f' to return a non-array object type.");
 
-      // Regarding the return of ::tiny::optional, see first overload.
+      // Regarding the ResultType, see first overload.
+      using ResultType = typename TransformResult<TargetOptional, U>::type;
       if (has_value()) {
-        return ::tiny::optional<U>(DirectInitializationFromFunctionTag{}, std::forward<F>(f), std::move(**this));
+        return ResultType(DirectInitializationFromFunctionTag{}, std::forward<F>(f), std::move(**this));
       }
       else {
-        return ::tiny::optional<U>();
+        return ResultType();
       }
     }
 
@@ -2147,7 +2822,7 @@ namespace impl
           std::is_move_constructible_v<typename StoredTypeDecomposition::PayloadType> 
           && std::is_swappable_v<typename StoredTypeDecomposition::PayloadType>,
         int> = 0>
-  void swap(
+  TINY_OPTIONAL_CONSTEXPR void swap(
       TinyOptionalImpl<StoredTypeDecomposition, FlagManipulator> & lhs,
       TinyOptionalImpl<StoredTypeDecomposition, FlagManipulator> & rhs) 
     noexcept(noexcept(lhs.swap(rhs)))
@@ -2532,7 +3207,7 @@ public:
   using Base::value_or;
 
 
-  optional & operator=(std::nullopt_t) noexcept
+  TINY_OPTIONAL_CONSTEXPR optional & operator=(std::nullopt_t) noexcept
   {
     Base::operator=(std::nullopt);
     return *this;
@@ -2542,13 +3217,23 @@ public:
   template <
       class U = PayloadType_,
       std::enable_if_t<Base::template EnableConvertingAssignment<optional, U>::value, int> = 0>
-  optional & operator=(U && v)
+  TINY_OPTIONAL_CONSTEXPR optional & operator=(U && v)
   {
     Base::operator=(std::forward<U>(v));
     return *this;
   }
 
 
+  template <
+      class OtherOptional,
+      std::enable_if_t<Base::template EnableConvertingAssignmentFromOptional<optional, OtherOptional>::value, int> = 0>
+  TINY_OPTIONAL_CONSTEXPR optional & operator=(OtherOptional && other)
+  {
+    Base::operator=(std::forward<OtherOptional>(other));
+    return *this;
+  }
+
+
 #ifdef TINY_OPTIONAL_ENABLE_ORELSE
   template <class F>
     requires(std::invocable<F> && std::copy_constructible<value_type>)
@@ -2579,8 +3264,8 @@ optional(T) -> optional<T, UseDefaultValue, UseDefaultValue>;
 
 
 template <class PayloadType, auto sentinelOrMemPtr = UseDefaultValue, auto irrelevantOrSentinel = UseDefaultValue>
-[[nodiscard]] optional<std::decay_t<PayloadType>, sentinelOrMemPtr, irrelevantOrSentinel> make_optional(
-    PayloadType && v)
+[[nodiscard]] TINY_OPTIONAL_CONSTEXPR optional<std::decay_t<PayloadType>, sentinelOrMemPtr, irrelevantOrSentinel>
+    make_optional(PayloadType && v)
 {
   return optional<std::decay_t<PayloadType>, sentinelOrMemPtr, irrelevantOrSentinel>{std::forward<PayloadType>(v)};
 }
@@ -2591,7 +3276,8 @@ template <
     auto sentinelOrMemPtr = UseDefaultValue,
     auto irrelevantOrSentinel = UseDefaultValue,
     class... ArgsT>
-[[nodiscard]] optional<PayloadType, sentinelOrMemPtr, irrelevantOrSentinel> make_optional(ArgsT &&... args)
+[[nodiscard]] TINY_OPTIONAL_CONSTEXPR optional<PayloadType, sentinelOrMemPtr, irrelevantOrSentinel>
+    make_optional(ArgsT &&... args)
 {
   return optional<PayloadType, sentinelOrMemPtr, irrelevantOrSentinel>{std::in_place, std::forward<ArgsT>(args)...};
 }
@@ -2603,9 +3289,8 @@ template <
     auto irrelevantOrSentinel = UseDefaultValue,
     class U,
     class... ArgsT>
-[[nodiscard]] optional<PayloadType, sentinelOrMemPtr, irrelevantOrSentinel> make_optional(
-    std::initializer_list<U> il,
-    ArgsT &&... args)
+[[nodiscard]] TINY_OPTIONAL_CONSTEXPR optional<PayloadType, sentinelOrMemPtr, irrelevantOrSentinel>
+    make_optional(std::initializer_list<U> il, ArgsT &&... args)
 {
   return optional<PayloadType, sentinelOrMemPtr, irrelevantOrSentinel>{std::in_place, il, std::forward<ArgsT>(args)...};
 }
@@ -2687,6 +3372,321 @@ template <class PayloadType, auto sentinelValue = impl::SelectSentinelValueWithS
 using optional_aip = optional<PayloadType, sentinelValue>;
 
 
+namespace impl
+{
+  template <class U>
+  struct TransformResult<UseOptionalAip, U>
+  {
+    using type = optional_aip<U>;
+  };
+} // namespace impl
+
+
+//====================================================================================
+// Sentinel layout introspection
+//====================================================================================
+
+namespace impl
+{
+  template <class StoredTypeDecomposition_, class FlagManipulator_>
+  struct TinyOptionalImplArgs
+  {
+    using StoredTypeDecomposition = StoredTypeDecomposition_;
+    using FlagManipulator = FlagManipulator_;
+  };
+
+  // Only used in unevaluated contexts to recover the template arguments of the TinyOptionalImpl that some tiny optional
+  // type is (optional_sentinel_via_type, optional_inplace) or derives from (optional, optional_aip).
+  template <class StoredTypeDecomposition, class FlagManipulator>
+  TinyOptionalImplArgs<StoredTypeDecomposition, FlagManipulator>
+      DeduceTinyOptionalImplArgs(TinyOptionalImpl<StoredTypeDecomposition, FlagManipulator> const *)
+  {
+    return {};
+  }
+
+  template <class TinyOptionalType>
+  using TinyOptionalImplArgsOf
+      = decltype(DeduceTinyOptionalImplArgs(static_cast<std::remove_cv_t<TinyOptionalType> const *>(nullptr)));
+
+
+  // Describes the sentinel used by one of the library's own flag manipulators that compare the flag against a
+  // compile-time constant. Other flag manipulators (custom ones or the SeparateFlagManipulator) are opaque.
+  template <class FlagType_, class SentinelValue_, bool comparesRawBits_>
+  struct KnownSentinelInfo
+  {
+    static constexpr bool isKnown = true;
+    using FlagType = FlagType_;
+    using SentinelValue = SentinelValue_;
+    // True if the flag is compared 'raw' (MemcpyAndCmpFlagManipulator), false if via operator== of the flag type.
+    static constexpr bool comparesRawBits = comparesRawBits_;
+  };
+
+  struct UnknownSentinelInfo
+  {
+    static constexpr bool isKnown = false;
+  };
+
+  // Overloads to figure out from which library flag manipulator a given FlagManipulator derives (if any). This also
+  // catches e.g. optional_flag_manipulator<double>, which derives from MemcpyAndCmpFlagManipulator.
+  template <class FlagType, class SentinelValue>
+  KnownSentinelInfo<FlagType, SentinelValue, true>
+      DeduceKnownSentinelInfo(MemcpyAndCmpFlagManipulator<FlagType, SentinelValue> const *)
+  {
+    return {};
+  }
+
+  template <class FlagType, class SentinelValue>
+  KnownSentinelInfo<FlagType, SentinelValue, false>
+      DeduceKnownSentinelInfo(AssignmentFlagManipulator<FlagType, SentinelValue> const *)
+  {
+    return {};
+  }
+
+  inline UnknownSentinelInfo DeduceKnownSentinelInfo(void const *)
+  {
+    return {};
+  }
+
+
+  // Properties of the memory layout of some tiny optional type, for utilities that want to work on the raw storage of
+  // optionals (e.g. to view a plain array of payloads as an array of optionals).
+  template <class TinyOptionalType>
+  struct SentinelLayoutTraits
+  {
+    using ImplArgs = TinyOptionalImplArgsOf<TinyOptionalType>;
+    using StoredTypeDecomposition = typename ImplArgs::StoredTypeDecomposition;
+    using FlagManipulator = typename ImplArgs::FlagManipulator;
+    using PayloadType = typename StoredTypeDecomposition::PayloadType;
+
+    using SentinelInfo = decltype(DeduceKnownSentinelInfo(static_cast<FlagManipulator const *>(nullptr)));
+
+    // True if the optional stores nothing but the payload, and the empty state is the payload (or a member of it)
+    // holding a compile-time known sentinel value.
+    static constexpr bool isPayloadWithKnownSentinel
+        = std::is_same_v<typename StoredTypeDecomposition::StoredType, InplaceStorage<PayloadType>>
+          && SentinelInfo::isKnown;
+
+    // True if additionally the whole payload (rather than some member of it) is the 'IsEmpty'-flag.
+    static constexpr bool isWholePayloadTheFlag
+        = isPayloadWithKnownSentinel
+          && std::is_same_v<StoredTypeDecomposition, InplaceStoredTypeDecomposition<PayloadType>>;
+  };
+
+
+  // True if the optional is just an integer whose sentinel is the smallest or largest value of the integer type. Then
+  // the order "empty < any value" can be obtained from the payload bits alone, without checking has_value() first.
+  // Examples: optional<unsigned, UINT_MAX>, optional<int, INT_MIN> or optional_aip<int>.
+  template <class TinyOptionalType>
+  constexpr bool HasSentinelAtEndOfIntegerRange()
+  {
+    using LayoutTraits = SentinelLayoutTraits<TinyOptionalType>;
+    if constexpr (LayoutTraits::isWholePayloadTheFlag) {
+      using P = std::remove_cv_t<typename LayoutTraits::PayloadType>;
+      if constexpr (
+          std::is_integral_v<P> && !std::is_same_v<P, bool>
+          && !std::is_volatile_v<typename LayoutTraits::PayloadType>) {
+        constexpr P sentinel = static_cast<P>(LayoutTraits::SentinelInfo::SentinelValue::value);
+        return sentinel == (std::numeric_limits<P>::min)() || sentinel == (std::numeric_limits<P>::max)();
+      }
+    }
+    return false;
+  }
+
+
+  // For optionals with HasSentinelAtEndOfIntegerRange(): Maps the optional to an unsigned integer such that comparing
+  // the keys gives the same result as comparing the optionals. Signed payloads are biased by flipping the sign bit, and
+  // then the sentinel is rotated to 0. So the empty state maps to 0 and all values keep their order.
+  template <class TinyOptionalType>
+  struct BiasedOrderKey
+  {
+    using PayloadType = std::remove_cv_t<typename SentinelLayoutTraits<TinyOptionalType>::PayloadType>;
+    using Key = typename UnsignedIntegerOfSize<sizeof(PayloadType)>::type;
+
+    [[nodiscard]] static constexpr Key ToOrderedUnsigned(PayloadType value) noexcept
+    {
+      Key const bits = static_cast<Key>(value);
+      if constexpr (std::is_signed_v<PayloadType>) {
+        return static_cast<Key>(bits ^ static_cast<Key>(Key{1} << (sizeof(Key) * CHAR_BIT - 1)));
+      }
+      else {
+        return bits;
+      }
+    }
+
+    static constexpr Key sentinelKey = ToOrderedUnsigned(static_cast<PayloadType>(
+        SentinelLayoutTraits<TinyOptionalType>::SentinelInfo::SentinelValue::value));
+
+    [[nodiscard]] TINY_OPTIONAL_IMPL_FORCE_INLINE static TINY_OPTIONAL_CONSTEXPR Key Get(
+        TinyOptionalType const & o) noexcept
+    {
+      static_assert(HasSentinelAtEndOfIntegerRange<TinyOptionalType>());
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+      if (std::is_constant_evaluated()) {
+        return o.has_value() ? static_cast<Key>(ToOrderedUnsigned(*o) - sentinelKey) : Key{0};
+      }
+#endif
+      // The optional consists of nothing but the payload, which holds the sentinel if the optional is empty.
+      PayloadType payload;
+      TINY_OPTIONAL_IMPL_MEMCPY(&payload, TINY_OPTIONAL_IMPL_ADDRESSOF(o), sizeof(PayloadType));
+      return static_cast<Key>(ToOrderedUnsigned(payload) - sentinelKey);
+    }
+  };
+} // namespace impl
+
+
+//====================================================================================
+// Conversions between optionals
+//====================================================================================
+
+namespace impl
+{
+  template <class T>
+  inline constexpr bool IsPlainInteger
+      = std::is_integral_v<T> && !std::is_same_v<T, bool> && std::is_same_v<T, std::remove_cv_t<T>>;
+
+
+  template <class Target, class Source>
+  constexpr bool IsBitwiseOptionalConversion()
+  {
+    if constexpr (is_tiny_optional_v<Target> && is_tiny_optional_v<Source>) {
+      using TargetTraits = SentinelLayoutTraits<Target>;
+      using SourceTraits = SentinelLayoutTraits<Source>;
+      if constexpr (TargetTraits::isWholePayloadTheFlag && SourceTraits::isWholePayloadTheFlag) {
+        using T = typename TargetTraits::PayloadType;
+        using S = typename SourceTraits::PayloadType;
+        if constexpr (
+            IsPlainInteger<T> && IsPlainInteger<S> && !TargetTraits::SentinelInfo::comparesRawBits
+            && !SourceTraits::SentinelInfo::comparesRawBits) {
+          // Every value of S must be representable as T, so that no value of the source turns into the sentinel of
+          // the target except for the sentinel of the source.
+          constexpr bool isValuePreserving
+              = (std::is_signed_v<T> == std::is_signed_v<S> && sizeof(T) >= sizeof(S))
+                || (std::is_signed_v<T> && std::is_unsigned_v<S> && sizeof(T) > sizeof(S));
+          constexpr S sourceSentinel = static_cast<S>(SourceTraits::SentinelInfo::SentinelValue::value);
+          constexpr T targetSentinel = static_cast<T>(TargetTraits::SentinelInfo::SentinelValue::value);
+          return isValuePreserving && static_cast<T>(sourceSentinel) == targetSentinel;
+        }
+      }
+    }
+    return false;
+  }
+} // namespace impl
+
+
+// Converts the given tiny optional or std::optional into the TargetOptional (some tiny optional or std::optional).
+// The 'policy' defines what happens if the value in the source is the sentinel of the target.
+// If both are integers with a sentinel, and the sentinel of the source converts to the sentinel of the target (e.g.
+// from optional<int, -1> to optional<long long, -1>, or from optional<std::uint16_t, 0> to optional<unsigned, 0>), the
+// conversion is a single conversion of the payload bits without any check.
+template <
+    class TargetOptional,
+    sentinel_collision policy = sentinel_collision::assert_not_sentinel,
+    class SourceOptional>
+[[nodiscard]] TINY_OPTIONAL_CONSTEXPR TargetOptional optional_cast(SourceOptional && source)
+{
+  using Source = impl::my_remove_cvref_t<SourceOptional>;
+  static_assert(impl::IsSomeOptional<Source>, "optional_cast: The source must be a tiny optional or a std::optional.");
+  static_assert(
+      impl::IsSomeOptional<TargetOptional>, "optional_cast: The target must be a tiny optional or a std::optional.");
+
+  if constexpr (std::is_same_v<Source, TargetOptional>) {
+    return std::forward<SourceOptional>(source);
+  }
+  else if constexpr (is_tiny_optional_v<TargetOptional>) {
+    return TargetOptional(impl::ConvertFromOptionalTag<policy>{}, std::forward<SourceOptional>(source));
+  }
+  else {
+    // A std::optional has no sentinel.
+    if (source.has_value()) {
+      return TargetOptional(std::in_place, *std::forward<SourceOptional>(source));
+    }
+    return TargetOptional();
+  }
+}
+
+
+// Assigns the given tiny optional or std::optional to the 'target' (some tiny optional or std::optional). In
+// analogy to optional_cast(), but reuses the payload of the target if both contain a value.
+template <
+    sentinel_collision policy = sentinel_collision::assert_not_sentinel,
+    class TargetOptional,
+    class SourceOptional>
+TINY_OPTIONAL_CONSTEXPR TargetOptional & assign_optional(TargetOptional & target, SourceOptional && source)
+{
+  using Source = impl::my_remove_cvref_t<SourceOptional>;
+  static_assert(
+      impl::IsSomeOptional<Source>, "assign_optional: The source must be a tiny optional or a std::optional.");
+  static_assert(
+      impl::IsSomeOptional<TargetOptional>, "assign_optional: The target must be a tiny optional or a std::optional.");
+
+  if constexpr (std::is_same_v<Source, TargetOptional>) {
+    target = std::forward<SourceOptional>(source);
+  }
+  else if constexpr (is_tiny_optional_v<TargetOptional>) {
+    target.template AssignFromOptional<policy>(std::forward<SourceOptional>(source));
+  }
+  else {
+    if (source.has_value()) {
+      target = *std::forward<SourceOptional>(source);
+    }
+    else {
+      target.reset();
+    }
+  }
+  return target;
+}
+
+
+//====================================================================================
+// optional_with_hint
+//====================================================================================
+
+namespace impl
+{
+  // Adds the emptiness_hint to some FlagManipulator. Deriving from it keeps e.g. SentinelLayoutTraits working.
+  template <class FlagManipulator, emptiness_hint hint>
+  struct HintedFlagManipulator : FlagManipulator
+  {
+    static constexpr emptiness_hint emptinessHint = hint;
+  };
+
+  template <class FlagManipulator, emptiness_hint hint>
+  struct WithEmptinessHint
+  {
+    using type = HintedFlagManipulator<FlagManipulator, hint>;
+  };
+
+  // Replace rather than nest an existing hint.
+  template <class FlagManipulator, emptiness_hint oldHint, emptiness_hint hint>
+  struct WithEmptinessHint<HintedFlagManipulator<FlagManipulator, oldHint>, hint>
+    : WithEmptinessHint<FlagManipulator, hint>
+  {
+  };
+
+  template <class FlagManipulator>
+  struct WithEmptinessHint<FlagManipulator, emptiness_hint::none>
+  {
+    using type = FlagManipulator;
+  };
+
+  template <class FlagManipulator, emptiness_hint oldHint>
+  struct WithEmptinessHint<HintedFlagManipulator<FlagManipulator, oldHint>, emptiness_hint::none>
+  {
+    using type = FlagManipulator;
+  };
+} // namespace impl
+
+
+// The same as the given tiny optional type (e.g. tiny::optional<int, -1> or tiny::optional_aip<unsigned>), but every
+// check whether the optional is empty tells the compiler whether this is expected to be rarely or mostly the case. The
+// compiler then moves the unexpected branch out of the hot path. It has the same memory layout as the original type.
+template <class TinyOptionalType, emptiness_hint hint>
+using optional_with_hint = impl::TinyOptionalImpl<
+    typename impl::TinyOptionalImplArgsOf<TinyOptionalType>::StoredTypeDecomposition,
+    typename impl::WithEmptinessHint<typename impl::TinyOptionalImplArgsOf<TinyOptionalType>::FlagManipulator, hint>::
+        type>;
+
+
 //====================================================================================
 // Comparison operators
 //====================================================================================
@@ -2696,37 +3696,53 @@ using optional_aip = optional<PayloadType, sentinelValue>;
 // are not sufficient. Without them, a comparison of tiny::optional and std::optional would select the standard operator
 // that compares a std::optional with any value U.
 // I guess, the amount of copy & paste code justifies a macro here.
+// For two optionals of the same type whose sentinel is at one end of the integer range, the macro additionally defines a
+// branch-free overload that compares the biased payload bits (see BiasedOrderKey). Being more specialized, it is also
+// preferred over operator<=> in C++20.
 // clang-format off
 #define TINY_OPTIONAL_IMPL_COMPARE_BETWEEN_OPTIONALS(Op, code)                                                           \
   namespace impl                                                                                                         \
   {                                                                                                                      \
     template <class D1, class F1, class D2, class F2>                                                                    \
-    [[nodiscard]] bool operator Op(TinyOptionalImpl<D1, F1> const & lhs, TinyOptionalImpl<D2, F2> const & rhs)           \
+    [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator Op(                                                              \
+        TinyOptionalImpl<D1, F1> const & lhs, TinyOptionalImpl<D2, F2> const & rhs)                                      \
     {                                                                                                                    \
       code                                                                                                               \
     }                                                                                                                    \
                                                                                                                          \
+    template <class D, class F>                                                                                          \
+    [[nodiscard]] TINY_OPTIONAL_CONSTEXPR                                                                                \
+        std::enable_if_t<HasSentinelAtEndOfIntegerRange<TinyOptionalImpl<D, F>>(), bool>                                 \
+        operator Op(TinyOptionalImpl<D, F> const & lhs, TinyOptionalImpl<D, F> const & rhs) noexcept                     \
+    {                                                                                                                    \
+      return BiasedOrderKey<TinyOptionalImpl<D, F>>::Get(lhs) Op BiasedOrderKey<TinyOptionalImpl<D, F>>::Get(rhs);       \
+    }                                                                                                                    \
+                                                                                                                         \
     template <class D1, class F1, class U>                                                                               \
-    [[nodiscard]] bool operator Op(TinyOptionalImpl<D1, F1> const & lhs, std::optional<U> const & rhs)                   \
+    [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator Op(                                                              \
+        TinyOptionalImpl<D1, F1> const & lhs, std::optional<U> const & rhs)                                              \
     {                                                                                                                    \
       code                                                                                                               \
     }                                                                                                                    \
                                                                                                                          \
     template <class U, class D1, class F1>                                                                               \
-    [[nodiscard]] bool operator Op(std::optional<U> const & lhs, TinyOptionalImpl<D1, F1> const & rhs)                   \
+    [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator Op(                                                              \
+        std::optional<U> const & lhs, TinyOptionalImpl<D1, F1> const & rhs)                                              \
     {                                                                                                                    \
       code                                                                                                               \
     }                                                                                                                    \
   }                                                                                                                      \
                                                                                                                          \
   template <class P, auto e, auto i, class U>                                                                            \
-  [[nodiscard]] bool operator Op(optional<P, e, i> const & lhs, std::optional<U> const & rhs)                            \
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator Op(                                                                \
+      optional<P, e, i> const & lhs, std::optional<U> const & rhs)                                                       \
   {                                                                                                                      \
     code                                                                                                                 \
   }                                                                                                                      \
                                                                                                                          \
   template <class U, class P, auto e, auto i>                                                                            \
-  [[nodiscard]] bool operator Op(std::optional<U> const & lhs, optional<P, e, i> const & rhs)                            \
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator Op(                                                                \
+      std::optional<U> const & lhs, optional<P, e, i> const & rhs)                                                       \
   {                                                                                                                      \
     code                                                                                                                 \
   }
@@ -2746,21 +3762,21 @@ TINY_OPTIONAL_IMPL_COMPARE_BETWEEN_OPTIONALS(
 namespace impl
 {
   template <class D1, class F1>
-  [[nodiscard]] bool operator==(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator==(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
   {
     return !lhs.has_value();
   }
 
 #if !defined(TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON) || defined(TINY_OPTIONAL_GCC_WORKAROUND_CWG2445)
   template <class D1, class F1>
-  [[nodiscard]] bool operator==(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator==(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
   {
     return !rhs.has_value();
   }
 #endif
 
   template <class D1, class F1, class U>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator==(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator==(
       TinyOptionalImpl<D1, F1> const & lhs,
       U const & rhs)
   {
@@ -2768,7 +3784,7 @@ namespace impl
   }
 
   template <class U, class D1, class F1>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator==(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator==(
       U const & lhs,
       TinyOptionalImpl<D1, F1> const & rhs)
   {
@@ -2792,20 +3808,20 @@ namespace impl
 {
 #if !defined(TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON) || defined(TINY_OPTIONAL_GCC_WORKAROUND_CWG2445)
   template <class D1, class F1>
-  [[nodiscard]] bool operator!=(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator!=(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
   {
     return lhs.has_value();
   }
 
   template <class D1, class F1>
-  [[nodiscard]] bool operator!=(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator!=(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
   {
     return rhs.has_value();
   }
 #endif
 
   template <class D1, class F1, class U>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator!=(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator!=(
       TinyOptionalImpl<D1, F1> const & lhs,
       U const & rhs)
   {
@@ -2813,7 +3829,7 @@ namespace impl
   }
 
   template <class U, class D1, class F1>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator!=(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator!=(
       U const & lhs,
       TinyOptionalImpl<D1, F1> const & rhs)
   {
@@ -2836,20 +3852,20 @@ namespace impl
 {
 #if !defined(TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON) || defined(TINY_OPTIONAL_GCC_WORKAROUND_CWG2445)
   template <class D1, class F1>
-  [[nodiscard]] bool operator<(TinyOptionalImpl<D1, F1> const &, std::nullopt_t) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator<(TinyOptionalImpl<D1, F1> const &, std::nullopt_t) noexcept
   {
     return false;
   }
 
   template <class D1, class F1>
-  [[nodiscard]] bool operator<(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator<(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
   {
     return rhs.has_value();
   }
 #endif
 
   template <class D1, class F1, class U>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<(
       TinyOptionalImpl<D1, F1> const & lhs,
       U const & rhs)
   {
@@ -2857,7 +3873,7 @@ namespace impl
   }
 
   template <class U, class D1, class F1>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<(
       U const & lhs,
       TinyOptionalImpl<D1, F1> const & rhs)
   {
@@ -2880,20 +3896,20 @@ namespace impl
 {
 #if !defined(TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON) || defined(TINY_OPTIONAL_GCC_WORKAROUND_CWG2445)
   template <class D1, class F1>
-  [[nodiscard]] bool operator<=(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator<=(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
   {
     return !lhs.has_value();
   }
 
   template <class D1, class F1>
-  [[nodiscard]] bool operator<=(std::nullopt_t, TinyOptionalImpl<D1, F1> const &) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator<=(std::nullopt_t, TinyOptionalImpl<D1, F1> const &) noexcept
   {
     return true;
   }
 #endif
 
   template <class D1, class F1, class U>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<=(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<=(
       TinyOptionalImpl<D1, F1> const & lhs,
       U const & rhs)
   {
@@ -2901,7 +3917,7 @@ namespace impl
   }
 
   template <class U, class D1, class F1>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<=(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator<=(
       U const & lhs,
       TinyOptionalImpl<D1, F1> const & rhs)
   {
@@ -2924,20 +3940,20 @@ namespace impl
 {
 #if !defined(TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON) || defined(TINY_OPTIONAL_GCC_WORKAROUND_CWG2445)
   template <class D1, class F1>
-  [[nodiscard]] bool operator>(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator>(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
   {
     return lhs.has_value();
   }
 
   template <class D1, class F1>
-  [[nodiscard]] bool operator>(std::nullopt_t, TinyOptionalImpl<D1, F1> const &) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator>(std::nullopt_t, TinyOptionalImpl<D1, F1> const &) noexcept
   {
     return false;
   }
 #endif
 
   template <class D1, class F1, class U>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>(
       TinyOptionalImpl<D1, F1> const & lhs,
       U const & rhs)
   {
@@ -2945,7 +3961,7 @@ namespace impl
   }
 
   template <class U, class D1, class F1>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>(
       U const & lhs,
       TinyOptionalImpl<D1, F1> const & rhs)
   {
@@ -2968,20 +3984,20 @@ namespace impl
 {
 #if !defined(TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON) || defined(TINY_OPTIONAL_GCC_WORKAROUND_CWG2445)
   template <class D1, class F1>
-  [[nodiscard]] bool operator>=(TinyOptionalImpl<D1, F1> const &, std::nullopt_t) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator>=(TinyOptionalImpl<D1, F1> const &, std::nullopt_t) noexcept
   {
     return true;
   }
 
   template <class D1, class F1>
-  [[nodiscard]] bool operator>=(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR bool operator>=(std::nullopt_t, TinyOptionalImpl<D1, F1> const & rhs) noexcept
   {
     return !rhs.has_value();
   }
 #endif
 
   template <class D1, class F1, class U>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>=(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>=(
       TinyOptionalImpl<D1, F1> const & lhs,
       U const & rhs)
   {
@@ -2989,7 +4005,7 @@ namespace impl
   }
 
   template <class U, class D1, class F1>
-  [[nodiscard]] std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>=(
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::enable_if_t<!is_tiny_optional_v<U>, bool> operator>=(
       U const & lhs,
       TinyOptionalImpl<D1, F1> const & rhs)
   {
@@ -3013,23 +4029,29 @@ namespace impl
   [[nodiscard]] std::compare_three_way_result_t<
       typename TinyOptionalImpl<D1, F1>::value_type,
       typename TinyOptionalImpl<D2, F2>::value_type>
-      operator<=>(TinyOptionalImpl<D1, F1> const & lhs, TinyOptionalImpl<D2, F2> const & rhs)
+      TINY_OPTIONAL_CONSTEXPR operator<=>(TinyOptionalImpl<D1, F1> const & lhs, TinyOptionalImpl<D2, F2> const & rhs)
   {
-    return (lhs && rhs) ? (*lhs <=> *rhs) : (lhs.has_value() <=> rhs.has_value());
+    using LhsType = TinyOptionalImpl<D1, F1>;
+    if constexpr (std::is_same_v<LhsType, TinyOptionalImpl<D2, F2>> && HasSentinelAtEndOfIntegerRange<LhsType>()) {
+      return BiasedOrderKey<LhsType>::Get(lhs) <=> BiasedOrderKey<LhsType>::Get(rhs);
+    }
+    else {
+      return (lhs && rhs) ? (*lhs <=> *rhs) : (lhs.has_value() <=> rhs.has_value());
+    }
   }
 
   template <class D1, class F1, class U>
     requires(std::three_way_comparable_with<typename TinyOptionalImpl<D1, F1>::value_type, U>)
-  [[nodiscard]] std::compare_three_way_result_t<typename TinyOptionalImpl<D1, F1>::value_type, U> operator<=>(
-      TinyOptionalImpl<D1, F1> const & lhs,
-      std::optional<U> const & rhs)
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR
+      std::compare_three_way_result_t<typename TinyOptionalImpl<D1, F1>::value_type, U>
+      operator<=>(TinyOptionalImpl<D1, F1> const & lhs, std::optional<U> const & rhs)
   {
     return (lhs && rhs) ? (*lhs <=> *rhs) : (lhs.has_value() <=> rhs.has_value());
   }
 } // namespace impl
 
 template <class P, auto e, auto i, std::three_way_comparable_with<P> U>
-[[nodiscard]] std::compare_three_way_result_t<P, U> operator<=>(
+[[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::compare_three_way_result_t<P, U> operator<=>(
     optional<P, e, i> const & lhs,
     std::optional<U> const & rhs)
 {
@@ -3038,7 +4060,7 @@ template <class P, auto e, auto i, std::three_way_comparable_with<P> U>
 
   #ifdef TINY_OPTIONAL_GCC_WORKAROUND_CWG2445
 template <class U, std::three_way_comparable_with<U> P, auto e, auto i>
-[[nodiscard]] std::compare_three_way_result_t<U, P> operator<=>(
+[[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::compare_three_way_result_t<U, P> operator<=>(
     std::optional<U> const & lhs,
     optional<P, e, i> const & rhs)
 {
@@ -3049,16 +4071,17 @@ template <class U, std::three_way_comparable_with<U> P, auto e, auto i>
 namespace impl
 {
   template <class D1, class F1>
-  [[nodiscard]] std::strong_ordering operator<=>(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR std::strong_ordering
+      operator<=>(TinyOptionalImpl<D1, F1> const & lhs, std::nullopt_t) noexcept
   {
     return lhs.has_value() <=> false;
   }
 
   template <class D1, class F1, class U>
     requires(!is_tiny_optional_v<U> && std::three_way_comparable_with<typename TinyOptionalImpl<D1, F1>::value_type, U>)
-  [[nodiscard]] std::compare_three_way_result_t<typename TinyOptionalImpl<D1, F1>::value_type, U> operator<=>(
-      TinyOptionalImpl<D1, F1> const & lhs,
-      U const & rhs)
+  [[nodiscard]] TINY_OPTIONAL_CONSTEXPR
+      std::compare_three_way_result_t<typename TinyOptionalImpl<D1, F1>::value_type, U>
+      operator<=>(TinyOptionalImpl<D1, F1> const & lhs, U const & rhs)
   {
     return lhs.has_value() ? (*lhs <=> rhs) : std::strong_ordering::less;
   }
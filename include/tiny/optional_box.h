@@ -0,0 +1,807 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "optional.h"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+//====================================================================================
+// box_arena and arena_allocator
+//====================================================================================
+
+// Bump allocator for data that lives as long as some batch (e.g. the rows loaded from a file). Allocation merely
+// advances a pointer within the current block; a new block is requested from the global operator new only when the
+// current one is exhausted. Individual deallocations are no-ops: All memory is freed at once by release() or the
+// destructor. Every object allocated from the arena must have been destroyed before.
+class box_arena
+{
+public:
+  static constexpr std::size_t default_block_size = 64 * 1024;
+
+  explicit box_arena(std::size_t blockSize = default_block_size) noexcept
+    : mBlockSize(blockSize)
+  {
+  }
+
+  box_arena(box_arena const &) = delete;
+  box_arena & operator=(box_arena const &) = delete;
+
+  ~box_arena()
+  {
+    release();
+  }
+
+  // Returns uninitialized memory of 'size' bytes, aligned to 'alignment' (which must be a power of 2).
+  // Throws std::bad_alloc if the memory cannot be allocated.
+  [[nodiscard]] void * allocate(std::size_t size, std::size_t alignment)
+  {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && "The alignment must be a power of 2.");
+    void * result = mCurrent;
+    std::size_t space = mRemaining;
+    if (mCurrent == nullptr || std::align(alignment, size, result, space) == nullptr) {
+      AddBlock(size, alignment);
+      result = mCurrent;
+      space = mRemaining;
+      [[maybe_unused]] void * const aligned = std::align(alignment, size, result, space);
+      assert(aligned != nullptr);
+    }
+
+    mCurrent = static_cast<std::byte *>(result) + size;
+    mRemaining = space - size;
+    mBytesUsed += size;
+    return result;
+  }
+
+  // Frees all blocks at once. Afterwards, the arena can be used again.
+  void release() noexcept
+  {
+    while (mBlocks != nullptr) {
+      BlockHeader * const next = mBlocks->next;
+      ::operator delete(static_cast<void *>(mBlocks));
+      mBlocks = next;
+    }
+    mCurrent = nullptr;
+    mRemaining = 0;
+    mBytesUsed = 0;
+  }
+
+  // The number of bytes handed out by allocate() since construction or the last release(), without alignment padding.
+  [[nodiscard]] std::size_t bytes_used() const noexcept
+  {
+    return mBytesUsed;
+  }
+
+private:
+  // Every block starts with this header, which links the blocks so that release() can free them.
+  struct alignas(std::max_align_t) BlockHeader
+  {
+    BlockHeader * next;
+  };
+
+  void AddBlock(std::size_t size, std::size_t alignment)
+  {
+    // Oversized requests get a block of their own.
+    std::size_t const minUsable = size + alignment;
+    if (minUsable < size || minUsable > std::numeric_limits<std::size_t>::max() - sizeof(BlockHeader)) {
+      throw std::bad_alloc{};
+    }
+    std::size_t const usable = minUsable > mBlockSize ? minUsable : mBlockSize;
+
+    void * const memory = ::operator new(sizeof(BlockHeader) + usable);
+    BlockHeader * const block = ::new (memory) BlockHeader{mBlocks};
+    mBlocks = block;
+    mCurrent = reinterpret_cast<std::byte *>(block + 1);
+    mRemaining = usable;
+  }
+
+  std::size_t mBlockSize;
+  BlockHeader * mBlocks = nullptr;
+  std::byte * mCurrent = nullptr;
+  std::size_t mRemaining = 0;
+  std::size_t mBytesUsed = 0;
+};
+
+
+// Allocator that takes the memory from a box_arena. It merely stores a pointer to the arena, so containers and boxes
+// using it grow by one pointer. A default constructed arena_allocator has no arena and throws std::bad_alloc on every
+// allocation; it exists so that tiny::optional can store an optional_box with this allocator without a separate bool.
+template <class T>
+class arena_allocator
+{
+public:
+  using value_type = T;
+
+  arena_allocator() noexcept = default;
+
+  // Implicit, so that a box_arena can be passed wherever an arena_allocator is expected.
+  arena_allocator(box_arena & arena) noexcept
+    : mArena(&arena)
+  {
+  }
+
+  template <class U>
+  arena_allocator(arena_allocator<U> const & rhs) noexcept
+    : mArena(rhs.arena())
+  {
+  }
+
+  [[nodiscard]] T * allocate(std::size_t n)
+  {
+    if (mArena == nullptr || n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_alloc{};
+    }
+    return static_cast<T *>(mArena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  // The memory is freed by the arena.
+  void deallocate(T *, std::size_t) noexcept { }
+
+  [[nodiscard]] box_arena * arena() const noexcept
+  {
+    return mArena;
+  }
+
+  template <class U>
+  [[nodiscard]] friend bool operator==(arena_allocator const & lhs, arena_allocator<U> const & rhs) noexcept
+  {
+    return lhs.arena() == rhs.arena();
+  }
+
+  template <class U>
+  [[nodiscard]] friend bool operator!=(arena_allocator const & lhs, arena_allocator<U> const & rhs) noexcept
+  {
+    return lhs.arena() != rhs.arena();
+  }
+
+private:
+  box_arena * mArena = nullptr;
+};
+
+
+//====================================================================================
+// optional_box
+//====================================================================================
+
+template <class PayloadType, class Allocator = std::allocator<PayloadType>>
+class optional_box;
+
+
+namespace impl
+{
+  // Stores the allocator of an optional_box. Stateless allocators (such as std::allocator) occupy no memory thanks to
+  // the empty base optimization, so that the optional_box consists of a single pointer.
+  template <class Allocator, bool = std::is_empty_v<Allocator> && !std::is_final_v<Allocator>>
+  class OptionalBoxAllocatorHolder : private Allocator
+  {
+  protected:
+    OptionalBoxAllocatorHolder() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+    template <class A>
+    explicit OptionalBoxAllocatorHolder(A && alloc) noexcept
+      : Allocator(std::forward<A>(alloc))
+    {
+    }
+
+    [[nodiscard]] Allocator & GetAllocator() noexcept
+    {
+      return *this;
+    }
+
+    [[nodiscard]] Allocator const & GetAllocator() const noexcept
+    {
+      return *this;
+    }
+  };
+
+  template <class Allocator>
+  class OptionalBoxAllocatorHolder<Allocator, false>
+  {
+  protected:
+    OptionalBoxAllocatorHolder() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+    template <class A>
+    explicit OptionalBoxAllocatorHolder(A && alloc) noexcept
+      : mAllocator(std::forward<A>(alloc))
+    {
+    }
+
+    [[nodiscard]] Allocator & GetAllocator() noexcept
+    {
+      return mAllocator;
+    }
+
+    [[nodiscard]] Allocator const & GetAllocator() const noexcept
+    {
+      return mAllocator;
+    }
+
+  private:
+    Allocator mAllocator{};
+  };
+
+
+  // The address of this object is used by the optional_flag_manipulator of optional_box to indicate an empty
+  // tiny::optional<optional_box>. No allocator can return it, and it differs from the nullptr of an empty box.
+  template <class PayloadType>
+  struct OptionalBoxSentinel
+  {
+    alignas(PayloadType) static inline unsigned char address[1] = {};
+
+    [[nodiscard]] static PayloadType * Get() noexcept
+    {
+      return reinterpret_cast<PayloadType *>(address);
+    }
+  };
+
+  struct OptionalBoxSentinelTag
+  {
+  };
+
+
+  template <class T>
+  inline constexpr bool IsOptionalBox = false;
+  template <class PayloadType, class Allocator>
+  inline constexpr bool IsOptionalBox<optional_box<PayloadType, Allocator>> = true;
+} // namespace impl
+
+
+// Optional that stores its payload on the heap: It consists of a single pointer (plus the allocator if it is not
+// stateless), and an empty optional_box does not allocate anything. This is the better choice over tiny::optional for
+// large payloads that are mostly empty, since tiny::optional always needs at least sizeof(PayloadType) bytes.
+// Contrary to std::unique_ptr, optional_box has value semantics: Copies are deep copies, and the comparison operators
+// compare the payloads (like the ones of tiny::optional). A moved-from optional_box is empty.
+// The Allocator decides where the payload lives. For example, arena_allocator puts it into a box_arena.
+template <class PayloadType, class Allocator>
+class optional_box : private impl::OptionalBoxAllocatorHolder<Allocator>
+{
+  static_assert(
+      std::is_object_v<PayloadType> && std::is_destructible_v<PayloadType> && !std::is_array_v<PayloadType>,
+      "optional_box: The payload type must meet the C++ requirement 'Destructible'.");
+  static_assert(
+      !std::is_same_v<std::remove_cv_t<PayloadType>, std::in_place_t>
+          && !std::is_same_v<std::remove_cv_t<PayloadType>, std::nullopt_t>,
+      "optional_box: The payload type must not be std::in_place_t or std::nullopt_t.");
+  static_assert(
+      std::is_same_v<typename std::allocator_traits<Allocator>::value_type, PayloadType>,
+      "optional_box: The value_type of the allocator must be the payload type.");
+  static_assert(
+      std::is_same_v<typename std::allocator_traits<Allocator>::pointer, PayloadType *>,
+      "optional_box: Allocators with fancy pointers are not supported.");
+
+private:
+  using AllocHolder = impl::OptionalBoxAllocatorHolder<Allocator>;
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  template <class U>
+  static constexpr bool IsConstructibleFromValue = std::is_constructible_v<PayloadType, U &&>
+      && !std::is_same_v<impl::my_remove_cvref_t<U>, std::in_place_t>
+      && !std::is_same_v<impl::my_remove_cvref_t<U>, std::allocator_arg_t>
+      && !std::is_same_v<impl::my_remove_cvref_t<U>, std::nullopt_t>
+      && !impl::IsOptionalBox<impl::my_remove_cvref_t<U>>;
+
+public:
+  using value_type = PayloadType;
+  using allocator_type = Allocator;
+
+
+  optional_box() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+  optional_box(std::nullopt_t) noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+    : optional_box()
+  {
+  }
+
+  explicit optional_box(Allocator const & alloc) noexcept
+    : AllocHolder(alloc)
+  {
+  }
+
+  template <class... ArgsT>
+  explicit optional_box(std::in_place_t, ArgsT &&... args)
+    : AllocHolder()
+    , mPtr(Create(std::forward<ArgsT>(args)...))
+  {
+  }
+
+  template <class U, class... ArgsT>
+  explicit optional_box(std::in_place_t, std::initializer_list<U> ilist, ArgsT &&... args)
+    : AllocHolder()
+    , mPtr(Create(ilist, std::forward<ArgsT>(args)...))
+  {
+  }
+
+  template <class... ArgsT>
+  optional_box(std::allocator_arg_t, Allocator const & alloc, std::in_place_t, ArgsT &&... args)
+    : AllocHolder(alloc)
+    , mPtr(Create(std::forward<ArgsT>(args)...))
+  {
+  }
+
+  template <
+      class U = PayloadType,
+      std::enable_if_t<IsConstructibleFromValue<U> && std::is_convertible_v<U &&, PayloadType>, int> = 0>
+  optional_box(U && v)
+    : AllocHolder()
+    , mPtr(Create(std::forward<U>(v)))
+  {
+  }
+
+  template <
+      class U = PayloadType,
+      std::enable_if_t<IsConstructibleFromValue<U> && !std::is_convertible_v<U &&, PayloadType>, int> = 0>
+  explicit optional_box(U && v)
+    : AllocHolder()
+    , mPtr(Create(std::forward<U>(v)))
+  {
+  }
+
+  // Deep copy. The allocator is selected as for the standard containers.
+  optional_box(optional_box const & rhs)
+    : AllocHolder(AllocTraits::select_on_container_copy_construction(rhs.GetAllocator()))
+    , mPtr(rhs.mPtr != nullptr ? Create(*rhs.mPtr) : nullptr)
+  {
+  }
+
+  // Takes over the allocation of 'rhs', which is empty afterwards.
+  optional_box(optional_box && rhs) noexcept
+    : AllocHolder(std::move(rhs.GetAllocator()))
+    , mPtr(std::exchange(rhs.mPtr, nullptr))
+  {
+  }
+
+  ~optional_box()
+  {
+    reset();
+  }
+
+
+  optional_box & operator=(std::nullopt_t) noexcept
+  {
+    reset();
+    return *this;
+  }
+
+  // If both contain a value, the payload is copy assigned, reusing the allocation.
+  optional_box & operator=(optional_box const & rhs)
+  {
+    if (this == &rhs) {
+      return *this;
+    }
+    if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+      if (GetAllocator() != rhs.GetAllocator()) {
+        reset();
+      }
+      GetAllocator() = rhs.GetAllocator();
+    }
+
+    if (rhs.mPtr != nullptr) {
+      AssignValue(*rhs.mPtr);
+    }
+    else {
+      reset();
+    }
+    return *this;
+  }
+
+  // Takes over the allocation of 'rhs' if the allocators allow it. Otherwise, the payload is moved into memory from
+  // the allocator of this box. In both cases 'rhs' is empty afterwards.
+  optional_box & operator=(optional_box && rhs) noexcept(
+      AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+  {
+    if (this == &rhs) {
+      return *this;
+    }
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+      reset();
+      GetAllocator() = std::move(rhs.GetAllocator());
+      mPtr = std::exchange(rhs.mPtr, nullptr);
+    }
+    else if constexpr (AllocTraits::is_always_equal::value) {
+      reset();
+      mPtr = std::exchange(rhs.mPtr, nullptr);
+    }
+    else {
+      if (GetAllocator() == rhs.GetAllocator()) {
+        reset();
+        mPtr = std::exchange(rhs.mPtr, nullptr);
+      }
+      else if (rhs.mPtr != nullptr) {
+        AssignValue(std::move(*rhs.mPtr));
+        rhs.reset();
+      }
+      else {
+        reset();
+      }
+    }
+    return *this;
+  }
+
+  template <
+      class U = PayloadType,
+      std::enable_if_t<IsConstructibleFromValue<U> && std::is_assignable_v<PayloadType &, U &&>, int> = 0>
+  optional_box & operator=(U && v)
+  {
+    AssignValue(std::forward<U>(v));
+    return *this;
+  }
+
+
+  // Reuses the allocation if the box already contains a value.
+  template <class... ArgsT>
+  PayloadType & emplace(ArgsT &&... args)
+  {
+    return EmplaceImpl(std::forward<ArgsT>(args)...);
+  }
+
+  template <class U, class... ArgsT>
+  PayloadType & emplace(std::initializer_list<U> ilist, ArgsT &&... args)
+  {
+    return EmplaceImpl(ilist, std::forward<ArgsT>(args)...);
+  }
+
+  // Destroys the payload and frees its memory.
+  void reset() noexcept
+  {
+    if (mPtr != nullptr) {
+      AllocTraits::destroy(GetAllocator(), mPtr);
+      AllocTraits::deallocate(GetAllocator(), std::exchange(mPtr, nullptr), 1);
+    }
+  }
+
+  // Swaps the pointers. As for the standard containers, the allocators must compare equal unless they propagate on
+  // swap.
+  void swap(optional_box & rhs) noexcept
+  {
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(GetAllocator(), rhs.GetAllocator());
+    }
+    else {
+      assert(
+          GetAllocator() == rhs.GetAllocator()
+          && "optional_box::swap() requires equal allocators if they do not propagate on swap.");
+    }
+    std::swap(mPtr, rhs.mPtr);
+  }
+
+
+  [[nodiscard]] bool has_value() const noexcept
+  {
+    return mPtr != nullptr;
+  }
+
+  [[nodiscard]] explicit operator bool() const noexcept
+  {
+    return has_value();
+  }
+
+  [[nodiscard]] PayloadType * operator->() noexcept
+  {
+    assert(has_value() && "operator->() called on an empty optional_box");
+    return mPtr;
+  }
+
+  [[nodiscard]] PayloadType const * operator->() const noexcept
+  {
+    assert(has_value() && "operator->() called on an empty optional_box");
+    return mPtr;
+  }
+
+  [[nodiscard]] PayloadType & operator*() & noexcept
+  {
+    assert(has_value() && "operator*() called on an empty optional_box");
+    return *mPtr;
+  }
+
+  [[nodiscard]] PayloadType const & operator*() const & noexcept
+  {
+    assert(has_value() && "operator*() called on an empty optional_box");
+    return *mPtr;
+  }
+
+  [[nodiscard]] PayloadType && operator*() && noexcept
+  {
+    assert(has_value() && "operator*() called on an empty optional_box");
+    return std::move(*mPtr);
+  }
+
+  [[nodiscard]] PayloadType const && operator*() const && noexcept
+  {
+    assert(has_value() && "operator*() called on an empty optional_box");
+    return std::move(*mPtr);
+  }
+
+  [[nodiscard]] PayloadType & value() &
+  {
+    if (!has_value()) {
+      throw std::bad_optional_access{};
+    }
+    return *mPtr;
+  }
+
+  [[nodiscard]] PayloadType const & value() const &
+  {
+    if (!has_value()) {
+      throw std::bad_optional_access{};
+    }
+    return *mPtr;
+  }
+
+  [[nodiscard]] PayloadType && value() &&
+  {
+    if (!has_value()) {
+      throw std::bad_optional_access{};
+    }
+    return std::move(*mPtr);
+  }
+
+  [[nodiscard]] PayloadType const && value() const &&
+  {
+    if (!has_value()) {
+      throw std::bad_optional_access{};
+    }
+    return std::move(*mPtr);
+  }
+
+  template <class U>
+  [[nodiscard]] std::remove_cv_t<PayloadType> value_or(U && defaultValue) const &
+  {
+    static_assert(
+        std::is_copy_constructible_v<PayloadType>,
+        "PayloadType must be copy constructible for value_or().");
+    static_assert(std::is_convertible_v<U, PayloadType>, "U must be convertible to PayloadType for value_or().");
+    return has_value() ? *mPtr : static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue));
+  }
+
+  template <class U>
+  [[nodiscard]] std::remove_cv_t<PayloadType> value_or(U && defaultValue) &&
+  {
+    static_assert(
+        std::is_move_constructible_v<PayloadType>,
+        "PayloadType must be move constructible for value_or().");
+    static_assert(std::is_convertible_v<U, PayloadType>, "U must be convertible to PayloadType for value_or().");
+    return has_value() ? std::move(*mPtr) : static_cast<std::remove_cv_t<PayloadType>>(std::forward<U>(defaultValue));
+  }
+
+  [[nodiscard]] allocator_type get_allocator() const noexcept
+  {
+    return GetAllocator();
+  }
+
+private:
+  using AllocHolder::GetAllocator;
+
+  friend struct optional_flag_manipulator<optional_box>;
+
+  // Only for the optional_flag_manipulator: Constructs the state that indicates an empty tiny::optional<optional_box>.
+  explicit optional_box(impl::OptionalBoxSentinelTag) noexcept
+    : AllocHolder()
+    , mPtr(impl::OptionalBoxSentinel<PayloadType>::Get())
+  {
+  }
+
+  template <class... ArgsT>
+  [[nodiscard]] PayloadType * Create(ArgsT &&... args)
+  {
+    PayloadType * const ptr = AllocTraits::allocate(GetAllocator(), 1);
+    try {
+      AllocTraits::construct(GetAllocator(), ptr, std::forward<ArgsT>(args)...);
+    }
+    catch (...) {
+      AllocTraits::deallocate(GetAllocator(), ptr, 1);
+      throw;
+    }
+    return ptr;
+  }
+
+  template <class... ArgsT>
+  PayloadType & EmplaceImpl(ArgsT &&... args)
+  {
+    if (mPtr == nullptr) {
+      mPtr = Create(std::forward<ArgsT>(args)...);
+      return *mPtr;
+    }
+
+    AllocTraits::destroy(GetAllocator(), mPtr);
+    try {
+      AllocTraits::construct(GetAllocator(), mPtr, std::forward<ArgsT>(args)...);
+    }
+    catch (...) {
+      AllocTraits::deallocate(GetAllocator(), std::exchange(mPtr, nullptr), 1);
+      throw;
+    }
+    return *mPtr;
+  }
+
+  template <class U>
+  void AssignValue(U && v)
+  {
+    if (mPtr != nullptr) {
+      *mPtr = std::forward<U>(v);
+    }
+    else {
+      mPtr = Create(std::forward<U>(v));
+    }
+  }
+
+  PayloadType * mPtr = nullptr;
+};
+
+
+template <class PayloadType, class Allocator>
+void swap(optional_box<PayloadType, Allocator> & lhs, optional_box<PayloadType, Allocator> & rhs) noexcept
+{
+  lhs.swap(rhs);
+}
+
+
+//====================================================================================
+// Comparison operators of optional_box
+//====================================================================================
+
+namespace impl
+{
+  template <class U>
+  inline constexpr bool IsOptionalBoxOrNullopt
+      = IsOptionalBox<my_remove_cvref_t<U>> || std::is_same_v<my_remove_cvref_t<U>, std::nullopt_t>;
+}
+
+// The semantics are the same as for tiny::optional and std::optional: An empty box compares equal to another empty box
+// and to std::nullopt, and less than any value. The last three arguments are the results for an empty lhs and an
+// empty rhs, an empty lhs and a value as rhs, and a value as lhs and an empty rhs.
+// clang-format off
+#define TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX(Op, emptyVsEmpty, emptyVsValue, valueVsEmpty)                            \
+  template <class P1, class A1, class P2, class A2>                                                                      \
+  [[nodiscard]] bool operator Op(optional_box<P1, A1> const & lhs, optional_box<P2, A2> const & rhs)                     \
+  {                                                                                                                      \
+    if (lhs.has_value() && rhs.has_value()) {                                                                            \
+      return *lhs Op *rhs;                                                                                               \
+    }                                                                                                                    \
+    return lhs.has_value() ? valueVsEmpty : (rhs.has_value() ? emptyVsValue : emptyVsEmpty);                             \
+  }                                                                                                                      \
+                                                                                                                         \
+  template <class P, class A>                                                                                            \
+  [[nodiscard]] bool operator Op(optional_box<P, A> const & lhs, std::nullopt_t) noexcept                                \
+  {                                                                                                                      \
+    return lhs.has_value() ? valueVsEmpty : emptyVsEmpty;                                                                \
+  }                                                                                                                      \
+                                                                                                                         \
+  template <class P, class A>                                                                                            \
+  [[nodiscard]] bool operator Op(std::nullopt_t, optional_box<P, A> const & rhs) noexcept                                \
+  {                                                                                                                      \
+    return rhs.has_value() ? emptyVsValue : emptyVsEmpty;                                                                \
+  }                                                                                                                      \
+                                                                                                                         \
+  template <class P, class A, class U>                                                                                   \
+  [[nodiscard]] std::enable_if_t<!impl::IsOptionalBoxOrNullopt<U>, bool> operator Op(                                    \
+      optional_box<P, A> const & lhs, U const & rhs)                                                                     \
+  {                                                                                                                      \
+    return lhs.has_value() ? (*lhs Op rhs) : emptyVsValue;                                                               \
+  }                                                                                                                      \
+                                                                                                                         \
+  template <class U, class P, class A>                                                                                   \
+  [[nodiscard]] std::enable_if_t<!impl::IsOptionalBoxOrNullopt<U>, bool> operator Op(                                    \
+      U const & lhs, optional_box<P, A> const & rhs)                                                                     \
+  {                                                                                                                      \
+    return rhs.has_value() ? (lhs Op *rhs) : valueVsEmpty;                                                               \
+  }
+// clang-format on
+
+TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX(==, true, false, false)
+TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX(!=, false, true, true)
+TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX(<, false, true, false)
+TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX(<=, true, true, false)
+TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX(>, false, false, true)
+TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX(>=, true, false, true)
+
+#undef TINY_OPTIONAL_IMPL_COMPARE_OPTIONAL_BOX
+
+#ifdef TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON
+template <class P1, class A1, std::three_way_comparable_with<P1> P2, class A2>
+[[nodiscard]] std::compare_three_way_result_t<P1, P2>
+    operator<=>(optional_box<P1, A1> const & lhs, optional_box<P2, A2> const & rhs)
+{
+  return (lhs && rhs) ? (*lhs <=> *rhs) : (lhs.has_value() <=> rhs.has_value());
+}
+
+template <class P, class A>
+[[nodiscard]] std::strong_ordering operator<=>(optional_box<P, A> const & lhs, std::nullopt_t) noexcept
+{
+  return lhs.has_value() <=> false;
+}
+
+template <class P, class A, class U>
+  requires(!impl::IsOptionalBoxOrNullopt<U> && std::three_way_comparable_with<P, U>)
+[[nodiscard]] std::compare_three_way_result_t<P, U> operator<=>(optional_box<P, A> const & lhs, U const & rhs)
+{
+  return lhs.has_value() ? (*lhs <=> rhs) : std::strong_ordering::less;
+}
+#endif
+
+TINY_OPTIONAL_INLINE_NS_END
+
+
+// A tiny::optional<optional_box> has the size of the optional_box: The empty state is indicated by a special address
+// in the pointer (an empty optional_box stores a nullptr). The allocator must be default constructible for this.
+template <class PayloadType, class Allocator>
+struct optional_flag_manipulator<
+    optional_box<PayloadType, Allocator>,
+    std::enable_if_t<std::is_nothrow_default_constructible_v<Allocator>>>
+{
+  using Box = optional_box<PayloadType, Allocator>;
+
+  static bool is_empty(Box const & payload) noexcept
+  {
+    return payload.mPtr == impl::OptionalBoxSentinel<PayloadType>::Get();
+  }
+
+  static void init_empty_flag(Box & uninitializedPayloadMemory) noexcept
+  {
+    ::new (static_cast<void *>(std::addressof(uninitializedPayloadMemory))) Box(impl::OptionalBoxSentinelTag{});
+  }
+
+  static void invalidate_empty_flag(Box & emptyPayload) noexcept
+  {
+    // The destructor must not free the sentinel address.
+    emptyPayload.mPtr = nullptr;
+    emptyPayload.~Box();
+  }
+};
+} // namespace tiny
+
+
+namespace std
+{
+template <class PayloadType, class Allocator>
+struct hash<tiny::impl::EnableHashHelper<tiny::optional_box<PayloadType, Allocator>, PayloadType>>
+{
+  size_t operator()(tiny::optional_box<PayloadType, Allocator> const & o) const
+  {
+    return o.has_value() ? hash<std::remove_const_t<PayloadType>>{}(*o) : 0;
+  }
+};
+} // namespace std
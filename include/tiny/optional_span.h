@@ -0,0 +1,203 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "optional.h"
+
+#ifndef TINY_OPTIONAL_CPP20
+  #error tiny/optional_span.h requires C++20 (std::span).
+#endif
+
+#include <cstddef>
+#include <memory> // Required for std::start_lifetime_as_array
+#include <new> // Required for std::launder
+#include <span>
+#include <type_traits>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+namespace impl
+{
+  // The individual conditions under which an array of 'RawType' objects can be viewed as an array of the tiny optional
+  // 'OptionalType' (and vice versa) without copying. Compare is_optional_span_compatible_v.
+  template <class OptionalType, class RawType, bool = is_tiny_optional_v<std::remove_cv_t<OptionalType>>>
+  struct OptionalSpanCompatibility
+  {
+    static constexpr bool isTinyOptional = false;
+    static constexpr bool hasSamePayloadType = false;
+    static constexpr bool hasIdenticalLayout = false;
+    static constexpr bool hasKnownSentinel = false;
+    static constexpr bool sentinelIsValidPayload = false;
+  };
+
+  template <class OptionalType_, class RawType_>
+  struct OptionalSpanCompatibility<OptionalType_, RawType_, true>
+  {
+    using OptionalType = std::remove_cv_t<OptionalType_>;
+    using RawType = std::remove_cv_t<RawType_>;
+    using LayoutTraits = SentinelLayoutTraits<OptionalType>;
+
+    static constexpr bool isTinyOptional = true;
+
+    static constexpr bool hasSamePayloadType
+        = !std::is_volatile_v<RawType_> && std::is_same_v<RawType, std::remove_cv_t<typename OptionalType::value_type>>;
+
+    // Standard layout guarantees that the payload is located at the beginning of the optional, and trivial
+    // copyability that both are implicit-lifetime types (as required by std::start_lifetime_as_array).
+    static constexpr bool hasIdenticalLayout
+        = OptionalType::is_compressed && sizeof(OptionalType) == sizeof(RawType)
+          && alignof(OptionalType) == alignof(RawType) && std::is_standard_layout_v<OptionalType>
+          && std::is_standard_layout_v<RawType> && std::is_trivially_copyable_v<OptionalType>
+          && std::is_trivially_copyable_v<RawType>;
+
+    // The empty state must be a compile-time constant written into the payload (i.e. an AssignmentFlagManipulator or
+    // MemcpyAndCmpFlagManipulator), so that every raw value maps to exactly one state of the optional and vice versa.
+    static constexpr bool hasKnownSentinel = LayoutTraits::isPayloadWithKnownSentinel;
+
+    // Viewing optionals as raw payloads additionally requires that empty optionals are valid payload objects. This is
+    // not the case if the sentinel is a bit pattern that is no valid value of the flag type, as for bools (0xfe).
+    static constexpr bool sentinelIsValidPayload = [] {
+      if constexpr (hasKnownSentinel) {
+        using SentinelInfo = typename LayoutTraits::SentinelInfo;
+        return !SentinelInfo::comparesRawBits
+               || !std::is_same_v<std::remove_cv_t<typename SentinelInfo::FlagType>, bool>;
+      }
+      else {
+        return false;
+      }
+    }();
+  };
+
+
+  template <class Compatibility>
+  constexpr void AssertOptionalSpanCompatibility() noexcept
+  {
+    static_assert(
+        Compatibility::isTinyOptional,
+        "as_optional_span/as_payload_span: The target type must be a tiny optional.");
+    static_assert(
+        Compatibility::hasSamePayloadType,
+        "as_optional_span/as_payload_span: The element type of the raw span must be the payload type of the optional "
+        "(and not volatile).");
+    static_assert(
+        Compatibility::hasIdenticalLayout,
+        "as_optional_span/as_payload_span: The optional does not have the same layout as its payload. It must be "
+        "compressed (no separate bool), standard layout and trivially copyable, and have the same size and alignment.");
+    static_assert(
+        Compatibility::hasKnownSentinel,
+        "as_optional_span/as_payload_span: The optional must store the empty state as compile-time sentinel value in "
+        "the payload. Optionals with custom flag manipulators (other than bit_pattern_flag_manipulator) are not "
+        "supported since their empty state cannot be verified to be a plain payload value.");
+  }
+
+
+  // Ends the lifetime of the 'count' objects at 'source' and starts the lifetime of 'count' TargetType objects with
+  // the same object representation, without touching the memory.
+  template <class TargetType, class SourceType>
+  [[nodiscard]] TargetType * ReinterpretArray(SourceType * source, [[maybe_unused]] std::size_t count) noexcept
+  {
+#if defined(__cpp_lib_start_lifetime_as) && __cpp_lib_start_lifetime_as >= 202207L
+    return std::start_lifetime_as_array<TargetType>(source, count);
+#else
+    // Without std::start_lifetime_as_array, there is no standard conforming way to do this. As with the other
+    // type punning in the library, we rely on the compiler doing the obvious thing here. std::launder at least
+    // prevents the compiler from propagating knowledge about the original objects.
+    if (source == nullptr) {
+      return nullptr;
+    }
+    return std::launder(reinterpret_cast<TargetType *>(source));
+#endif
+  }
+} // namespace impl
+
+
+// True if a contiguous sequence of 'RawType' objects can be reinterpreted in-place as a sequence of 'OptionalType'
+// objects via as_optional_span(). That is the case if the optional is a tiny optional with the payload type 'RawType',
+// has the exact same layout as 'RawType' and indicates the empty state via a compile-time sentinel stored in the
+// payload. For example, tiny::optional<int, -1> is compatible with int, and tiny::optional<double> with double.
+template <class OptionalType, class RawType>
+inline constexpr bool is_optional_span_compatible_v
+    = impl::OptionalSpanCompatibility<OptionalType, RawType>::isTinyOptional
+      && impl::OptionalSpanCompatibility<OptionalType, RawType>::hasSamePayloadType
+      && impl::OptionalSpanCompatibility<OptionalType, RawType>::hasIdenticalLayout
+      && impl::OptionalSpanCompatibility<OptionalType, RawType>::hasKnownSentinel;
+
+
+// Views an existing array of payloads, where some specific value indicates a missing value, as an array of tiny
+// optionals without copying. For example, a buffer of ints where -1 means 'missing' can be viewed as a span of
+// tiny::optional<int, -1>:
+//      std::span<tiny::optional<int, -1>> view = tiny::as_optional_span<tiny::optional<int, -1>>(rawSpan);
+// Assigning std::nullopt to an element of the view writes the sentinel into the original memory.
+// The layout identity is verified at compile time (compare is_optional_span_compatible_v).
+// Formally, the lifetime of the original objects ends and the lifetime of the optionals begins (using
+// std::start_lifetime_as_array if available). So the original span must not be used anymore until the memory is
+// converted back via as_payload_span().
+template <class OptionalType, class RawType, std::size_t extent>
+[[nodiscard]] auto as_optional_span(std::span<RawType, extent> raw) noexcept
+{
+  impl::AssertOptionalSpanCompatibility<impl::OptionalSpanCompatibility<OptionalType, RawType>>();
+
+  using TargetType = std::conditional_t<
+      std::is_const_v<RawType> || std::is_const_v<OptionalType>,
+      std::remove_cv_t<OptionalType> const,
+      std::remove_cv_t<OptionalType>>;
+  return std::span<TargetType, extent>(impl::ReinterpretArray<TargetType>(raw.data(), raw.size()), raw.size());
+}
+
+
+// The inverse of as_optional_span(): Views an array of tiny optionals as an array of their payloads without copying,
+// where empty optionals show up as the sentinel value. For example, a span of tiny::optional<int, -1> results in a span
+// of int, where every empty optional reads as -1. This can be used to hand data to code that expects raw arrays.
+// Besides the requirements of as_optional_span(), the sentinel must be a valid payload value. This excludes e.g.
+// tiny::optional<bool>, whose sentinel is a bit pattern that is not a valid bool.
+template <class OptionalType, std::size_t extent>
+[[nodiscard]] auto as_payload_span(std::span<OptionalType, extent> optionals) noexcept
+{
+  using Compatibility = impl::OptionalSpanCompatibility<OptionalType, typename OptionalType::value_type>;
+  impl::AssertOptionalSpanCompatibility<Compatibility>();
+  static_assert(
+      Compatibility::sentinelIsValidPayload,
+      "as_payload_span: The sentinel of the optional is not a valid value of the payload type (e.g. for bools).");
+
+  using TargetType = std::conditional_t<
+      std::is_const_v<OptionalType>,
+      std::remove_cv_t<typename OptionalType::value_type> const,
+      std::remove_cv_t<typename OptionalType::value_type>>;
+  return std::span<TargetType, extent>(
+      impl::ReinterpretArray<TargetType>(optionals.data(), optionals.size()),
+      optionals.size());
+}
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
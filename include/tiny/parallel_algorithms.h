@@ -0,0 +1,446 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "optional.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// A fixed set of worker threads for the parallel algorithms below. The algorithms only require two member functions
+// from an executor, so a user-defined executor (e.g. a wrapper around an existing thread pool) can be used instead:
+// - size(): The maximal number of workers.
+// - parallel_invoke(numWorkers, func): Calls func(workerIndex) for every workerIndex in [0, numWorkers) concurrently,
+//   and returns once all calls have returned. The calls must really run concurrently, since the workers steal work
+//   from each other.
+//
+// The calling thread participates as worker 0. parallel_invoke() may be called from several threads, but the calls
+// are serialized. Calling it recursively from within a worker deadlocks.
+class thread_pool
+{
+public:
+  // 'numThreads' includes the calling thread. 0 means std::thread::hardware_concurrency().
+  explicit thread_pool(unsigned numThreads = 0)
+  {
+    if (numThreads == 0) {
+      numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    mThreads.reserve(numThreads - 1);
+    for (unsigned i = 1; i < numThreads; ++i) {
+      mThreads.emplace_back([this, i] { WorkerMain(i); });
+    }
+  }
+
+  ~thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mWakeUp.notify_all();
+    for (std::thread & t : mThreads) {
+      t.join();
+    }
+  }
+
+  thread_pool(thread_pool const &) = delete;
+  thread_pool & operator=(thread_pool const &) = delete;
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return mThreads.size() + 1;
+  }
+
+  // Rethrows the first exception thrown by 'func' (after all workers have finished).
+  template <class Func>
+  void parallel_invoke(std::size_t numWorkers, Func const & func)
+  {
+    numWorkers = std::min(numWorkers, size());
+    if (numWorkers <= 1) {
+      func(std::size_t{0});
+      return;
+    }
+
+    std::lock_guard<std::mutex> invokeLock(mInvokeMutex);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mJob = &func;
+      mRunJob = [](void const * job, std::size_t workerIndex) { (*static_cast<Func const *>(job))(workerIndex); };
+      mNumWorkers = numWorkers;
+      mNumRunning = numWorkers - 1;
+      mException = nullptr;
+      ++mGeneration;
+    }
+    mWakeUp.notify_all();
+
+    RunJob(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this] { return mNumRunning == 0; });
+    if (mException) {
+      std::rethrow_exception(mException);
+    }
+  }
+
+private:
+  void WorkerMain(std::size_t workerIndex)
+  {
+    std::uint64_t lastGeneration = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWakeUp.wait(lock, [&] { return mStop || mGeneration != lastGeneration; });
+        if (mStop) {
+          return;
+        }
+        lastGeneration = mGeneration;
+        if (workerIndex >= mNumWorkers) {
+          continue;
+        }
+      }
+
+      RunJob(workerIndex);
+
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (--mNumRunning == 0) {
+        mDone.notify_one();
+      }
+    }
+  }
+
+  void RunJob(std::size_t workerIndex) noexcept
+  {
+    try {
+      mRunJob(mJob, workerIndex);
+    }
+    catch (...) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mException) {
+        mException = std::current_exception();
+      }
+    }
+  }
+
+  std::vector<std::thread> mThreads;
+  std::mutex mInvokeMutex;
+  std::mutex mMutex;
+  std::condition_variable mWakeUp;
+  std::condition_variable mDone;
+
+  // The current job, protected by mMutex.
+  void const * mJob = nullptr;
+  void (*mRunJob)(void const *, std::size_t) = nullptr;
+  std::size_t mNumWorkers = 0;
+  std::size_t mNumRunning = 0;
+  std::uint64_t mGeneration = 0;
+  std::exception_ptr mException;
+  bool mStop = false;
+};
+
+
+namespace impl
+{
+  // The chunks [begin, end) that a worker still has to process. Packed into one atomic so that the owner can take
+  // chunks from the front and thieves can take half of them from the back via compare-and-swap.
+  struct alignas(64) StealableChunkRange
+  {
+    std::atomic<std::uint64_t> packed{0};
+
+    static constexpr std::uint64_t Pack(std::uint64_t begin, std::uint64_t end) noexcept
+    {
+      return begin | (end << 32);
+    }
+
+    bool PopFront(std::size_t & chunk) noexcept
+    {
+      std::uint64_t current = packed.load(std::memory_order_relaxed);
+      for (;;) {
+        std::uint64_t const begin = current & 0xffffffffu;
+        std::uint64_t const end = current >> 32;
+        if (begin >= end) {
+          return false;
+        }
+        if (packed.compare_exchange_weak(current, Pack(begin + 1, end), std::memory_order_relaxed)) {
+          chunk = static_cast<std::size_t>(begin);
+          return true;
+        }
+      }
+    }
+
+    // Takes the back half of the chunks (at least one), and returns them in 'stolen'.
+    bool StealBackHalf(std::uint64_t & stolen) noexcept
+    {
+      std::uint64_t current = packed.load(std::memory_order_relaxed);
+      for (;;) {
+        std::uint64_t const begin = current & 0xffffffffu;
+        std::uint64_t const end = current >> 32;
+        if (begin >= end) {
+          return false;
+        }
+        std::uint64_t const middle = end - (end - begin + 1) / 2;
+        if (packed.compare_exchange_weak(current, Pack(begin, middle), std::memory_order_relaxed)) {
+          stolen = Pack(middle, end);
+          return true;
+        }
+      }
+    }
+  };
+
+
+  // Splits [0, count) into chunks of 'grainSize' elements and calls func(chunkIndex, begin, end) for every chunk,
+  // distributed over the workers of the executor. Every worker starts with a contiguous range of chunks (so that
+  // neighboring chunks are processed by the same thread), and steals from the other workers once it runs out of work.
+  template <class Executor, class ChunkFunc>
+  void ForEachChunkInParallel(Executor & executor, std::size_t count, std::size_t grainSize, ChunkFunc const & func)
+  {
+    grainSize = std::max(grainSize, std::size_t{1});
+    std::size_t const numChunks = count / grainSize + (count % grainSize != 0 ? 1 : 0);
+    auto const processChunk = [&](std::size_t chunk) {
+      std::size_t const begin = chunk * grainSize;
+      func(chunk, begin, std::min(begin + grainSize, count));
+    };
+
+    std::size_t const numWorkers = std::min(static_cast<std::size_t>(executor.size()), numChunks);
+    if (numWorkers <= 1) {
+      for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+        processChunk(chunk);
+      }
+      return;
+    }
+
+    assert(numChunks <= 0xffffffffu && "ForEachChunkInParallel: Too many chunks, increase the grain size.");
+    std::unique_ptr<StealableChunkRange[]> ranges(new StealableChunkRange[numWorkers]);
+    for (std::size_t w = 0; w < numWorkers; ++w) {
+      ranges[w].packed.store(StealableChunkRange::Pack(w * numChunks / numWorkers, (w + 1) * numChunks / numWorkers));
+    }
+
+    executor.parallel_invoke(numWorkers, [&](std::size_t worker) {
+      for (;;) {
+        std::size_t chunk = 0;
+        while (ranges[worker].PopFront(chunk)) {
+          processChunk(chunk);
+        }
+
+        // Nothing left: Steal from the others. Since the own range is empty, thieves never modify it, so storing the
+        // stolen chunks into it is safe.
+        bool stoleSomething = false;
+        for (std::size_t i = 1; i < numWorkers && !stoleSomething; ++i) {
+          std::uint64_t stolen = 0;
+          if (ranges[(worker + i) % numWorkers].StealBackHalf(stolen)) {
+            ranges[worker].packed.store(stolen, std::memory_order_relaxed);
+            stoleSomething = true;
+          }
+        }
+        if (!stoleSomething) {
+          return;
+        }
+      }
+    });
+  }
+} // namespace impl
+
+
+// The default number of elements processed as one unit of work by the parallel algorithms. Large enough that the
+// scheduling overhead is negligible, small enough for good load balancing on arrays of a few million elements.
+inline constexpr std::size_t default_parallel_grain_size = 32 * 1024;
+
+
+// The parallel algorithms work on plain arrays of optionals. Any optional type providing has_value() and operator*
+// works, i.e. tiny optionals as well as std::optional.
+
+// Returns the number of optionals in [data, data + count) that contain a value.
+template <class Executor, class OptionalType>
+[[nodiscard]] std::size_t parallel_count_present(
+    Executor & executor,
+    OptionalType const * data,
+    std::size_t count,
+    std::size_t grainSize = default_parallel_grain_size)
+{
+  std::atomic<std::size_t> total{0};
+  impl::ForEachChunkInParallel(executor, count, grainSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+    std::size_t numPresent = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+      numPresent += data[i].has_value() ? 1 : 0;
+    }
+    total.fetch_add(numPresent, std::memory_order_relaxed);
+  });
+  return total.load();
+}
+
+
+// Sets destination[i] to func(*source[i]) if source[i] contains a value, and to an empty optional otherwise.
+// 'destination' must point to 'count' (constructed) optionals; it may be equal to 'source'.
+template <class Executor, class SourceOptional, class DestinationOptional, class Func>
+void parallel_transform_present(
+    Executor & executor,
+    SourceOptional const * source,
+    std::size_t count,
+    DestinationOptional * destination,
+    Func const & func,
+    std::size_t grainSize = default_parallel_grain_size)
+{
+  impl::ForEachChunkInParallel(executor, count, grainSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      if (source[i].has_value()) {
+        destination[i] = func(*source[i]);
+      }
+      else {
+        destination[i] = DestinationOptional{};
+      }
+    }
+  });
+}
+
+
+// Combines 'init' and all present values via the associative operation 'op'. The partial results of the chunks are
+// combined in order, so for a fixed grain size the result is deterministic, also for floating point types.
+template <class Executor, class OptionalType, class T, class BinaryOp>
+[[nodiscard]] T parallel_reduce_present(
+    Executor & executor,
+    OptionalType const * data,
+    std::size_t count,
+    T init,
+    BinaryOp const & op,
+    std::size_t grainSize = default_parallel_grain_size)
+{
+  grainSize = std::max(grainSize, std::size_t{1});
+  std::size_t const numChunks = count / grainSize + (count % grainSize != 0 ? 1 : 0);
+  // tiny::optional<T> would not work for all T, so use a separate flag.
+  std::vector<std::pair<T, bool>> partials(numChunks, std::pair<T, bool>(init, false));
+
+  impl::ForEachChunkInParallel(executor, count, grainSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t i = begin;
+    while (i < end && !data[i].has_value()) {
+      ++i;
+    }
+    if (i == end) {
+      return;
+    }
+    T partial = *data[i];
+    for (++i; i < end; ++i) {
+      if (data[i].has_value()) {
+        partial = op(partial, *data[i]);
+      }
+    }
+    partials[chunk] = std::pair<T, bool>(std::move(partial), true);
+  });
+
+  T result = std::move(init);
+  for (auto & [partial, hasPartial] : partials) {
+    if (hasPartial) {
+      result = op(std::move(result), std::move(partial));
+    }
+  }
+  return result;
+}
+
+
+// Stream compaction: Writes the present values to 'values' and their positions to 'indices' (both in increasing order
+// of the positions), and returns the number of present values. 'values' and 'indices' must have room for that many
+// elements; 'indices' may be nullptr.
+template <class Executor, class OptionalType, class T>
+std::size_t parallel_compact(
+    Executor & executor,
+    OptionalType const * data,
+    std::size_t count,
+    T * values,
+    std::size_t * indices,
+    std::size_t grainSize = default_parallel_grain_size)
+{
+  grainSize = std::max(grainSize, std::size_t{1});
+  std::size_t const numChunks = count / grainSize + (count % grainSize != 0 ? 1 : 0);
+
+  // First pass: Count per chunk. Then the exclusive prefix sum gives the output position of every chunk.
+  std::vector<std::size_t> offsets(numChunks + 1, 0);
+  impl::ForEachChunkInParallel(executor, count, grainSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t numPresent = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+      numPresent += data[i].has_value() ? 1 : 0;
+    }
+    offsets[chunk + 1] = numPresent;
+  });
+  for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+
+  // Second pass: Write.
+  impl::ForEachChunkInParallel(executor, count, grainSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t out = offsets[chunk];
+    for (std::size_t i = begin; i < end; ++i) {
+      if (data[i].has_value()) {
+        values[out] = *data[i];
+        if (indices != nullptr) {
+          indices[out] = i;
+        }
+        ++out;
+      }
+    }
+  });
+  return offsets[numChunks];
+}
+
+
+// Assigns 'value' to all empty optionals in [data, data + count).
+template <class Executor, class OptionalType, class T>
+void parallel_fill_empty(
+    Executor & executor,
+    OptionalType * data,
+    std::size_t count,
+    T const & value,
+    std::size_t grainSize = default_parallel_grain_size)
+{
+  impl::ForEachChunkInParallel(executor, count, grainSize, [&](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      if (!data[i].has_value()) {
+        data[i] = value;
+      }
+    }
+  });
+}
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
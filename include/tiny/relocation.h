@@ -0,0 +1,169 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "optional.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+// clang provides the trivial relocatability as computed by the compiler (which e.g. takes [[clang::trivial_abi]] into
+// account). Newer versions deprecate __is_trivially_relocatable in favor of the C++26 builtin.
+#if defined(__has_builtin)
+  #if __has_builtin(__builtin_is_cpp_trivially_relocatable)
+    #define TINY_OPTIONAL_IMPL_BUILTIN_IS_TRIVIALLY_RELOCATABLE(T) __builtin_is_cpp_trivially_relocatable(T)
+  #elif __has_builtin(__is_trivially_relocatable)
+    #define TINY_OPTIONAL_IMPL_BUILTIN_IS_TRIVIALLY_RELOCATABLE(T) __is_trivially_relocatable(T)
+  #endif
+#endif
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// A type is trivially relocatable if moving an object to a new address and destroying the source is equivalent to
+// copying its bytes (and then simply forgetting about the source). This holds for all trivially copyable types, but
+// also e.g. for std::unique_ptr, whose move constructor and destructor are non-trivial. Containers can then relocate
+// their elements via std::memcpy instead of calling the move constructor and destructor for every element.
+//
+// The trait is true for trivially copyable types, for types reported by the compiler (clang) and for
+// std::unique_ptr with the default deleter. Specialize it for your own types if appropriate. Note that e.g.
+// std::string is not trivially relocatable in libstdc++ since it points into itself.
+//
+// A tiny::optional is trivially relocatable if and only if its payload is: The IsEmpty flag is either a separate bool
+// or part of the payload, and in both cases copying the bytes copies the flag, too.
+template <class T>
+struct is_trivially_relocatable;
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+
+namespace impl
+{
+  template <class T>
+  constexpr bool IsTriviallyRelocatableDefault()
+  {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      return true;
+    }
+    else if constexpr (is_tiny_optional_v<T>) {
+      return is_trivially_relocatable_v<typename T::value_type>;
+    }
+    else {
+#ifdef TINY_OPTIONAL_IMPL_BUILTIN_IS_TRIVIALLY_RELOCATABLE
+      return TINY_OPTIONAL_IMPL_BUILTIN_IS_TRIVIALLY_RELOCATABLE(T);
+#else
+      return false;
+#endif
+    }
+  }
+} // namespace impl
+
+
+template <class T>
+struct is_trivially_relocatable : std::bool_constant<impl::IsTriviallyRelocatableDefault<T>()>
+{
+};
+
+template <class T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+{
+};
+
+
+// Relocates the object at `source` into the uninitialized memory at `dest`: Afterwards, `dest` contains the object and
+// the lifetime of the object at `source` has ended. Returns `dest`.
+template <class T>
+T * relocate_at(T * source, T * dest) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+{
+  static_assert(!std::is_const_v<T>, "relocate_at: Cannot relocate const objects.");
+  if constexpr (is_trivially_relocatable_v<T>) {
+    std::memmove(static_cast<void *>(dest), static_cast<void const *>(source), sizeof(T));
+    return std::launder(dest);
+  }
+  else {
+    T * const result = ::new (static_cast<void *>(dest)) T(std::move(*source));
+    source->~T();
+    return result;
+  }
+}
+
+
+// Relocates the objects in [first, last) into the uninitialized memory starting at `dest`, which must not overlap with
+// the source range. Returns the end of the destination range. For trivially relocatable types, this is a single
+// std::memcpy. Otherwise, every object is move constructed and the source destroyed. If a move constructor throws, all
+// objects in both ranges are destroyed before the exception is propagated.
+template <class T>
+T * uninitialized_relocate(T * first, T * last, T * dest) noexcept(
+    is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+{
+  static_assert(!std::is_const_v<T>, "uninitialized_relocate: Cannot relocate const objects.");
+  if constexpr (is_trivially_relocatable_v<T>) {
+    auto const count = static_cast<std::size_t>(last - first);
+    if (count > 0) {
+      std::memcpy(static_cast<void *>(dest), static_cast<void const *>(first), count * sizeof(T));
+    }
+    return dest + count;
+  }
+  else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+    for (; first != last; ++first, ++dest) {
+      ::new (static_cast<void *>(dest)) T(std::move(*first));
+      first->~T();
+    }
+    return dest;
+  }
+  else {
+    T * current = dest;
+    try {
+      for (; first != last; ++first, ++current) {
+        ::new (static_cast<void *>(current)) T(std::move(*first));
+        first->~T();
+      }
+    }
+    catch (...) {
+      std::destroy(dest, current);
+      std::destroy(first, last);
+      throw;
+    }
+    return current;
+  }
+}
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
@@ -0,0 +1,177 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "optional.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// An optional for payloads that are too large for tiny::atomic_optional (e.g. 32-256 byte quotes or configuration
+// snapshots), written by a single thread and read by many threads. It is a sequence lock: The writer marks the
+// sequence word while it modifies the payload, and a reader retries if the sequence word changed during its copy of the
+// payload. So readers never block the writer and never write to shared memory.
+//
+// The empty state is part of the sequence word rather than a separate flag. Hence reset() does not touch the payload
+// at all, and a load() of an empty optional returns without copying (and without ever retrying).
+// Deliberately, the sentinel of the payload (as used by tiny::optional) is not used as empty state even if the payload
+// has one: The sequence word is needed anyway and has spare bits, so the sentinel would not save any memory. But
+// reset() would have to write the payload, and has_value() as well as a load() of an empty optional would have to copy
+// the payload and possibly retry.
+//
+// The payload is stored in an array of std::atomic words, which are read and written with relaxed memory order. This
+// avoids the formal data race of a plain memcpy that is read concurrently with a write.
+template <class T>
+class seqlock_optional
+{
+  static_assert(std::is_trivially_copyable_v<T>, "seqlock_optional: The payload must be trivially copyable.");
+  static_assert(
+      std::is_default_constructible_v<T>,
+      "seqlock_optional: The payload must be default constructible, since load() copies the payload into a T.");
+  static_assert(
+      !std::is_const_v<T> && !std::is_volatile_v<T>,
+      "seqlock_optional: The payload must not be cv-qualified.");
+
+private:
+  using Word = std::uintptr_t;
+
+  static constexpr std::size_t cNumWords = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+  // Layout of the sequence word: Bit 0 is set while the writer modifies the payload, bit 1 if the optional is empty.
+  // The remaining bits form the version, which is incremented by every modification.
+  static constexpr Word cWritingBit = 1;
+  static constexpr Word cEmptyBit = 2;
+  static constexpr Word cVersionIncrement = 4;
+
+public:
+  using value_type = T;
+
+  seqlock_optional() noexcept
+    : mSequence(cEmptyBit)
+  {
+  }
+
+  explicit seqlock_optional(T const & value) noexcept
+    : mSequence(0)
+  {
+    WriteWords(value);
+  }
+
+  seqlock_optional(seqlock_optional const &) = delete;
+  seqlock_optional & operator=(seqlock_optional const &) = delete;
+
+  // Writer: Wait-free. Only one thread may call store() and reset() at a time.
+  void store(T const & value) noexcept
+  {
+    Word const sequence = mSequence.load(std::memory_order_relaxed);
+    // Keep the empty bit while writing, so that readers can still report the previous state without waiting.
+    mSequence.store(sequence | cWritingBit, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    WriteWords(value);
+    mSequence.store(NextVersion(sequence), std::memory_order_release);
+  }
+
+  // Writer: Wait-free. Does not touch the payload.
+  void reset() noexcept
+  {
+    Word const sequence = mSequence.load(std::memory_order_relaxed);
+    mSequence.store(NextVersion(sequence) | cEmptyBit, std::memory_order_release);
+  }
+
+  // Reader: Returns a consistent snapshot. Retries if the writer modified the payload during the copy.
+  [[nodiscard]] optional<T> load() const noexcept
+  {
+    for (;;) {
+      Word const before = mSequence.load(std::memory_order_acquire);
+      if (before & cEmptyBit) {
+        // Also if the writer is just storing a value: The optional was still empty when this load() started.
+        return optional<T>{};
+      }
+      if (before & cWritingBit) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      T value;
+      ReadWords(value);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (mSequence.load(std::memory_order_relaxed) == before) {
+        return optional<T>(value);
+      }
+    }
+  }
+
+  // Reader: Wait-free, without copying the payload.
+  [[nodiscard]] bool has_value() const noexcept
+  {
+    return (mSequence.load(std::memory_order_acquire) & cEmptyBit) == 0;
+  }
+
+private:
+  static Word NextVersion(Word sequence) noexcept
+  {
+    return (sequence & ~(cWritingBit | cEmptyBit)) + cVersionIncrement;
+  }
+
+  void WriteWords(T const & value) noexcept
+  {
+    Word words[cNumWords] = {};
+    std::memcpy(words, static_cast<void const *>(&value), sizeof(T));
+    for (std::size_t i = 0; i < cNumWords; ++i) {
+      mWords[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  void ReadWords(T & value) const noexcept
+  {
+    Word words[cNumWords];
+    for (std::size_t i = 0; i < cNumWords; ++i) {
+      words[i] = mWords[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(static_cast<void *>(&value), words, sizeof(T));
+  }
+
+  std::atomic<Word> mSequence;
+  std::atomic<Word> mWords[cNumWords] = {};
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
@@ -0,0 +1,564 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+#include "optional.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept> // Required for std::length_error
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h> // Required for _BitScanForward
+#endif
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// Identifies an element in a tiny::slot_pool. A handle stays valid until the element it refers to is erased. Afterwards
+// the slot may be reused for another element, but the generation stored in the handle then no longer matches, so the
+// stale handle is detected (up to the wrap-around of the 32 bit generation counter).
+struct slot_pool_handle
+{
+  static constexpr std::uint32_t invalid_index = UINT32_MAX;
+
+  std::uint32_t index = invalid_index;
+  std::uint32_t generation = 0; // Generations of occupied slots are always odd, so 0 never matches.
+
+  [[nodiscard]] friend bool operator==(slot_pool_handle const & lhs, slot_pool_handle const & rhs) noexcept
+  {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+  }
+
+  [[nodiscard]] friend bool operator!=(slot_pool_handle const & lhs, slot_pool_handle const & rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+};
+
+
+namespace impl
+{
+  // Returns the index of the lowest set bit. 'v' must not be 0.
+  [[nodiscard]] inline unsigned CountTrailingZeros(std::uint64_t v) noexcept
+  {
+    assert(v != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long idx;
+    _BitScanForward64(&idx, v);
+    return static_cast<unsigned>(idx);
+#elif defined(_MSC_VER)
+    unsigned long idx;
+    if (_BitScanForward(&idx, static_cast<unsigned long>(v))) {
+      return static_cast<unsigned>(idx);
+    }
+    _BitScanForward(&idx, static_cast<unsigned long>(v >> 32));
+    return static_cast<unsigned>(idx) + 32;
+#else
+    unsigned idx = 0;
+    while ((v & 1) == 0) {
+      v >>= 1;
+      ++idx;
+    }
+    return idx;
+#endif
+  }
+
+
+  // A single slot of the slot_pool. The layout follows SeparateFlagStorage: The union prevents the automatic
+  // construction of the payload, and the empty state is stored outside of the payload (here, in the generation).
+  // The difference is that the payload bytes of an empty slot are not wasted: They hold the index of the next free
+  // slot, i.e. the free list of the pool is threaded through the dead payloads.
+  template <class PayloadType>
+  struct SlotPoolSlot
+  {
+    union
+    {
+      std::remove_const_t<PayloadType> payload;
+      std::uint32_t nextFree;
+    };
+
+    // Odd while the slot is occupied, even while it is free. Incremented on every insertion and every erasure.
+    std::uint32_t generation;
+
+    SlotPoolSlot() noexcept
+      : nextFree(slot_pool_handle::invalid_index)
+      , generation(0)
+    {
+    }
+
+    // The payload is destroyed by the slot_pool, which knows whether the slot is occupied.
+    ~SlotPoolSlot() { }
+
+    SlotPoolSlot(SlotPoolSlot const &) = delete;
+    SlotPoolSlot & operator=(SlotPoolSlot const &) = delete;
+
+    [[nodiscard]] bool IsOccupied() const noexcept
+    {
+      return (generation & 1u) != 0;
+    }
+  };
+
+
+  // The chunks are allocated individually so that the addresses of the elements remain stable when the pool grows.
+  // The occupancy of the slots is additionally kept in a bitmask so that iteration can skip free slots 64 at a time
+  // without touching their memory.
+  template <class PayloadType, std::size_t chunkSize>
+  struct SlotPoolChunk
+  {
+    static constexpr std::size_t numMaskWords = chunkSize / 64;
+
+    std::uint64_t occupiedMask[numMaskWords] = {};
+    SlotPoolSlot<PayloadType> slots[chunkSize];
+  };
+} // namespace impl
+
+
+// Object pool that keeps its elements in contiguous chunks with stable addresses. Insertion and erasure are O(1):
+// Free slots form an intrusive singly linked list whose links are stored in the dead payload bytes of the free slots,
+// so no separate free-index vector is necessary. Elements are referred to by generation-checked handles.
+// Iteration visits the live elements in index order and skips free slots via per-chunk occupancy bitmasks.
+//
+// Compared to the std::vector<std::optional<T>> plus free-index-vector combination, every slot costs
+// sizeof(T) + 4 bytes (plus padding and 1 bit for the occupancy mask), regardless whether it is occupied or not.
+template <class PayloadType, std::size_t chunkSize = 256>
+class slot_pool
+{
+  static_assert(chunkSize > 0 && chunkSize % 64 == 0, "slot_pool: The chunk size must be a multiple of 64.");
+  static_assert(
+      (chunkSize & (chunkSize - 1)) == 0,
+      "slot_pool: The chunk size must be a power of 2 (so that the index calculation is cheap).");
+  static_assert(
+      std::is_object_v<PayloadType> && std::is_destructible_v<PayloadType> && !std::is_array_v<PayloadType>,
+      "slot_pool: The payload type must meet the C++ requirement 'Destructible'.");
+
+private:
+  using Slot = impl::SlotPoolSlot<PayloadType>;
+  using Chunk = impl::SlotPoolChunk<PayloadType, chunkSize>;
+
+  template <bool isConst>
+  class IteratorImpl;
+
+public:
+  using value_type = PayloadType;
+  using size_type = std::size_t;
+  using handle = slot_pool_handle;
+  using iterator = IteratorImpl<false>;
+  using const_iterator = IteratorImpl<true>;
+
+  static constexpr size_type chunk_size = chunkSize;
+
+
+  slot_pool() = default;
+
+  slot_pool(slot_pool && rhs) noexcept
+    : mChunks(std::move(rhs.mChunks))
+    , mFreeHead(rhs.mFreeHead)
+    , mSize(rhs.mSize)
+  {
+    rhs.mChunks.clear();
+    rhs.mFreeHead = slot_pool_handle::invalid_index;
+    rhs.mSize = 0;
+  }
+
+  slot_pool & operator=(slot_pool && rhs) noexcept
+  {
+    if (this != &rhs) {
+      DestroyAllElements();
+      mChunks = std::move(rhs.mChunks);
+      mFreeHead = rhs.mFreeHead;
+      mSize = rhs.mSize;
+      rhs.mChunks.clear();
+      rhs.mFreeHead = slot_pool_handle::invalid_index;
+      rhs.mSize = 0;
+    }
+    return *this;
+  }
+
+  // Copying would need to reproduce the exact slot layout (since handles are indices), so it is not supported.
+  slot_pool(slot_pool const &) = delete;
+  slot_pool & operator=(slot_pool const &) = delete;
+
+  ~slot_pool()
+  {
+    DestroyAllElements();
+  }
+
+
+  template <class... ArgsT>
+  handle emplace(ArgsT &&... args)
+  {
+    static_assert(std::is_constructible_v<PayloadType, ArgsT...>);
+
+    if (mFreeHead == slot_pool_handle::invalid_index) {
+      AddChunk();
+    }
+
+    std::uint32_t const index = mFreeHead;
+    Slot & slot = GetSlot(index);
+    assert(!slot.IsOccupied());
+    std::uint32_t const nextFree = slot.nextFree;
+
+    // Regarding the volatile cast: https://stackoverflow.com/q/63325244/3740047
+    if constexpr (std::is_nothrow_constructible_v<PayloadType, ArgsT...>) {
+      ::new (const_cast<void *>(static_cast<void volatile const *>(std::addressof(slot.payload))))
+          PayloadType(std::forward<ArgsT>(args)...);
+    }
+    else {
+      // In analogy to StorageBase::InitializeIsEmptyFlagScope: If the constructor throws, it might have overwritten
+      // the link to the next free slot. Restore it so that the free list remains intact.
+      RestoreFreeLinkScope restoreScope{slot, nextFree};
+      ::new (const_cast<void *>(static_cast<void volatile const *>(std::addressof(slot.payload))))
+          PayloadType(std::forward<ArgsT>(args)...);
+      restoreScope.doNotRestore = true;
+    }
+
+    ++slot.generation;
+    assert(slot.IsOccupied());
+    SetOccupied(index, true);
+    mFreeHead = nextFree;
+    ++mSize;
+    return handle{index, slot.generation};
+  }
+
+  handle insert(PayloadType const & v)
+  {
+    return emplace(v);
+  }
+
+  handle insert(PayloadType && v)
+  {
+    return emplace(std::move(v));
+  }
+
+
+  // Destroys the element referred to by 'h'. Returns false (and does nothing) if the handle is stale or invalid.
+  bool erase(handle h) noexcept
+  {
+    if (!contains(h)) {
+      return false;
+    }
+
+    Slot & slot = GetSlot(h.index);
+    slot.payload.~PayloadType();
+    // Pops the link object into existence in the dead payload bytes.
+    ::new (static_cast<void *>(std::addressof(slot.nextFree))) std::uint32_t(mFreeHead);
+    ++slot.generation;
+    assert(!slot.IsOccupied());
+    SetOccupied(h.index, false);
+    mFreeHead = h.index;
+    --mSize;
+    return true;
+  }
+
+
+  [[nodiscard]] bool contains(handle h) const noexcept
+  {
+    return h.index < NumSlots() && GetSlot(h.index).generation == h.generation && (h.generation & 1u) != 0;
+  }
+
+  // Returns a pointer to the element referred to by 'h', or nullptr if the handle is stale or invalid.
+  [[nodiscard]] PayloadType * get(handle h) noexcept
+  {
+    return contains(h) ? std::addressof(GetSlot(h.index).payload) : nullptr;
+  }
+
+  [[nodiscard]] PayloadType const * get(handle h) const noexcept
+  {
+    return const_cast<slot_pool &>(*this).get(h);
+  }
+
+  [[nodiscard]] PayloadType & operator[](handle h) noexcept
+  {
+    assert(contains(h) && "slot_pool::operator[] called with a stale or invalid handle");
+    return GetSlot(h.index).payload;
+  }
+
+  [[nodiscard]] PayloadType const & operator[](handle h) const noexcept
+  {
+    return const_cast<slot_pool &>(*this)[h];
+  }
+
+
+  [[nodiscard]] size_type size() const noexcept
+  {
+    return mSize;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return mSize == 0;
+  }
+
+  [[nodiscard]] size_type capacity() const noexcept
+  {
+    return NumSlots();
+  }
+
+  // Ensures that at least 'newCapacity' elements can be stored without allocating further chunks.
+  void reserve(size_type newCapacity)
+  {
+    while (NumSlots() < newCapacity) {
+      AddChunk();
+    }
+  }
+
+  // Destroys all elements and invalidates all handles. The chunks are kept.
+  void clear() noexcept
+  {
+    for (std::uint32_t index = 0; index < NumSlots(); ++index) {
+      Slot & slot = GetSlot(index);
+      if (slot.IsOccupied()) {
+        slot.payload.~PayloadType();
+        ++slot.generation;
+      }
+    }
+    for (auto & chunk : mChunks) {
+      for (std::uint64_t & mask : chunk->occupiedMask) {
+        mask = 0;
+      }
+    }
+
+    // Rebuild the free list so that the slots are reused in index order.
+    mFreeHead = slot_pool_handle::invalid_index;
+    for (std::uint32_t index = NumSlots(); index-- > 0;) {
+      Slot & slot = GetSlot(index);
+      ::new (static_cast<void *>(std::addressof(slot.nextFree))) std::uint32_t(mFreeHead);
+      mFreeHead = index;
+    }
+    mSize = 0;
+  }
+
+
+  [[nodiscard]] iterator begin() noexcept
+  {
+    return iterator{this, FindOccupied(0)};
+  }
+
+  [[nodiscard]] iterator end() noexcept
+  {
+    return iterator{this, NumSlots()};
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept
+  {
+    return const_iterator{this, FindOccupied(0)};
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept
+  {
+    return const_iterator{this, NumSlots()};
+  }
+
+  [[nodiscard]] const_iterator cbegin() const noexcept
+  {
+    return begin();
+  }
+
+  [[nodiscard]] const_iterator cend() const noexcept
+  {
+    return end();
+  }
+
+
+private:
+  template <bool isConst>
+  class IteratorImpl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<PayloadType>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<isConst, PayloadType const *, PayloadType *>;
+    using reference = std::conditional_t<isConst, PayloadType const &, PayloadType &>;
+
+    IteratorImpl() = default;
+
+    // Conversion from iterator to const_iterator.
+    template <bool otherIsConst, class = std::enable_if_t<isConst && !otherIsConst>>
+    IteratorImpl(IteratorImpl<otherIsConst> const & rhs) noexcept
+      : mPool(rhs.mPool)
+      , mIndex(rhs.mIndex)
+    {
+    }
+
+    [[nodiscard]] reference operator*() const noexcept
+    {
+      return mPool->GetSlot(mIndex).payload;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept
+    {
+      return std::addressof(**this);
+    }
+
+    // Returns the handle of the element the iterator currently points to.
+    [[nodiscard]] slot_pool_handle get_handle() const noexcept
+    {
+      return slot_pool_handle{mIndex, mPool->GetSlot(mIndex).generation};
+    }
+
+    IteratorImpl & operator++() noexcept
+    {
+      mIndex = mPool->FindOccupied(mIndex + 1);
+      return *this;
+    }
+
+    IteratorImpl operator++(int) noexcept
+    {
+      IteratorImpl copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    [[nodiscard]] friend bool operator==(IteratorImpl const & lhs, IteratorImpl const & rhs) noexcept
+    {
+      return lhs.mIndex == rhs.mIndex;
+    }
+
+    [[nodiscard]] friend bool operator!=(IteratorImpl const & lhs, IteratorImpl const & rhs) noexcept
+    {
+      return lhs.mIndex != rhs.mIndex;
+    }
+
+  private:
+    using PoolType = std::conditional_t<isConst, slot_pool const, slot_pool>;
+
+    IteratorImpl(PoolType * pool, std::uint32_t index) noexcept
+      : mPool(pool)
+      , mIndex(index)
+    {
+    }
+
+    PoolType * mPool = nullptr;
+    std::uint32_t mIndex = 0;
+
+    friend class slot_pool;
+    template <bool>
+    friend class IteratorImpl;
+  };
+
+
+  struct RestoreFreeLinkScope
+  {
+    ~RestoreFreeLinkScope()
+    {
+      if (!doNotRestore) {
+        ::new (static_cast<void *>(std::addressof(slot.nextFree))) std::uint32_t(nextFree);
+      }
+    }
+
+    Slot & slot;
+    std::uint32_t nextFree;
+    bool doNotRestore = false;
+  };
+
+
+  [[nodiscard]] std::uint32_t NumSlots() const noexcept
+  {
+    return static_cast<std::uint32_t>(mChunks.size() * chunkSize);
+  }
+
+  [[nodiscard]] Slot & GetSlot(std::uint32_t index) noexcept
+  {
+    assert(index < NumSlots());
+    return mChunks[index / chunkSize]->slots[index % chunkSize];
+  }
+
+  [[nodiscard]] Slot const & GetSlot(std::uint32_t index) const noexcept
+  {
+    return const_cast<slot_pool &>(*this).GetSlot(index);
+  }
+
+  void SetOccupied(std::uint32_t index, bool occupied) noexcept
+  {
+    std::uint64_t & mask = mChunks[index / chunkSize]->occupiedMask[(index % chunkSize) / 64];
+    std::uint64_t const bit = std::uint64_t{1} << (index % 64);
+    mask = occupied ? (mask | bit) : (mask & ~bit);
+  }
+
+  // Returns the index of the first occupied slot at or after 'index', or NumSlots() if there is none.
+  [[nodiscard]] std::uint32_t FindOccupied(std::uint32_t index) const noexcept
+  {
+    std::uint32_t const numSlots = NumSlots();
+    while (index < numSlots) {
+      std::uint64_t const mask
+          = mChunks[index / chunkSize]->occupiedMask[(index % chunkSize) / 64] >> (index % 64);
+      if (mask != 0) {
+        return index + impl::CountTrailingZeros(mask);
+      }
+      // Continue at the beginning of the next mask word.
+      index = (index / 64 + 1) * 64;
+    }
+    return numSlots;
+  }
+
+  void AddChunk()
+  {
+    // The highest index is reserved for slot_pool_handle::invalid_index.
+    if (NumSlots() > slot_pool_handle::invalid_index - chunkSize) {
+      throw std::length_error("tiny::slot_pool: Maximum number of slots exceeded.");
+    }
+
+    std::uint32_t const firstNewIndex = NumSlots();
+    mChunks.push_back(std::make_unique<Chunk>());
+
+    // Thread the new slots into the free list such that they are used in index order.
+    for (std::uint32_t index = NumSlots(); index-- > firstNewIndex;) {
+      GetSlot(index).nextFree = mFreeHead;
+      mFreeHead = index;
+    }
+  }
+
+  void DestroyAllElements() noexcept
+  {
+    if constexpr (!std::is_trivially_destructible_v<PayloadType>) {
+      for (auto & element : *this) {
+        element.~PayloadType();
+      }
+    }
+  }
+
+
+  std::vector<std::unique_ptr<Chunk>> mChunks;
+  std::uint32_t mFreeHead = slot_pool_handle::invalid_index;
+  size_type mSize = 0;
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
@@ -0,0 +1,443 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "optional.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept> // Required for std::out_of_range
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+namespace impl
+{
+  // A run of consecutive present values within a sparse chunk: The elements [begin, end) of the chunk have values,
+  // which are stored at SparseColumnChunk::values[firstValue, firstValue + end - begin).
+  struct SparseColumnRun
+  {
+    std::uint32_t begin;
+    std::uint32_t end;
+    std::uint32_t firstValue;
+  };
+
+
+  // One chunk of a sparse_column. It is either dense (every element stored as optional, 'dense' has one entry per
+  // element) or sparse (only the runs of present values are stored, every gap between them is an implicit run of
+  // empty elements). Which one is chosen depends on which representation needs less memory.
+  template <class OptionalType>
+  struct SparseColumnChunk
+  {
+    using PayloadType = std::remove_cv_t<typename OptionalType::value_type>;
+
+    bool isSparse = false;
+    std::uint32_t numPresent = 0;
+    std::vector<OptionalType> dense;
+    std::vector<SparseColumnRun> runs;
+    std::vector<PayloadType> values;
+
+    [[nodiscard]] OptionalType Get(std::uint32_t offset) const
+    {
+      if (!isSparse) {
+        return dense[offset];
+      }
+      // Find the last run that starts at or before 'offset'.
+      auto const it = std::upper_bound(
+          runs.begin(),
+          runs.end(),
+          offset,
+          [](std::uint32_t o, SparseColumnRun const & run) { return o < run.begin; });
+      if (it == runs.begin()) {
+        return OptionalType{};
+      }
+      SparseColumnRun const & run = *std::prev(it);
+      return offset < run.end ? OptionalType{values[run.firstValue + (offset - run.begin)]} : OptionalType{};
+    }
+
+    [[nodiscard]] std::size_t GetMemoryUsage() const noexcept
+    {
+      return dense.capacity() * sizeof(OptionalType) + runs.capacity() * sizeof(SparseColumnRun)
+             + values.capacity() * sizeof(PayloadType);
+    }
+  };
+} // namespace impl
+
+
+// A column of optionals (e.g. tiny::optional<double>) for data where most elements are empty, typically in long runs.
+// Even a compressed optional costs sizeof(T) bytes per empty element in a dense array. The sparse_column instead splits
+// the column into chunks of 'chunkSize' elements and stores every chunk in one of two ways, chosen adaptively per
+// chunk:
+// - Dense: As plain array of optionals. Best if most elements are present.
+// - Sparse: Only the present values, plus the runs in which they occur. The runs of empty elements in between are
+//   implicit (run-length encoded). Best if most elements are empty, especially in long runs.
+// Random access first selects the chunk (the 'chunk index' is simply the vector of chunks) and then either reads the
+// dense element or performs a binary search over the runs. Sequential iteration walks the runs without any search.
+//
+// The column is built by appending elements. The last chunk is kept dense until it is full, and is then encoded.
+// Modifying an element of an already encoded chunk re-encodes the whole chunk (O(chunkSize)).
+template <class OptionalType, std::size_t chunkSize = 1024>
+class sparse_column
+{
+  static_assert(
+      chunkSize > 0 && (chunkSize & (chunkSize - 1)) == 0,
+      "sparse_column: The chunk size must be a power of 2 (so that the index calculation is cheap).");
+  static_assert(chunkSize <= (std::size_t{1} << 31), "sparse_column: The chunk size is too large.");
+
+private:
+  using Chunk = impl::SparseColumnChunk<OptionalType>;
+  using Run = impl::SparseColumnRun;
+
+public:
+  using value_type = OptionalType;
+  using payload_type = typename Chunk::PayloadType;
+  using size_type = std::size_t;
+
+  static constexpr size_type chunk_size = chunkSize;
+
+  class const_iterator;
+
+
+  sparse_column() = default;
+
+
+  void push_back(OptionalType const & value)
+  {
+    if (mSize % chunkSize == 0) {
+      mChunks.emplace_back();
+      mChunks.back().dense.reserve(chunkSize);
+    }
+
+    Chunk & chunk = mChunks.back();
+    assert(!chunk.isSparse);
+    chunk.dense.push_back(value);
+    chunk.numPresent += value.has_value() ? 1 : 0;
+    ++mSize;
+
+    if (mSize % chunkSize == 0) {
+      EncodeChunk(chunk);
+    }
+  }
+
+  // Appends 'count' empty elements. Whole chunks of empty elements are created directly in sparse form.
+  void append_empty(size_type count)
+  {
+    while (count > 0) {
+      if (mSize % chunkSize == 0 && count >= chunkSize) {
+        Chunk & chunk = mChunks.emplace_back();
+        chunk.isSparse = true;
+        mSize += chunkSize;
+        count -= chunkSize;
+      }
+      else {
+        push_back(OptionalType{});
+        --count;
+      }
+    }
+  }
+
+
+  [[nodiscard]] size_type size() const noexcept
+  {
+    return mSize;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return mSize == 0;
+  }
+
+  // Number of elements that have a value.
+  [[nodiscard]] size_type count_present() const noexcept
+  {
+    size_type result = 0;
+    for (Chunk const & chunk : mChunks) {
+      result += chunk.numPresent;
+    }
+    return result;
+  }
+
+  // Number of chunks that are stored in the sparse representation.
+  [[nodiscard]] size_type num_sparse_chunks() const noexcept
+  {
+    return static_cast<size_type>(
+        std::count_if(mChunks.begin(), mChunks.end(), [](Chunk const & chunk) { return chunk.isSparse; }));
+  }
+
+  // Approximation of the heap memory used by the column in bytes.
+  [[nodiscard]] size_type memory_usage() const noexcept
+  {
+    size_type result = mChunks.capacity() * sizeof(Chunk);
+    for (Chunk const & chunk : mChunks) {
+      result += chunk.GetMemoryUsage();
+    }
+    return result;
+  }
+
+
+  // Random access. Returns the element by value since empty elements of sparse chunks are not stored anywhere.
+  [[nodiscard]] OptionalType operator[](size_type index) const
+  {
+    assert(index < mSize);
+    return mChunks[index / chunkSize].Get(static_cast<std::uint32_t>(index % chunkSize));
+  }
+
+  [[nodiscard]] OptionalType at(size_type index) const
+  {
+    if (index >= mSize) {
+      throw std::out_of_range("tiny::sparse_column::at: index out of range");
+    }
+    return (*this)[index];
+  }
+
+
+  // Sets the element at 'index'. If the element is in an encoded chunk, the chunk is decoded and re-encoded.
+  void set(size_type index, OptionalType const & value)
+  {
+    if (index >= mSize) {
+      throw std::out_of_range("tiny::sparse_column::set: index out of range");
+    }
+
+    Chunk & chunk = mChunks[index / chunkSize];
+    auto const offset = static_cast<std::uint32_t>(index % chunkSize);
+    bool const isLastChunk = &chunk == &mChunks.back();
+    bool const isEncoded = !isLastChunk || mSize % chunkSize == 0;
+
+    if (chunk.isSparse) {
+      DecodeChunk(chunk);
+    }
+    chunk.numPresent -= chunk.dense[offset].has_value() ? 1 : 0;
+    chunk.dense[offset] = value;
+    chunk.numPresent += value.has_value() ? 1 : 0;
+    if (isEncoded) {
+      EncodeChunk(chunk);
+    }
+  }
+
+
+  // Calls func(index, payload) for every element that has a value, in index order. Runs of empty elements in sparse
+  // chunks are skipped without visiting them, making this the fastest way to process very sparse columns.
+  template <class Func>
+  void for_each_present(Func && func) const
+  {
+    size_type chunkBegin = 0;
+    for (Chunk const & chunk : mChunks) {
+      if (chunk.isSparse) {
+        for (Run const & run : chunk.runs) {
+          for (std::uint32_t offset = run.begin; offset < run.end; ++offset) {
+            func(chunkBegin + offset, chunk.values[run.firstValue + (offset - run.begin)]);
+          }
+        }
+      }
+      else if (chunk.numPresent > 0) {
+        for (std::uint32_t offset = 0; offset < chunk.dense.size(); ++offset) {
+          if (chunk.dense[offset].has_value()) {
+            func(chunkBegin + offset, *chunk.dense[offset]);
+          }
+        }
+      }
+      chunkBegin += chunkSize;
+    }
+  }
+
+
+  [[nodiscard]] const_iterator begin() const noexcept
+  {
+    return const_iterator(this, 0);
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept
+  {
+    return const_iterator(this, mSize);
+  }
+
+
+  void clear() noexcept
+  {
+    mChunks.clear();
+    mSize = 0;
+  }
+
+
+  // Forward iterator over all elements (empty or not). Dereferencing returns the optional by value.
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = OptionalType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = OptionalType;
+
+    const_iterator() = default;
+
+    [[nodiscard]] OptionalType operator*() const
+    {
+      Chunk const & chunk = mColumn->mChunks[mIndex / chunkSize];
+      auto const offset = static_cast<std::uint32_t>(mIndex % chunkSize);
+      if (!chunk.isSparse) {
+        return chunk.dense[offset];
+      }
+      if (mRun < chunk.runs.size() && offset >= chunk.runs[mRun].begin) {
+        Run const & run = chunk.runs[mRun];
+        return OptionalType{chunk.values[run.firstValue + (offset - run.begin)]};
+      }
+      return OptionalType{};
+    }
+
+    const_iterator & operator++() noexcept
+    {
+      ++mIndex;
+      if (mIndex % chunkSize == 0) {
+        mRun = 0;
+      }
+      else {
+        Chunk const & chunk = mColumn->mChunks[mIndex / chunkSize];
+        if (chunk.isSparse && mRun < chunk.runs.size() && mIndex % chunkSize >= chunk.runs[mRun].end) {
+          ++mRun;
+        }
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    [[nodiscard]] size_type get_index() const noexcept
+    {
+      return mIndex;
+    }
+
+    [[nodiscard]] friend bool operator==(const_iterator const & lhs, const_iterator const & rhs) noexcept
+    {
+      return lhs.mIndex == rhs.mIndex;
+    }
+
+    [[nodiscard]] friend bool operator!=(const_iterator const & lhs, const_iterator const & rhs) noexcept
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    friend class sparse_column;
+
+    const_iterator(sparse_column const * column, size_type index) noexcept
+      : mColumn(column)
+      , mIndex(index)
+    {
+    }
+
+    sparse_column const * mColumn = nullptr;
+    size_type mIndex = 0;
+    // Index of the run in the current (sparse) chunk that contains mIndex or comes next after it.
+    size_type mRun = 0;
+  };
+
+
+private:
+  // Chooses the representation of a complete chunk that needs less memory.
+  static void EncodeChunk(Chunk & chunk)
+  {
+    if (chunk.isSparse) {
+      return;
+    }
+
+    std::vector<Run> runs;
+    std::uint32_t const numElements = static_cast<std::uint32_t>(chunk.dense.size());
+    std::uint32_t numValues = 0;
+    for (std::uint32_t offset = 0; offset < numElements; ++offset) {
+      if (chunk.dense[offset].has_value()) {
+        if (runs.empty() || runs.back().end != offset) {
+          runs.push_back(Run{offset, offset + 1, numValues});
+        }
+        else {
+          ++runs.back().end;
+        }
+        ++numValues;
+      }
+    }
+
+    std::size_t const denseBytes = numElements * sizeof(OptionalType);
+    std::size_t const sparseBytes = runs.size() * sizeof(Run) + chunk.numPresent * sizeof(payload_type);
+    if (sparseBytes >= denseBytes) {
+      chunk.dense.shrink_to_fit();
+      return;
+    }
+
+    std::vector<payload_type> values;
+    values.reserve(chunk.numPresent);
+    for (Run const & run : runs) {
+      for (std::uint32_t offset = run.begin; offset < run.end; ++offset) {
+        values.push_back(*chunk.dense[offset]);
+      }
+    }
+
+    runs.shrink_to_fit();
+    chunk.runs = std::move(runs);
+    chunk.values = std::move(values);
+    chunk.dense = std::vector<OptionalType>();
+    chunk.isSparse = true;
+  }
+
+  static void DecodeChunk(Chunk & chunk)
+  {
+    assert(chunk.isSparse);
+    std::vector<OptionalType> dense(chunkSize);
+    for (Run const & run : chunk.runs) {
+      for (std::uint32_t offset = run.begin; offset < run.end; ++offset) {
+        dense[offset] = chunk.values[run.firstValue + (offset - run.begin)];
+      }
+    }
+    chunk.dense = std::move(dense);
+    chunk.runs = std::vector<Run>();
+    chunk.values = std::vector<payload_type>();
+    chunk.isSparse = false;
+  }
+
+
+  std::vector<Chunk> mChunks;
+  size_type mSize = 0;
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
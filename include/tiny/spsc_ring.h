@@ -0,0 +1,171 @@
+#pragma once
+
+/*
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+------
+
+Original repository: https://github.com/Sedeniono/tiny-optional
+*/
+
+
+#include "atomic_optional.h"
+#include "optional.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+
+namespace tiny
+{
+TINY_OPTIONAL_INLINE_NS_BEGIN
+
+// A bounded single-producer/single-consumer queue. Classic designs keep a head and a tail index that both threads
+// read, so the cache lines with the indices bounce between the cores on every operation. Here, every slot is a
+// tiny::atomic_optional instead: An empty slot is free, a slot with a value is occupied. The producer and the consumer
+// merely poll the slot at their own private index and never read the index of the other thread ('FastForward'
+// design). Consequently, the same requirements as for tiny::atomic_optional apply to 'OptionalType': The empty state
+// must be a sentinel in the whole scalar payload, e.g. tiny::optional<T*> or tiny::optional<std::uint64_t, ~0ull>.
+// Values must not equal the sentinel (checked via assert()).
+//
+// try_push() and try_push_batch() may only be called by one thread at a time (the producer), try_pop() and
+// try_pop_batch() by another single thread (the consumer). Pushing a value releases it, popping it acquires it, so
+// that e.g. the object behind a pushed pointer is visible to the consumer.
+template <class OptionalType>
+class spsc_ring
+{
+private:
+  using Slot = atomic_optional<OptionalType>;
+
+  // Typical size of a cache line. std::hardware_destructive_interference_size is not used since it is not available
+  // everywhere and its value may change between compiler versions.
+  static constexpr std::size_t cCacheLineSize = 64;
+
+public:
+  using value_type = OptionalType;
+  using payload_type = typename OptionalType::value_type;
+  using size_type = std::size_t;
+
+  // The capacity is rounded up to the next power of 2.
+  explicit spsc_ring(size_type minCapacity)
+  {
+    size_type capacity = 1;
+    while (capacity < minCapacity) {
+      capacity *= 2;
+    }
+    mSlots = std::make_unique<Slot[]>(capacity);
+    mMask = capacity - 1;
+  }
+
+  spsc_ring(spsc_ring const &) = delete;
+  spsc_ring & operator=(spsc_ring const &) = delete;
+
+  [[nodiscard]] size_type capacity() const noexcept
+  {
+    return mMask + 1;
+  }
+
+  // Producer: Appends 'value' and returns true, or returns false if the queue is full.
+  bool try_push(payload_type const & value) noexcept
+  {
+    Slot & slot = mSlots[mProducerIndex & mMask];
+    if (slot.has_value(std::memory_order_acquire)) {
+      return false;
+    }
+    slot.store(value, std::memory_order_release);
+    ++mProducerIndex;
+    return true;
+  }
+
+  // Producer: Appends as many of the 'count' values as fit and returns how many were appended.
+  size_type try_push_batch(payload_type const * values, size_type count) noexcept
+  {
+    size_type const num = count < capacity() ? count : capacity();
+    if (num == 0) {
+      return 0;
+    }
+
+    // The occupied slots always form a contiguous range ending just before the producer index. Thus, if the last of
+    // the required slots is free, all the slots before it are free, too, and need not be checked individually.
+    if (!mSlots[(mProducerIndex + num - 1) & mMask].has_value(std::memory_order_acquire)) {
+      for (size_type i = 0; i < num; ++i) {
+        mSlots[(mProducerIndex + i) & mMask].store(values[i], std::memory_order_release);
+      }
+      mProducerIndex += num;
+      return num;
+    }
+
+    size_type numPushed = 0;
+    while (numPushed < num && try_push(values[numPushed])) {
+      ++numPushed;
+    }
+    return numPushed;
+  }
+
+  // Consumer: Removes and returns the oldest value, or returns an empty optional if the queue is empty.
+  [[nodiscard]] OptionalType try_pop() noexcept
+  {
+    Slot & slot = mSlots[mConsumerIndex & mMask];
+    OptionalType result = slot.load(std::memory_order_acquire);
+    if (result.has_value()) {
+      slot.store(OptionalType{}, std::memory_order_release);
+      ++mConsumerIndex;
+    }
+    return result;
+  }
+
+  // Consumer: Removes up to 'maxCount' values, writes them to 'out' and returns how many were removed.
+  size_type try_pop_batch(payload_type * out, size_type maxCount) noexcept
+  {
+    size_type numPopped = 0;
+    while (numPopped < maxCount && numPopped < capacity()) {
+      OptionalType const value = mSlots[(mConsumerIndex + numPopped) & mMask].load(std::memory_order_acquire);
+      if (!value.has_value()) {
+        break;
+      }
+      out[numPopped] = *value;
+      ++numPopped;
+    }
+
+    // Free the slots only after all values were read, so that the producer does not touch the cache lines meanwhile.
+    for (size_type i = 0; i < numPopped; ++i) {
+      mSlots[(mConsumerIndex + i) & mMask].store(OptionalType{}, std::memory_order_release);
+    }
+    mConsumerIndex += numPopped;
+    return numPopped;
+  }
+
+private:
+  std::unique_ptr<Slot[]> mSlots;
+  size_type mMask = 0;
+
+  // Only accessed by the producer and consumer thread, respectively. On separate cache lines to avoid false sharing.
+  alignas(cCacheLineSize) size_type mProducerIndex = 0;
+  alignas(cCacheLineSize) size_type mConsumerIndex = 0;
+};
+
+TINY_OPTIONAL_INLINE_NS_END
+} // namespace tiny
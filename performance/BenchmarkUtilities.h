@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#if defined(__clang__)
+  #define TINY_OPTIONAL_CLANG_BUILD
+#elif defined(__GNUC__) || defined(__GNUG__)
+  #define TINY_OPTIONAL_GCC_BUILD
+#elif defined(_MSC_VER)
+  #define TINY_OPTIONAL_MSVC_BUILD
+#else
+  #error Unknown compiler
+#endif
+
+
+#if defined(TINY_OPTIONAL_CLANG_BUILD) || defined(TINY_OPTIONAL_GCC_BUILD)
+  #define TINY_OPTIONAL_NO_INLINE __attribute__((noinline))
+#elif defined(TINY_OPTIONAL_MSVC_BUILD)
+  #define TINY_OPTIONAL_NO_INLINE __declspec(noinline)
+#else
+  #error Unknown compiler
+#endif
+
+
+inline std::string GetCompilerName()
+{
+#if defined(TINY_OPTIONAL_CLANG_BUILD)
+  return "clang";
+#elif defined(TINY_OPTIONAL_GCC_BUILD)
+  return "gcc";
+#elif defined(TINY_OPTIONAL_MSVC_BUILD)
+  return "msvc";
+#else
+  #error Unknown compiler
+#endif
+}
+
+
+// Calls 'func' 'numIterations' times and returns the average duration of one call in seconds.
+template <class Func>
+double MeasureSecondsPerCall(size_t numIterations, Func && func)
+{
+  auto const start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numIterations; ++i) {
+    func();
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+         / static_cast<double>(numIterations);
+}
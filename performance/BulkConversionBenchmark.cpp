@@ -0,0 +1,175 @@
+#include "BulkConversionBenchmark.h"
+
+#include "BenchmarkUtilities.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <tiny/bulk_conversions.h>
+#include <vector>
+
+
+namespace
+{
+// The naive loops that are typically written at API boundaries. Not inlined so that the measured code is the same as
+// in a real program where the conversion is not fused with whatever follows.
+template <class Source, class Destination>
+TINY_OPTIONAL_NO_INLINE void
+    NaiveConvertOptionals(std::vector<Source> const & source, std::vector<Destination> & destination)
+{
+  for (size_t i = 0; i < source.size(); ++i) {
+    if (source[i].has_value()) {
+      destination[i] = *source[i];
+    }
+    else {
+      destination[i] = std::nullopt;
+    }
+  }
+}
+
+
+template <class Optional, class T>
+TINY_OPTIONAL_NO_INLINE void NaiveToBitmap(
+    std::vector<Optional> const & source,
+    std::vector<T> & values,
+    std::vector<std::uint8_t> & bitmap)
+{
+  std::fill(bitmap.begin(), bitmap.end(), std::uint8_t{0});
+  for (size_t i = 0; i < source.size(); ++i) {
+    if (source[i].has_value()) {
+      values[i] = *source[i];
+      bitmap[i / 8] = static_cast<std::uint8_t>(bitmap[i / 8] | (1u << (i % 8)));
+    }
+    else {
+      values[i] = T{};
+    }
+  }
+}
+
+
+template <class Optional, class T>
+TINY_OPTIONAL_NO_INLINE void NaiveFromBitmap(
+    std::vector<T> const & values,
+    std::vector<std::uint8_t> const & bitmap,
+    std::vector<Optional> & destination)
+{
+  for (size_t i = 0; i < destination.size(); ++i) {
+    if ((bitmap[i / 8] >> (i % 8)) & 1u) {
+      destination[i] = values[i];
+    }
+    else {
+      destination[i] = std::nullopt;
+    }
+  }
+}
+
+
+template <class Source, class Destination>
+TINY_OPTIONAL_NO_INLINE void
+    BulkConvertOptionals(std::vector<Source> const & source, std::vector<Destination> & destination)
+{
+  tiny::convert_optionals(source.data(), source.size(), destination.data());
+}
+
+
+template <class Optional, class T>
+TINY_OPTIONAL_NO_INLINE void BulkToBitmap(
+    std::vector<Optional> const & source,
+    std::vector<T> & values,
+    std::vector<std::uint8_t> & bitmap)
+{
+  tiny::optionals_to_bitmap(source.data(), source.size(), values.data(), bitmap.data());
+}
+
+
+template <class Optional, class T>
+TINY_OPTIONAL_NO_INLINE void BulkFromBitmap(
+    std::vector<T> const & values,
+    std::vector<std::uint8_t> const & bitmap,
+    std::vector<Optional> & destination)
+{
+  tiny::optionals_from_bitmap(values.data(), bitmap.data(), destination.size(), destination.data());
+}
+
+
+void PrintResult(std::string const & name, double naiveSeconds, double bulkSeconds, size_t numValues)
+{
+  std::cout << std::setw(40) << std::left << name << std::right << std::setw(12) << std::setprecision(4)
+            << naiveSeconds / static_cast<double>(numValues) * 1e9 << std::setw(12)
+            << bulkSeconds / static_cast<double>(numValues) * 1e9 << std::setw(10) << std::setprecision(3)
+            << naiveSeconds / bulkSeconds << std::endl;
+}
+
+
+template <class TinyOptional, class ValueGenerator>
+void RunForType(std::string const & typeName, size_t numValues, size_t numIterations, ValueGenerator generator)
+{
+  using T = typename TinyOptional::value_type;
+
+  std::mt19937 rng(42);
+  std::vector<std::optional<T>> stdOptionals(numValues);
+  for (size_t i = 0; i < numValues; ++i) {
+    // 10% empty, at random positions so that branch prediction does not help the naive loops.
+    if (rng() % 10 != 0) {
+      stdOptionals[i] = generator(rng);
+    }
+  }
+
+  std::vector<TinyOptional> tinyOptionals(numValues);
+  std::vector<std::optional<T>> stdOptionalsOut(numValues);
+  std::vector<T> values(numValues);
+  std::vector<std::uint8_t> bitmap((numValues + 7) / 8);
+
+  auto const measure = [&](std::string const & name, auto naive, auto bulk) {
+    double const naiveSeconds = MeasureSecondsPerCall(numIterations, naive);
+    double const bulkSeconds = MeasureSecondsPerCall(numIterations, bulk);
+    PrintResult(typeName + ": " + name, naiveSeconds, bulkSeconds, numValues);
+  };
+
+  measure(
+      "std::optional -> tiny",
+      [&] { NaiveConvertOptionals(stdOptionals, tinyOptionals); },
+      [&] { BulkConvertOptionals(stdOptionals, tinyOptionals); });
+  measure(
+      "tiny -> values+bitmap",
+      [&] { NaiveToBitmap(tinyOptionals, values, bitmap); },
+      [&] { BulkToBitmap(tinyOptionals, values, bitmap); });
+  measure(
+      "values+bitmap -> tiny",
+      [&] { NaiveFromBitmap(values, bitmap, tinyOptionals); },
+      [&] { BulkFromBitmap(values, bitmap, tinyOptionals); });
+  measure(
+      "tiny -> std::optional",
+      [&] { NaiveConvertOptionals(tinyOptionals, stdOptionalsOut); },
+      [&] { BulkConvertOptionals(tinyOptionals, stdOptionalsOut); });
+
+  if (stdOptionalsOut != stdOptionals) {
+    std::cerr << "ERROR: Round trip for " << typeName << " failed." << std::endl;
+  }
+}
+} // namespace
+
+
+void RunBulkConversionBenchmark()
+{
+  static constexpr size_t cNumValues = 4'000'000;
+  static constexpr size_t cNumIterations = 50;
+
+  std::cout << "Bulk conversions of " << cNumValues << " optionals (10% empty)" << std::endl;
+  std::cout << std::setw(40) << std::left << "Conversion" << std::right << std::setw(12) << "naive[ns]"
+            << std::setw(12) << "bulk[ns]" << std::setw(10) << "speedup" << std::endl;
+
+  RunForType<tiny::optional<double>>("double", cNumValues, cNumIterations, [](std::mt19937 & rng) {
+    return static_cast<double>(rng()) * 0.25;
+  });
+  RunForType<tiny::optional<float>>("float", cNumValues, cNumIterations, [](std::mt19937 & rng) {
+    return static_cast<float>(rng() % 1000) * 0.5f;
+  });
+  RunForType<tiny::optional<std::int32_t, -1>>("int32_t, -1", cNumValues, cNumIterations, [](std::mt19937 & rng) {
+    return static_cast<std::int32_t>(rng() >> 1);
+  });
+}
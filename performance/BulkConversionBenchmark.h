@@ -0,0 +1,4 @@
+#pragma once
+
+// Compares the bulk conversions of tiny/bulk_conversions.h with naive element-wise loops.
+void RunBulkConversionBenchmark();
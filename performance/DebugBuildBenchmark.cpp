@@ -0,0 +1,107 @@
+#include "DebugBuildBenchmark.h"
+
+#include "BenchmarkUtilities.h"
+
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <tiny/optional.h>
+#include <vector>
+
+
+namespace
+{
+// The results are accumulated here so that the compiler cannot drop the loops as unused.
+volatile double gSink = 0;
+
+
+template <class Optional>
+TINY_OPTIONAL_NO_INLINE double CountHasValue(std::vector<Optional> const & values)
+{
+  double count = 0;
+  for (Optional const & o : values) {
+    if (o.has_value()) {
+      count += 1;
+    }
+  }
+  return count;
+}
+
+
+template <class Optional>
+TINY_OPTIONAL_NO_INLINE double SumViaDereference(std::vector<Optional> const & values)
+{
+  double sum = 0;
+  for (Optional const & o : values) {
+    if (o) {
+      sum += *o;
+    }
+  }
+  return sum;
+}
+
+
+template <class Optional>
+TINY_OPTIONAL_NO_INLINE double SumViaValueOr(std::vector<Optional> const & values)
+{
+  double sum = 0;
+  for (Optional const & o : values) {
+    sum += o.value_or(0.0);
+  }
+  return sum;
+}
+
+
+template <class Optional>
+void RunFor(char const * name, size_t numValues, size_t numIterations)
+{
+  // 10% of the values are empty.
+  std::mt19937 rng(42);
+  std::vector<Optional> values(numValues);
+  for (Optional & o : values) {
+    if (rng() % 10 != 0) {
+      o = static_cast<double>(rng() % 1000);
+    }
+  }
+
+  // Nanoseconds per element.
+  auto const measure = [numIterations, numValues](auto func) {
+    return MeasureSecondsPerCall(numIterations, [&func] { gSink = gSink + func(); }) / static_cast<double>(numValues)
+           * 1e9;
+  };
+  double const hasValue = measure([&] { return CountHasValue(values); });
+  double const dereference = measure([&] { return SumViaDereference(values); });
+  double const valueOr = measure([&] { return SumViaValueOr(values); });
+
+  std::cout << std::setprecision(4) << std::setw(24) << name << std::setw(12) << hasValue << std::setw(12)
+            << dereference << std::setw(12) << valueOr << std::endl;
+}
+} // namespace
+
+
+void RunDebugBuildBenchmark()
+{
+  static constexpr size_t cNumValues = 1'000'000;
+  static constexpr size_t cNumIterations = 20;
+
+#ifdef __OPTIMIZE__
+  char const * const optimizations = "enabled";
+#else
+  char const * const optimizations = "disabled";
+#endif
+#ifdef TINY_OPTIONAL_FORCE_INLINE_DEBUG
+  char const * const forceInline = "defined";
+#else
+  char const * const forceInline = "not defined";
+#endif
+
+  std::cout << "Basic operations on " << cNumValues << " optionals (10% empty). Optimizations: " << optimizations
+            << ", TINY_OPTIONAL_FORCE_INLINE_DEBUG: " << forceInline << ". Times in ns per element." << std::endl;
+  std::cout << std::setw(24) << "type" << std::setw(12) << "has_value" << std::setw(12) << "operator*" << std::setw(12)
+            << "value_or" << std::endl;
+
+  RunFor<tiny::optional<double>>("tiny::optional<double>", cNumValues, cNumIterations);
+  RunFor<tiny::optional<int, -1>>("tiny::optional<int, -1>", cNumValues, cNumIterations);
+  RunFor<std::optional<double>>("std::optional<double>", cNumValues, cNumIterations);
+}
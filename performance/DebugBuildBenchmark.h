@@ -0,0 +1,5 @@
+#pragma once
+
+// Measures the most basic operations of tiny::optional and std::optional, intended to be compiled without optimizations
+// to compare debug builds with and without TINY_OPTIONAL_FORCE_INLINE_DEBUG.
+void RunDebugBuildBenchmark();
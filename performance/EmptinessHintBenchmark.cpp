@@ -0,0 +1,126 @@
+#include "EmptinessHintBenchmark.h"
+
+#include "BenchmarkUtilities.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <tiny/optional.h>
+#include <vector>
+
+
+namespace
+{
+using Plain = tiny::optional<std::int32_t, -1>;
+using RarelyEmpty = tiny::optional_with_hint<Plain, tiny::emptiness_hint::rarely_empty>;
+using MostlyEmpty = tiny::optional_with_hint<Plain, tiny::emptiness_hint::mostly_empty>;
+
+volatile std::int64_t gSink = 0;
+
+
+// Stands in for some non-trivial handling of the empty case, e.g. logging or a lookup of a default.
+TINY_OPTIONAL_NO_INLINE std::int64_t HandleEmpty(std::int64_t index)
+{
+  return index & 7;
+}
+
+
+// Both branches contain some work, so that the compiler cannot simply replace the branch with a conditional move. The
+// hint then decides which of the two branches is placed on the fall-through path.
+template <class Optional>
+TINY_OPTIONAL_NO_INLINE std::int64_t SumWithBranch(std::vector<Optional> const & values)
+{
+  std::int64_t sum = 0;
+  std::int64_t index = 0;
+  for (Optional const & o : values) {
+    if (o.has_value()) {
+      sum += *o * 3 + (*o >> 2);
+    }
+    else {
+      sum += HandleEmpty(index);
+    }
+    ++index;
+  }
+  return sum;
+}
+
+
+template <class Optional>
+TINY_OPTIONAL_NO_INLINE std::int64_t SumWithTransform(std::vector<Optional> const & values)
+{
+  std::int64_t sum = 0;
+  for (Optional const & o : values) {
+    sum += o.transform([](std::int32_t v) { return static_cast<std::int64_t>(v) * 3 + (v >> 2); }).value_or(-1);
+  }
+  return sum;
+}
+
+
+template <class Optional>
+std::vector<Optional> Convert(std::vector<Plain> const & values)
+{
+  std::vector<Optional> result;
+  result.reserve(values.size());
+  for (Plain const & o : values) {
+    result.push_back(o.has_value() ? Optional(*o) : Optional());
+  }
+  return result;
+}
+
+
+void RunForEmptyRatio(double emptyRatio, size_t numValues, size_t numIterations)
+{
+  // The empty elements are distributed randomly, so the few unexpected ones are mispredicted.
+  std::mt19937 rng(42);
+  std::bernoulli_distribution isEmpty(emptyRatio);
+  std::vector<Plain> plain(numValues);
+  for (Plain & o : plain) {
+    if (!isEmpty(rng)) {
+      o = static_cast<std::int32_t>(rng() % 1000);
+    }
+  }
+  std::vector<RarelyEmpty> const rarely = Convert<RarelyEmpty>(plain);
+  std::vector<MostlyEmpty> const mostly = Convert<MostlyEmpty>(plain);
+
+  if (SumWithBranch(plain) != SumWithBranch(rarely) || SumWithBranch(plain) != SumWithBranch(mostly)
+      || SumWithTransform(plain) != SumWithTransform(rarely) || SumWithTransform(plain) != SumWithTransform(mostly)) {
+    std::cerr << "ERROR: hinted and plain optionals differ for empty ratio " << emptyRatio << std::endl;
+  }
+
+  // Nanoseconds per element.
+  auto const measure = [numIterations, numValues](auto func) {
+    return MeasureSecondsPerCall(numIterations, [&func] { gSink = gSink + func(); }) / static_cast<double>(numValues)
+           * 1e9;
+  };
+  double const branchNone = measure([&] { return SumWithBranch(plain); });
+  double const branchRarely = measure([&] { return SumWithBranch(rarely); });
+  double const branchMostly = measure([&] { return SumWithBranch(mostly); });
+  double const transformNone = measure([&] { return SumWithTransform(plain); });
+  double const transformRarely = measure([&] { return SumWithTransform(rarely); });
+  double const transformMostly = measure([&] { return SumWithTransform(mostly); });
+
+  std::cout << std::setprecision(4) << std::setw(7) << emptyRatio << std::setw(10) << branchNone << std::setw(10)
+            << branchRarely << std::setw(10) << branchMostly << std::setw(10) << transformNone << std::setw(10)
+            << transformRarely << std::setw(10) << transformMostly << std::endl;
+}
+} // namespace
+
+
+void RunEmptinessHintBenchmark()
+{
+  static constexpr size_t cNumValues = 1'000'000;
+  static constexpr size_t cNumIterations = 200;
+
+  std::cout << "tiny::optional<int32_t, -1> without hint vs. optional_with_hint with " << cNumValues
+            << " elements. Times in ns per element. With a matching hint, the common case is the fall-through path; "
+               "the hint cannot reduce the mispredictions of a random 50% ratio."
+            << std::endl;
+  std::cout << std::setw(7) << "empty" << std::setw(10) << "brNone" << std::setw(10) << "brRarely" << std::setw(10)
+            << "brMostly" << std::setw(10) << "trNone" << std::setw(10) << "trRarely" << std::setw(10) << "trMostly"
+            << std::endl;
+
+  for (double const emptyRatio : {0.001, 0.5, 0.999}) {
+    RunForEmptyRatio(emptyRatio, cNumValues, cNumIterations);
+  }
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Compares tiny::optional_with_hint (rarely_empty, mostly_empty) with the unhinted optional for skewed empty ratios.
+void RunEmptinessHintBenchmark();
@@ -0,0 +1,70 @@
+// Not a benchmark: check_codegen.sh compiles this file to assembly and inspects the code generated for has_value(),
+// value_or(), swap(), the comparisons and a conversion. The functions are extern "C" so that the script can find them
+// by name.
+
+#include <tiny/optional.h>
+
+#include <climits>
+
+extern "C"
+{
+  bool HasValueDouble(tiny::optional<double> const & o)
+  {
+    return o.has_value();
+  }
+
+  bool HasValueFloat(tiny::optional<float> const & o)
+  {
+    return o.has_value();
+  }
+
+  bool HasValueBool(tiny::optional<bool> const & o)
+  {
+    return o.has_value();
+  }
+
+  bool HasValuePointer(tiny::optional<int *> const & o)
+  {
+    return o.has_value();
+  }
+
+  double ValueOrDouble(tiny::optional<double> const & o, double defaultValue)
+  {
+    return o.value_or(defaultValue);
+  }
+
+  int * ValueOrPointer(tiny::optional<int *> const & o, int * defaultValue)
+  {
+    return o.value_or(defaultValue);
+  }
+
+  int ValueOrInt(tiny::optional<int, -1> const & o, int defaultValue)
+  {
+    return o.value_or(defaultValue);
+  }
+
+  void SwapDouble(tiny::optional<double> & lhs, tiny::optional<double> & rhs)
+  {
+    lhs.swap(rhs);
+  }
+
+  bool LessIntMin(tiny::optional<int, INT_MIN> const & lhs, tiny::optional<int, INT_MIN> const & rhs)
+  {
+    return lhs < rhs;
+  }
+
+  bool LessUnsignedMax(tiny::optional<unsigned, UINT_MAX> const & lhs, tiny::optional<unsigned, UINT_MAX> const & rhs)
+  {
+    return lhs < rhs;
+  }
+
+  bool EqualUnsignedMax(tiny::optional<unsigned, UINT_MAX> const & lhs, tiny::optional<unsigned, UINT_MAX> const & rhs)
+  {
+    return lhs == rhs;
+  }
+
+  tiny::optional<long long, -1> ConvertIntMinusOne(tiny::optional<int, -1> const & o)
+  {
+    return o;
+  }
+}
@@ -0,0 +1,165 @@
+#include "MpmcQueueBenchmark.h"
+
+#include "BenchmarkUtilities.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <tiny/mpmc_queue.h>
+#include <vector>
+
+
+namespace
+{
+using Optional = tiny::optional<std::uint64_t, ~0ull>;
+
+
+// The bounded MPMC queue by Dmitry Vyukov: Every slot stores a sequence counter next to the value, which tells
+// producers and consumers whether the slot is ready for them in the current round. Same interface as tiny::mpmc_queue.
+class VyukovQueue
+{
+public:
+  explicit VyukovQueue(size_t capacity)
+    : mSlots(std::make_unique<Slot[]>(capacity))
+    , mMask(capacity - 1)
+  {
+    for (size_t i = 0; i < capacity; ++i) {
+      mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool try_push(std::uint64_t value) noexcept
+  {
+    size_t pos = mEnqueueIndex.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot & slot = mSlots[pos & mMask];
+      size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (mEnqueueIndex.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0) {
+        return false;
+      }
+      else {
+        pos = mEnqueueIndex.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  Optional try_pop() noexcept
+  {
+    size_t pos = mDequeueIndex.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot & slot = mSlots[pos & mMask];
+      size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+      auto const diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (mDequeueIndex.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          std::uint64_t const value = slot.value;
+          slot.sequence.store(pos + mMask + 1, std::memory_order_release);
+          return value;
+        }
+      }
+      else if (diff < 0) {
+        return std::nullopt;
+      }
+      else {
+        pos = mDequeueIndex.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static constexpr size_t slotSize = 2 * sizeof(std::uint64_t);
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    std::uint64_t value;
+  };
+
+  std::unique_ptr<Slot[]> mSlots;
+  size_t const mMask;
+  alignas(64) std::atomic<size_t> mEnqueueIndex{0};
+  alignas(64) std::atomic<size_t> mDequeueIndex{0};
+};
+
+
+// Half of the threads push 'numValues' values in total, the other half pops them. Returns the nanoseconds per value.
+template <class Queue>
+double MeasureThroughput(size_t numThreads, std::uint64_t numValues)
+{
+  size_t const numProducers = numThreads > 1 ? numThreads / 2 : 1;
+  size_t const numConsumers = numThreads > 1 ? numThreads - numProducers : 1;
+  std::uint64_t const numValuesPerProducer = numValues / numProducers;
+  std::uint64_t const numValuesTotal = numValuesPerProducer * numProducers;
+
+  Queue queue(1024);
+  std::atomic<std::uint64_t> numReceived{0};
+  std::atomic<std::uint64_t> sum{0};
+  std::vector<std::thread> threads;
+  auto const start = std::chrono::steady_clock::now();
+
+  for (size_t p = 0; p < numProducers; ++p) {
+    threads.emplace_back([&, p] {
+      for (std::uint64_t i = 0; i < numValuesPerProducer; ++i) {
+        while (!queue.try_push(p * numValuesPerProducer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (size_t c = 0; c < numConsumers; ++c) {
+    threads.emplace_back([&] {
+      std::uint64_t localSum = 0;
+      while (numReceived.load(std::memory_order_relaxed) < numValuesTotal) {
+        if (Optional const value = queue.try_pop()) {
+          localSum += *value;
+          numReceived.fetch_add(1, std::memory_order_relaxed);
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+      sum += localSum;
+    });
+  }
+  for (std::thread & t : threads) {
+    t.join();
+  }
+
+  double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (sum != numValuesTotal * (numValuesTotal - 1) / 2) {
+    std::cerr << "ERROR: Wrong sum in the MPMC benchmark." << std::endl;
+  }
+  return seconds / static_cast<double>(numValuesTotal) * 1e9;
+}
+} // namespace
+
+
+void RunMpmcQueueBenchmark()
+{
+  static constexpr std::uint64_t cNumValues = 4'000'000;
+
+  std::cout << "MPMC queues with uint64_t payloads, capacity 1024, on " << std::thread::hardware_concurrency()
+            << " hardware threads. Slot size: Vyukov " << VyukovQueue::slotSize << " bytes, tiny "
+            << sizeof(tiny::atomic_optional<Optional>) << " bytes." << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(14) << "vyukov[ns]" << std::setw(14) << "tiny[ns]"
+            << std::setw(10) << "speedup" << std::endl;
+
+  for (size_t const numThreads : {1, 2, 4, 8, 16, 32, 64}) {
+    double const vyukov = MeasureThroughput<VyukovQueue>(numThreads, cNumValues);
+    double const tiny = MeasureThroughput<tiny::mpmc_queue<Optional>>(numThreads, cNumValues);
+    std::cout << std::setw(8) << numThreads << std::setw(14) << std::setprecision(4) << vyukov << std::setw(14)
+              << tiny << std::setw(10) << std::setprecision(3) << vyukov / tiny << std::endl;
+  }
+}
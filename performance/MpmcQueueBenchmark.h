@@ -0,0 +1,5 @@
+#pragma once
+
+// Compares tiny::mpmc_queue (tiny/mpmc_queue.h) with a Vyukov-style queue that stores a sequence counter per slot, for
+// varying numbers of threads.
+void RunMpmcQueueBenchmark();
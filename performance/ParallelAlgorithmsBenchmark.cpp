@@ -0,0 +1,108 @@
+#include "ParallelAlgorithmsBenchmark.h"
+
+#include "BenchmarkUtilities.h"
+
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <tiny/parallel_algorithms.h>
+#include <vector>
+
+
+namespace
+{
+// Keeps the results alive so that the compiler cannot drop the computations.
+volatile double gSink = 0;
+
+
+struct Data
+{
+  std::vector<tiny::optional<double>> tinyOptionals;
+  std::vector<std::optional<double>> stdOptionals;
+  std::vector<tiny::optional<double>> tinyDestination;
+  std::vector<std::optional<double>> stdDestination;
+  std::vector<double> values;
+  std::vector<std::size_t> indices;
+};
+
+
+// Returns the seconds per call for tiny::optional and std::optional.
+template <class Func>
+std::pair<double, double> Measure(size_t numIterations, Data & data, tiny::thread_pool & pool, Func const & func)
+{
+  return {
+      MeasureSecondsPerCall(numIterations, [&] { func(pool, data.tinyOptionals, data.tinyDestination); }),
+      MeasureSecondsPerCall(numIterations, [&] { func(pool, data.stdOptionals, data.stdDestination); })};
+}
+} // namespace
+
+
+void RunParallelAlgorithmsBenchmark()
+{
+  static constexpr size_t cNumValues = 16'000'000;
+  static constexpr size_t cNumIterations = 10;
+
+  Data data;
+  std::mt19937 rng(42);
+  data.tinyOptionals.resize(cNumValues);
+  data.stdOptionals.resize(cNumValues);
+  for (size_t i = 0; i < cNumValues; ++i) {
+    // 10% empty.
+    if (rng() % 10 != 0) {
+      data.tinyOptionals[i] = static_cast<double>(rng() % 1000);
+      data.stdOptionals[i] = *data.tinyOptionals[i];
+    }
+  }
+  data.tinyDestination.resize(cNumValues);
+  data.stdDestination.resize(cNumValues);
+  data.values.resize(cNumValues);
+  data.indices.resize(cNumValues);
+
+  unsigned const maxThreads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<unsigned> threadCounts;
+  for (unsigned n = 1; n < maxThreads; n *= 2) {
+    threadCounts.push_back(n);
+  }
+  threadCounts.push_back(maxThreads);
+
+  std::cout << "Parallel algorithms on " << cNumValues << " optionals (10% empty), up to " << maxThreads
+            << " threads. Throughput in elements per ns and in GB/s of the input array." << std::endl;
+  std::cout << std::setw(16) << std::left << "Algorithm" << std::right << std::setw(8) << "threads" << std::setw(12)
+            << "tiny[el/ns]" << std::setw(12) << "std[el/ns]" << std::setw(12) << "tiny[GB/s]" << std::setw(12)
+            << "std[GB/s]" << std::setw(10) << "speedup" << std::endl;
+
+  auto const report = [&](std::string const & name, auto const & func) {
+    for (unsigned const numThreads : threadCounts) {
+      tiny::thread_pool pool(numThreads);
+      auto const [tinySeconds, stdSeconds] = Measure(cNumIterations, data, pool, func);
+      double const tinyElementsPerNs = cNumValues / tinySeconds * 1e-9;
+      double const stdElementsPerNs = cNumValues / stdSeconds * 1e-9;
+      std::cout << std::setw(16) << std::left << name << std::right << std::setw(8) << numThreads
+                << std::setprecision(3) << std::setw(12) << tinyElementsPerNs << std::setw(12) << stdElementsPerNs
+                << std::setw(12) << tinyElementsPerNs * sizeof(tiny::optional<double>) << std::setw(12)
+                << stdElementsPerNs * sizeof(std::optional<double>) << std::setw(10) << stdSeconds / tinySeconds
+                << std::endl;
+    }
+  };
+
+  report("count_present", [](tiny::thread_pool & pool, auto const & source, auto &) {
+    gSink = gSink + static_cast<double>(tiny::parallel_count_present(pool, source.data(), source.size()));
+  });
+  report("reduce_present", [](tiny::thread_pool & pool, auto const & source, auto &) {
+    gSink = gSink + tiny::parallel_reduce_present(pool, source.data(), source.size(), 0.0, std::plus<>{});
+  });
+  report("transform", [](tiny::thread_pool & pool, auto const & source, auto & destination) {
+    tiny::parallel_transform_present(
+        pool, source.data(), source.size(), destination.data(), [](double v) { return v * 2.0; });
+  });
+  report("compact", [&data](tiny::thread_pool & pool, auto const & source, auto &) {
+    gSink = gSink
+            + static_cast<double>(tiny::parallel_compact(
+                pool, source.data(), source.size(), data.values.data(), data.indices.data()));
+  });
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Measures how the parallel algorithms of tiny/parallel_algorithms.h scale with the number of threads, for arrays of
+// tiny::optional<double> and std::optional<double>.
+void RunParallelAlgorithmsBenchmark();
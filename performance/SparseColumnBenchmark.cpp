@@ -0,0 +1,135 @@
+#include "SparseColumnBenchmark.h"
+
+#include "BenchmarkUtilities.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <tiny/optional.h>
+#include <tiny/sparse_column.h>
+#include <vector>
+
+
+namespace
+{
+using Optional = tiny::optional<double>;
+using Column = tiny::sparse_column<Optional>;
+
+// The sums are accumulated here so that the compiler cannot drop the summations as unused.
+volatile double gSink = 0;
+
+
+// Not inlined so that the summation is not fused with the generation of the data.
+TINY_OPTIONAL_NO_INLINE double SumDense(std::vector<Optional> const & dense)
+{
+  double sum = 0;
+  for (Optional const & o : dense) {
+    sum += o.value_or(0.0);
+  }
+  return sum;
+}
+
+
+TINY_OPTIONAL_NO_INLINE double SumSparseViaIterator(Column const & column)
+{
+  double sum = 0;
+  for (Optional const o : column) {
+    sum += o.value_or(0.0);
+  }
+  return sum;
+}
+
+
+TINY_OPTIONAL_NO_INLINE double SumSparseViaForEachPresent(Column const & column)
+{
+  double sum = 0;
+  column.for_each_present([&sum](size_t, double value) { sum += value; });
+  return sum;
+}
+
+
+template <class Container>
+TINY_OPTIONAL_NO_INLINE double SumRandomAccess(Container const & container, std::vector<std::uint32_t> const & indices)
+{
+  double sum = 0;
+  for (std::uint32_t const index : indices) {
+    sum += container[index].value_or(0.0);
+  }
+  return sum;
+}
+
+
+void RunForEmptyRatio(double emptyRatio, size_t numValues, size_t numIterations)
+{
+  // Empty elements come in long runs (mean length 1000, scaled by the ratio), which is typical for sensor data or
+  // sparse features. Runs of present values have a mean length of 1000 * (1 - emptyRatio) / emptyRatio.
+  std::mt19937 rng(42);
+  std::exponential_distribution<double> emptyRunLength(1.0 / 1000.0);
+  std::exponential_distribution<double> presentRunLength(emptyRatio > 0 ? emptyRatio / (1000.0 * (1.0 - emptyRatio))
+                                                                        : 1e-12);
+
+  std::vector<Optional> dense;
+  dense.reserve(numValues);
+  Column column;
+  bool present = emptyRatio < 1.0;
+  while (dense.size() < numValues) {
+    size_t const runLength = 1 + static_cast<size_t>(present ? presentRunLength(rng) : emptyRunLength(rng));
+    for (size_t i = 0; i < runLength && dense.size() < numValues; ++i) {
+      Optional const value = present ? Optional(static_cast<double>(rng() % 1000)) : Optional();
+      dense.push_back(value);
+      column.push_back(value);
+    }
+    present = emptyRatio > 0 ? !present : true;
+  }
+
+  std::vector<std::uint32_t> indices(numValues / 10);
+  for (std::uint32_t & index : indices) {
+    index = static_cast<std::uint32_t>(rng() % numValues);
+  }
+
+  double const expectedSum = SumDense(dense);
+  if (SumSparseViaIterator(column) != expectedSum || SumSparseViaForEachPresent(column) != expectedSum
+      || SumRandomAccess(column, indices) != SumRandomAccess(dense, indices)) {
+    std::cerr << "ERROR: sparse_column and dense vector differ for empty ratio " << emptyRatio << std::endl;
+  }
+
+  double const denseBytes = static_cast<double>(dense.capacity() * sizeof(Optional)) / numValues;
+  double const sparseBytes = static_cast<double>(column.memory_usage()) / numValues;
+  // Nanoseconds per visited element.
+  auto const measure = [numIterations](size_t numVisited, auto func) {
+    return MeasureSecondsPerCall(numIterations, [&func] { gSink = gSink + func(); }) / static_cast<double>(numVisited)
+           * 1e9;
+  };
+  double const denseSeq = measure(numValues, [&] { return SumDense(dense); });
+  double const sparseSeq = measure(numValues, [&] { return SumSparseViaIterator(column); });
+  double const sparseEach = measure(numValues, [&] { return SumSparseViaForEachPresent(column); });
+  double const denseRandom = measure(indices.size(), [&] { return SumRandomAccess(dense, indices); });
+  double const sparseRandom = measure(indices.size(), [&] { return SumRandomAccess(column, indices); });
+
+  size_t const numChunks = (numValues + Column::chunk_size - 1) / Column::chunk_size;
+  std::cout << std::setprecision(4) << std::setw(7) << emptyRatio << std::setw(10) << denseBytes << std::setw(10)
+            << sparseBytes << std::setw(8) << column.num_sparse_chunks() * 100 / numChunks
+            << std::setw(11) << denseSeq << std::setw(11) << sparseSeq << std::setw(11) << sparseEach << std::setw(11)
+            << denseRandom << std::setw(11) << sparseRandom << std::endl;
+}
+} // namespace
+
+
+void RunSparseColumnBenchmark()
+{
+  static constexpr size_t cNumValues = 4'000'000;
+  static constexpr size_t cNumIterations = 20;
+
+  std::cout << "Dense vector<tiny::optional<double>> vs. tiny::sparse_column with " << cNumValues
+            << " elements. Memory in bytes per element, times in ns per visited element. The random access "
+               "visits 1/10 of the elements."
+            << std::endl;
+  std::cout << std::setw(7) << "empty" << std::setw(10) << "dense[B]" << std::setw(10) << "sparse[B]" << std::setw(8)
+            << "sparse%" << std::setw(11) << "denseSeq" << std::setw(11) << "sparseIter" << std::setw(11)
+            << "sparseEach" << std::setw(11) << "denseRand" << std::setw(11) << "sparseRand" << std::endl;
+
+  for (double const emptyRatio : {0.0, 0.5, 0.9, 0.95, 0.99, 0.999}) {
+    RunForEmptyRatio(emptyRatio, cNumValues, cNumIterations);
+  }
+}
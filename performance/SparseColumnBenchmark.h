@@ -0,0 +1,4 @@
+#pragma once
+
+// Compares tiny/sparse_column.h with a dense vector of optionals for a sweep of empty-element ratios.
+void RunSparseColumnBenchmark();
@@ -0,0 +1,222 @@
+#include "SpscRingBenchmark.h"
+
+#include "BenchmarkUtilities.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tiny/spsc_ring.h>
+#include <vector>
+
+
+namespace
+{
+using Optional = tiny::optional<std::uint64_t, ~0ull>;
+
+
+// The classic design (Lamport): The producer publishes its head index, the consumer its tail index, and both threads
+// read the index of the other one on every operation. Same interface as tiny::spsc_ring.
+class HeadTailRing
+{
+public:
+  explicit HeadTailRing(size_t capacity)
+    : mValues(std::make_unique<std::uint64_t[]>(capacity))
+    , mMask(capacity - 1)
+  {
+  }
+
+  bool try_push(std::uint64_t value) noexcept
+  {
+    size_t const head = mHead.load(std::memory_order_relaxed);
+    if (head - mTail.load(std::memory_order_acquire) > mMask) {
+      return false;
+    }
+    mValues[head & mMask] = value;
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t try_push_batch(std::uint64_t const * values, size_t count) noexcept
+  {
+    size_t const head = mHead.load(std::memory_order_relaxed);
+    size_t const numFree = mMask + 1 - (head - mTail.load(std::memory_order_acquire));
+    size_t const num = count < numFree ? count : numFree;
+    for (size_t i = 0; i < num; ++i) {
+      mValues[(head + i) & mMask] = values[i];
+    }
+    mHead.store(head + num, std::memory_order_release);
+    return num;
+  }
+
+  Optional try_pop() noexcept
+  {
+    size_t const tail = mTail.load(std::memory_order_relaxed);
+    if (tail == mHead.load(std::memory_order_acquire)) {
+      return std::nullopt;
+    }
+    Optional const result = mValues[tail & mMask];
+    mTail.store(tail + 1, std::memory_order_release);
+    return result;
+  }
+
+  size_t try_pop_batch(std::uint64_t * out, size_t maxCount) noexcept
+  {
+    size_t const tail = mTail.load(std::memory_order_relaxed);
+    size_t const numAvailable = mHead.load(std::memory_order_acquire) - tail;
+    size_t const num = maxCount < numAvailable ? maxCount : numAvailable;
+    for (size_t i = 0; i < num; ++i) {
+      out[i] = mValues[(tail + i) & mMask];
+    }
+    mTail.store(tail + num, std::memory_order_release);
+    return num;
+  }
+
+private:
+  std::unique_ptr<std::uint64_t[]> mValues;
+  size_t const mMask;
+  alignas(64) std::atomic<size_t> mHead{0};
+  alignas(64) std::atomic<size_t> mTail{0};
+};
+
+
+// Transfers 'numValues' values from a producer to a consumer thread and returns the nanoseconds per value. With
+// 'batchSize' > 1 the batched functions are used.
+template <class Ring>
+double MeasureThroughput(size_t numValues, size_t batchSize)
+{
+  Ring ring(1024);
+  std::uint64_t sum = 0;
+  auto const start = std::chrono::steady_clock::now();
+
+  std::thread consumer([&] {
+    std::vector<std::uint64_t> out(batchSize);
+    size_t numReceived = 0;
+    while (numReceived < numValues) {
+      if (batchSize == 1) {
+        if (Optional const value = ring.try_pop()) {
+          sum += *value;
+          ++numReceived;
+        }
+        else {
+          std::this_thread::yield();
+        }
+      }
+      else {
+        size_t const num = ring.try_pop_batch(out.data(), batchSize);
+        if (num == 0) {
+          std::this_thread::yield();
+        }
+        for (size_t i = 0; i < num; ++i) {
+          sum += out[i];
+        }
+        numReceived += num;
+      }
+    }
+  });
+
+  std::vector<std::uint64_t> batch(batchSize);
+  std::uint64_t next = 0;
+  while (next < numValues) {
+    if (batchSize == 1) {
+      if (ring.try_push(next)) {
+        ++next;
+      }
+      else {
+        std::this_thread::yield();
+      }
+    }
+    else {
+      size_t num = 0;
+      for (; num < batchSize && next + num < numValues; ++num) {
+        batch[num] = next + num;
+      }
+      size_t const numPushed = ring.try_push_batch(batch.data(), num);
+      if (numPushed == 0) {
+        std::this_thread::yield();
+      }
+      next += numPushed;
+    }
+  }
+  consumer.join();
+
+  double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (sum != numValues * (numValues - 1) / 2) {
+    std::cerr << "ERROR: Wrong sum in the SPSC benchmark." << std::endl;
+  }
+  return seconds / static_cast<double>(numValues) * 1e9;
+}
+
+
+// Sends a value back and forth between two threads via two rings and returns the nanoseconds per round trip.
+template <class Ring>
+double MeasureRoundTripLatency(size_t numRoundTrips)
+{
+  Ring toEcho(1024);
+  Ring fromEcho(1024);
+
+  std::thread echo([&] {
+    for (size_t i = 0; i < numRoundTrips; ++i) {
+      Optional value;
+      while (!(value = toEcho.try_pop())) {
+        std::this_thread::yield();
+      }
+      while (!fromEcho.try_push(*value + 1)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  auto const start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < numRoundTrips; ++i) {
+    while (!toEcho.try_push(i)) {
+      std::this_thread::yield();
+    }
+    Optional value;
+    while (!(value = fromEcho.try_pop())) {
+      std::this_thread::yield();
+    }
+    if (*value != i + 1) {
+      std::cerr << "ERROR: Wrong value in the SPSC latency benchmark." << std::endl;
+    }
+  }
+  double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  echo.join();
+  return seconds / static_cast<double>(numRoundTrips) * 1e9;
+}
+
+
+void PrintResult(std::string const & name, double headTail, double tiny)
+{
+  std::cout << std::setw(28) << std::left << name << std::right << std::setw(14) << std::setprecision(4) << headTail
+            << std::setw(14) << tiny << std::setw(10) << std::setprecision(3) << headTail / tiny << std::endl;
+}
+} // namespace
+
+
+void RunSpscRingBenchmark()
+{
+  static constexpr size_t cNumValues = 20'000'000;
+  static constexpr size_t cNumRoundTrips = 200'000;
+
+  std::cout << "SPSC queues with uint64_t payloads, capacity 1024, on " << std::thread::hardware_concurrency()
+            << " hardware threads. Note: The results are only meaningful if both threads run on separate cores."
+            << std::endl;
+  std::cout << std::setw(28) << std::left << "Measurement" << std::right << std::setw(14) << "headTail[ns]"
+            << std::setw(14) << "tiny[ns]" << std::setw(10) << "speedup" << std::endl;
+
+  for (size_t const batchSize : {1, 8, 64}) {
+    PrintResult(
+        "Throughput, batch " + std::to_string(batchSize),
+        MeasureThroughput<HeadTailRing>(cNumValues, batchSize),
+        MeasureThroughput<tiny::spsc_ring<Optional>>(cNumValues, batchSize));
+  }
+  PrintResult(
+      "Round-trip latency",
+      MeasureRoundTripLatency<HeadTailRing>(cNumRoundTrips),
+      MeasureRoundTripLatency<tiny::spsc_ring<Optional>>(cNumRoundTrips));
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// Compares tiny::spsc_ring (tiny/spsc_ring.h) with a classic single-producer/single-consumer queue that uses a head
+// and a tail index, regarding throughput and round-trip latency.
+void RunSpscRingBenchmark();
@@ -0,0 +1,55 @@
+#!/bin/bash
+
+# Checks the x64 assembly generated for HasValueCodegen.cpp:
+# - Without optimizations, there must not be any call to memcmp or memcpy.
+# - With optimizations, each has_value() function must consist of a single 'cmp' and no calls.
+# - With optimizations, the value_or(), swap(), comparison and conversion functions must not contain any jumps or calls.
+# Usage: ./check_codegen.sh g++
+#        ./check_codegen.sh clang++
+
+CXX=${1:-g++}
+FUNCTIONS=(HasValueDouble HasValueFloat HasValueBool HasValuePointer)
+BRANCHLESS_FUNCTIONS=(ValueOrDouble ValueOrPointer ValueOrInt SwapDouble LessIntMin LessUnsignedMax EqualUnsignedMax
+    ConvertIntMinusOne)
+failed=0
+
+for std in c++17 c++20; do
+    asm=$($CXX -std=$std -O0 -I../include -S -o - HasValueCodegen.cpp) || exit 1
+    if echo "$asm" | grep -qE "call.*(memcmp|memcpy)"; then
+        echo "FAILED: $CXX -std=$std -O0 calls memcmp or memcpy"
+        failed=1
+    else
+        echo "OK:     $CXX -std=$std -O0 does not call memcmp or memcpy"
+    fi
+
+    for opt in -O1 -O2 -O3; do
+        asm=$($CXX -std=$std $opt -DNDEBUG -I../include -S -o - HasValueCodegen.cpp) || exit 1
+        for func in "${FUNCTIONS[@]}"; do
+            # The instructions between the label of the function and its end.
+            body=$(echo "$asm" | sed -n "/^$func:/,/\.cfi_endproc/p" | grep -E "^\s+[a-z]" | grep -vE "^\s+\.")
+            numCmp=$(echo "$body" | grep -cE "^\s+cmp")
+            numCall=$(echo "$body" | grep -cE "^\s+(call|jmp)")
+            if [ "$numCmp" -ne 1 ] || [ "$numCall" -ne 0 ]; then
+                echo "FAILED: $CXX -std=$std $opt: $func has $numCmp cmp and $numCall calls:"
+                echo "$body"
+                failed=1
+            else
+                echo "OK:     $CXX -std=$std $opt: $func"
+            fi
+        done
+
+        for func in "${BRANCHLESS_FUNCTIONS[@]}"; do
+            body=$(echo "$asm" | sed -n "/^$func:/,/\.cfi_endproc/p" | grep -E "^\s+[a-z]" | grep -vE "^\s+\.")
+            numJumpOrCall=$(echo "$body" | grep -cE "^\s+(j|call)")
+            if [ "$numJumpOrCall" -ne 0 ]; then
+                echo "FAILED: $CXX -std=$std $opt: $func has $numJumpOrCall jumps or calls:"
+                echo "$body"
+                failed=1
+            else
+                echo "OK:     $CXX -std=$std $opt: $func"
+            fi
+        done
+    done
+done
+
+exit $failed
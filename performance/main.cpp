@@ -1,3 +1,12 @@
+#include "BenchmarkUtilities.h"
+#include "BulkConversionBenchmark.h"
+#include "SparseColumnBenchmark.h"
+#include "SpscRingBenchmark.h"
+#include "MpmcQueueBenchmark.h"
+#include "ParallelAlgorithmsBenchmark.h"
+#include "DebugBuildBenchmark.h"
+#include "EmptinessHintBenchmark.h"
+
 #include <chrono>
 #include <fstream>
 #include <iomanip>
@@ -9,25 +18,6 @@
 #include <tiny/optional.h>
 #include <vector>
 
-#if defined(__clang__)
-  #define TINY_OPTIONAL_CLANG_BUILD
-#elif defined(__GNUC__) || defined(__GNUG__)
-  #define TINY_OPTIONAL_GCC_BUILD
-#elif defined(_MSC_VER)
-  #define TINY_OPTIONAL_MSVC_BUILD
-#else
-  #error Unknown compiler
-#endif
-
-
-#if defined(TINY_OPTIONAL_CLANG_BUILD) || defined(TINY_OPTIONAL_GCC_BUILD)
-  #define TINY_OPTIONAL_NO_INLINE __attribute__((noinline))
-#elif defined(TINY_OPTIONAL_MSVC_BUILD)
-  #define TINY_OPTIONAL_NO_INLINE __declspec(noinline)
-#else
-  #error Unknown compiler
-#endif
- 
 
 template <class T>
 constexpr T Sqr(T v)
@@ -202,25 +192,56 @@ std::string CreatePrintableResultString(std::vector<Result> const & results)
 }
 
 
-std::string GetCompilerName()
-{
-#if defined(TINY_OPTIONAL_CLANG_BUILD)
-  return "clang";
-#elif defined(TINY_OPTIONAL_GCC_BUILD)
-  return "gcc";
-#elif defined(TINY_OPTIONAL_MSVC_BUILD)
-  return "msvc";
-#else
-  #error Unknown compiler
-#endif
-}
-
-
-int main()
+int main(int argc, char * argv[])
 {
   std::string const compilerName = GetCompilerName();
   std::cout << "Running tests on compiler: " << compilerName << std::endl;
 
+  // By default, the original WeirdVector benchmark runs. Other benchmarks can be selected via the first argument.
+  std::string const mode = argc > 1 ? argv[1] : "";
+  if (mode == "bulk") {
+    RunBulkConversionBenchmark();
+    return 0;
+  }
+  else if (mode == "sparse") {
+    RunSparseColumnBenchmark();
+    return 0;
+  }
+  else if (mode == "spsc") {
+    RunSpscRingBenchmark();
+    return 0;
+  }
+  else if (mode == "mpmc") {
+    RunMpmcQueueBenchmark();
+    return 0;
+  }
+  else if (mode == "parallel") {
+    RunParallelAlgorithmsBenchmark();
+    return 0;
+  }
+  else if (mode == "debug") {
+    RunDebugBuildBenchmark();
+    return 0;
+  }
+  else if (mode == "nulls") {
+    // Every second optional is empty in random order, so that branches on has_value() are mispredicted frequently.
+    std::vector<Result> const results = RunMultipleTests(
+        {2}, {{1024, 2000000}, {8192, 300000}, {131072, 20000}, {1048576, 1000}, {10000000, 100}});
+    std::cout << std::endl;
+    std::cout << "========= Summary for " << compilerName << " (50% nullopt) =========" << std::endl;
+    std::cout << CreatePrintableResultString(results);
+    return 0;
+  }
+  else if (mode == "hints") {
+    RunEmptinessHintBenchmark();
+    return 0;
+  }
+  else if (!mode.empty()) {
+    std::cerr << "Unknown benchmark '" << mode
+              << "'. Available: bulk, sparse, spsc, mpmc, parallel, debug, nulls, hints" << std::endl;
+    return 1;
+  }
+
   // clang-format off
   std::vector<Result> results = RunMultipleTests(
       {8192}, // Most optionals have a value ==> branch prediction is correct in most cases
@@ -0,0 +1,165 @@
+#include "AsyncSlotTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/optional.h"
+
+#if defined(TINY_OPTIONAL_CPP20) && defined(__cpp_impl_coroutine)
+  #define TINY_OPTIONAL_TESTS_HAVE_COROUTINES
+  #include "tiny/async_slot.h"
+
+  #include <atomic>
+  #include <coroutine>
+  #include <cstdint>
+  #include <exception>
+  #include <memory>
+  #include <thread>
+  #include <vector>
+#endif
+
+
+#ifdef TINY_OPTIONAL_TESTS_HAVE_COROUTINES
+namespace
+{
+// Minimal eagerly started coroutine type whose frame destroys itself when it finishes.
+struct FireAndForget
+{
+  struct promise_type
+  {
+    FireAndForget get_return_object() noexcept
+    {
+      return {};
+    }
+    std::suspend_never initial_suspend() noexcept
+    {
+      return {};
+    }
+    std::suspend_never final_suspend() noexcept
+    {
+      return {};
+    }
+    void return_void() noexcept { }
+    void unhandled_exception() noexcept
+    {
+      std::terminate();
+    }
+  };
+};
+
+
+template <class SlotT, class ResultT>
+FireAndForget AwaitInto(SlotT const & slot, ResultT & result, std::atomic<int> & numDone)
+{
+  result = co_await slot;
+  numDone.fetch_add(1);
+}
+
+
+FireAndForget AwaitTwiceAndDestroySlot(std::unique_ptr<tiny::async_slot<tiny::optional<int, -1>>> & slot, int & sum)
+{
+  int const first = co_await *slot;
+  int const second = co_await *slot; // Already ready, does not suspend.
+  sum = first + second;
+  slot.reset();
+}
+} // namespace
+#endif
+
+
+void test_AsyncSlot()
+{
+#ifdef TINY_OPTIONAL_TESTS_HAVE_COROUTINES
+  using SlotT = tiny::async_slot<tiny::optional<std::uint64_t, ~std::uint64_t{0}>>;
+  static_assert(sizeof(SlotT) == 2 * sizeof(void *));
+
+  // Synchronous access.
+  {
+    SlotT slot;
+    ASSERT_FALSE(slot.is_ready());
+    ASSERT_FALSE(slot.try_get().has_value());
+    ASSERT_TRUE(slot.emplace(42));
+    ASSERT_TRUE(slot.is_ready());
+    ASSERT_TRUE(slot.try_get() == 42u);
+    ASSERT_FALSE(slot.emplace(43));
+    ASSERT_TRUE(slot.try_get() == 42u);
+  }
+
+  // Awaiting a slot that is already ready does not suspend.
+  {
+    SlotT slot;
+    slot.emplace(7);
+    std::uint64_t result = 0;
+    std::atomic<int> numDone{0};
+    AwaitInto(slot, result, numDone);
+    ASSERT_TRUE(numDone == 1);
+    ASSERT_TRUE(result == 7u);
+  }
+
+  // Several waiters are suspended until the value is emplaced, and then all get resumed.
+  {
+    SlotT slot;
+    std::vector<std::uint64_t> results(5, 0);
+    std::atomic<int> numDone{0};
+    for (auto & result : results) {
+      AwaitInto(slot, result, numDone);
+    }
+    ASSERT_TRUE(numDone == 0);
+    ASSERT_TRUE(slot.emplace(123));
+    ASSERT_TRUE(numDone == 5);
+    for (auto const result : results) {
+      ASSERT_TRUE(result == 123u);
+    }
+
+    // Waiters arriving later see the value immediately.
+    std::uint64_t late = 0;
+    AwaitInto(slot, late, numDone);
+    ASSERT_TRUE(numDone == 6);
+    ASSERT_TRUE(late == 123u);
+  }
+
+  // A resumed coroutine may destroy the slot.
+  {
+    auto slot = std::make_unique<tiny::async_slot<tiny::optional<int, -1>>>();
+    int sum = 0;
+    AwaitTwiceAndDestroySlot(slot, sum);
+    ASSERT_TRUE(slot != nullptr);
+    slot->emplace(21);
+    ASSERT_TRUE(slot == nullptr);
+    ASSERT_TRUE(sum == 42);
+  }
+
+  // A resumed coroutine destroys the slot while another waiter is still queued. The waiters are resumed in reverse
+  // order, so the destroying coroutine is resumed first.
+  {
+    auto slot = std::make_unique<tiny::async_slot<tiny::optional<int, -1>>>();
+    int result = 0;
+    std::atomic<int> numDone{0};
+    AwaitInto(*slot, result, numDone);
+    int sum = 0;
+    AwaitTwiceAndDestroySlot(slot, sum);
+    slot->emplace(21);
+    ASSERT_TRUE(slot == nullptr);
+    ASSERT_TRUE(sum == 42);
+    ASSERT_TRUE(numDone == 1);
+    ASSERT_TRUE(result == 21);
+  }
+
+  // Value emplaced by another thread while coroutines start waiting concurrently.
+  {
+    for (int iteration = 0; iteration < 50; ++iteration) {
+      SlotT slot;
+      constexpr int numWaiters = 100;
+      std::vector<std::uint64_t> results(numWaiters, 0);
+      std::atomic<int> numDone{0};
+      std::thread producer([&slot]() { slot.emplace(99); });
+      for (auto & result : results) {
+        AwaitInto(slot, result, numDone);
+      }
+      producer.join();
+      ASSERT_TRUE(numDone == numWaiters);
+      for (auto const result : results) {
+        ASSERT_TRUE(result == 99u);
+      }
+    }
+  }
+#endif
+}
@@ -0,0 +1,133 @@
+#include "AtomicOptionalTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/atomic_optional.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+template <class OptionalType, class PayloadType>
+void TestSingleThreaded(PayloadType const & value1, PayloadType const & value2)
+{
+  tiny::atomic_optional<OptionalType> a;
+  static_assert(sizeof(a) == sizeof(OptionalType));
+  ASSERT_FALSE(a.has_value());
+  ASSERT_FALSE(a.load().has_value());
+
+  ASSERT_TRUE(a.try_emplace(value1));
+  ASSERT_FALSE(a.try_emplace(value2));
+  ASSERT_TRUE(a.has_value(std::memory_order_acquire));
+  ASSERT_TRUE(a.load(std::memory_order_relaxed) == value1);
+
+  a.store(value2, std::memory_order_release);
+  ASSERT_TRUE(a.load() == value2);
+  ASSERT_TRUE(a.exchange(OptionalType{}) == value2);
+  ASSERT_FALSE(a.has_value());
+  ASSERT_TRUE(a.exchange(value1) == OptionalType{});
+
+  ASSERT_TRUE(a.take() == value1);
+  ASSERT_FALSE(a.take().has_value());
+
+  // Compare-exchange, including empty states on both sides.
+  OptionalType expected = value1;
+  ASSERT_FALSE(a.compare_exchange_strong(expected, value2));
+  ASSERT_FALSE(expected.has_value());
+  ASSERT_TRUE(a.compare_exchange_strong(expected, value2, std::memory_order_acq_rel, std::memory_order_acquire));
+  ASSERT_TRUE(a.load() == value2);
+  expected = value2;
+  while (!a.compare_exchange_weak(expected, OptionalType{})) {
+    ASSERT_TRUE(expected == value2);
+  }
+  ASSERT_FALSE(a.has_value());
+
+  tiny::atomic_optional<OptionalType> const initialized(OptionalType{value1});
+  ASSERT_TRUE(initialized.load() == value1);
+}
+} // namespace
+
+
+void test_AtomicOptional()
+{
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  static_assert(tiny::atomic_optional<tiny::optional<double>>::is_always_lock_free);
+#endif
+  static_assert(tiny::atomic_optional<tiny::optional<std::uint64_t, ~0ull>>::is_always_lock_free);
+
+  TestSingleThreaded<tiny::optional<int, -1>>(0, 42);
+  TestSingleThreaded<tiny::optional<std::uint64_t, ~0ull>>(std::uint64_t{0}, std::uint64_t{1} << 63);
+#ifdef TINY_OPTIONAL_CPP20
+  TestSingleThreaded<tiny::optional<double, 0.0>>(1.0, 2.0);
+#endif
+  TestSingleThreaded<tiny::optional_aip<std::int16_t>>(std::int16_t{0}, std::int16_t{-5});
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  int dummy1 = 0;
+  int dummy2 = 0;
+  TestSingleThreaded<tiny::optional<double>>(1.5, -0.0);
+  TestSingleThreaded<tiny::optional<float>>(1.5f, 0.0f);
+  TestSingleThreaded<tiny::optional<bool>>(true, false);
+  TestSingleThreaded<tiny::optional<int *>>(&dummy1, &dummy2);
+#endif
+
+  // Only one of several racing threads succeeds to emplace.
+  {
+    tiny::atomic_optional<tiny::optional<int, -1>> a;
+    std::atomic<int> numSucceeded{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&, i] {
+        if (a.try_emplace(i, std::memory_order_acq_rel)) {
+          ++numSucceeded;
+        }
+      });
+    }
+    for (std::thread & t : threads) {
+      t.join();
+    }
+    ASSERT_TRUE(numSucceeded == 1);
+    ASSERT_TRUE(a.has_value());
+  }
+
+  // Concurrent read-modify-write loops via compare_exchange_weak, starting from the empty state.
+  {
+    constexpr int numThreads = 4;
+    constexpr int numIncrements = 10000;
+    tiny::atomic_optional<tiny::optional<int, -1>> sum;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+      threads.emplace_back([&] {
+        for (int j = 0; j < numIncrements; ++j) {
+          tiny::optional<int, -1> expected = sum.load(std::memory_order_relaxed);
+          while (!sum.compare_exchange_weak(expected, expected.value_or(0) + 1, std::memory_order_relaxed)) {
+          }
+        }
+      });
+    }
+    for (std::thread & t : threads) {
+      t.join();
+    }
+    ASSERT_TRUE(sum.load() == numThreads * numIncrements);
+  }
+
+#ifdef TINY_OPTIONAL_CPP20
+  // Publishing a result to a waiting thread.
+  {
+    tiny::atomic_optional<tiny::optional<int, -1>> result;
+    int received = 0;
+    std::thread consumer([&] { received = result.wait_for_value(std::memory_order_acquire); });
+    ASSERT_TRUE(result.try_emplace(42, std::memory_order_release));
+    result.notify_all();
+    consumer.join();
+    ASSERT_TRUE(received == 42);
+
+    std::thread waiter([&] { result.wait(42); });
+    result.store(43);
+    result.notify_one();
+    waiter.join();
+  }
+#endif
+}
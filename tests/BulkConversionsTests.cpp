@@ -0,0 +1,184 @@
+#include "BulkConversionsTests.h"
+
+#include "TestTypes.h"
+#include "TestUtilities.h"
+#include "tiny/bulk_conversions.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+struct NegativeZeroSentinel
+{
+  static constexpr double value = -0.0;
+};
+
+
+// Creates 'count' std::optionals where every third one is empty.
+template <class T, class ValueGenerator>
+std::vector<std::optional<T>> CreateStdOptionals(std::size_t count, ValueGenerator generator)
+{
+  std::vector<std::optional<T>> result(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % 3 != 1) {
+      result[i] = generator(i);
+    }
+  }
+  return result;
+}
+
+
+template <class TinyOptional, class ValueGenerator>
+void CheckRoundTrips(ValueGenerator generator)
+{
+  using T = typename TinyOptional::value_type;
+
+  // Covers an empty input, inputs not filling a whole bitmap byte and inputs with and without remainder.
+  for (std::size_t const count : {0u, 1u, 7u, 8u, 9u, 17u, 64u, 100u}) {
+    std::vector<std::optional<T>> const original = CreateStdOptionals<T>(count, generator);
+
+    // std::optional -> tiny
+    std::vector<TinyOptional> tiny(count, generator(0));
+    tiny::convert_optionals(original.data(), count, tiny.data());
+    for (std::size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(tiny[i] == original[i]);
+    }
+
+    // tiny -> bitmap
+    // Note: Not a std::vector because of std::vector<bool>.
+    std::unique_ptr<T[]> const values(new T[count]);
+    std::vector<std::uint8_t> bitmap((count + 7) / 8, 0xff);
+    tiny::optionals_to_bitmap(tiny.data(), count, values.get(), bitmap.data());
+    for (std::size_t i = 0; i < count; ++i) {
+      bool const bit = ((bitmap[i / 8] >> (i % 8)) & 1u) != 0;
+      ASSERT_TRUE(bit == original[i].has_value());
+      ASSERT_TRUE(bit ? values[i] == *original[i] : values[i] == T{});
+    }
+    if (count % 8 != 0) {
+      ASSERT_TRUE((bitmap.back() >> (count % 8)) == 0);
+    }
+
+    // bitmap -> tiny
+    std::vector<TinyOptional> fromBitmap(count);
+    tiny::optionals_from_bitmap(values.get(), bitmap.data(), count, fromBitmap.data());
+    for (std::size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(fromBitmap[i] == original[i]);
+    }
+
+    // tiny -> std::optional
+    std::vector<std::optional<T>> backToStd(count, generator(0));
+    tiny::convert_optionals(fromBitmap.data(), count, backToStd.data());
+    ASSERT_TRUE(backToStd == original);
+
+    // std::optional <-> bitmap
+    std::unique_ptr<T[]> const stdValues(new T[count]);
+    std::vector<std::uint8_t> stdBitmap((count + 7) / 8);
+    tiny::optionals_to_bitmap(original.data(), count, stdValues.get(), stdBitmap.data());
+    for (std::size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(stdValues[i] == values[i]);
+    }
+    ASSERT_TRUE(stdBitmap == bitmap);
+    std::vector<std::optional<T>> stdFromBitmap(count);
+    tiny::optionals_from_bitmap(stdValues.get(), stdBitmap.data(), count, stdFromBitmap.data());
+    ASSERT_TRUE(stdFromBitmap == original);
+  }
+}
+} // namespace
+
+
+void test_BulkConversions()
+{
+  // Selection of the vectorizable implementation.
+  {
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional<int, -1>>::isVectorizable);
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional_aip<std::uint64_t>>::isVectorizable);
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional<ScopedEnum, ScopedEnum::vend>>::isVectorizable);
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional<char, 'z'>>::isVectorizable);
+    static_assert(
+        tiny::impl::BulkConversionTraits<tiny::optional_sentinel_via_type<double, NegativeZeroSentinel>>::isVectorizable);
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional<double>>::isVectorizable);
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional<float>>::isVectorizable);
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional<bool>>::isVectorizable);
+    static_assert(tiny::impl::BulkConversionTraits<tiny::optional<int const *>>::isVectorizable);
+#endif
+
+    static_assert(!tiny::impl::BulkConversionTraits<std::optional<double>>::isVectorizable);
+    static_assert(!tiny::impl::BulkConversionTraits<tiny::optional<int>>::isVectorizable);
+    static_assert(!tiny::impl::BulkConversionTraits<tiny::optional<int const, -1>>::isVectorizable);
+    static_assert(!tiny::impl::BulkConversionTraits<tiny::optional<std::string>>::isVectorizable);
+    static_assert(!tiny::impl::BulkConversionTraits<tiny::optional<TestClass, &TestClass::someValue>>::isVectorizable);
+  }
+
+  // Vectorizable implementations.
+  CheckRoundTrips<tiny::optional<int, -1>>([](std::size_t i) { return static_cast<int>(i * 7); });
+  CheckRoundTrips<tiny::optional<std::int16_t, INT16_MAX>>([](std::size_t i) { return static_cast<std::int16_t>(-i); });
+  CheckRoundTrips<tiny::optional<ScopedEnum, ScopedEnum::vend>>(
+      [](std::size_t i) { return i % 2 == 0 ? ScopedEnum::v1 : ScopedEnum::v2; });
+  CheckRoundTrips<tiny::optional_aip<std::uint64_t>>([](std::size_t i) { return std::uint64_t{i} << 40; });
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  CheckRoundTrips<tiny::optional<double>>([](std::size_t i) { return i % 5 == 0 ? -0.0 : 1.0 / static_cast<double>(i); });
+  CheckRoundTrips<tiny::optional<float>>([](std::size_t i) { return static_cast<float>(i) * 0.5f; });
+  CheckRoundTrips<tiny::optional<bool>>([](std::size_t i) { return i % 2 == 0; });
+  static int const someInts[2] = {};
+  CheckRoundTrips<tiny::optional<int const *>>([](std::size_t i) { return i % 4 == 0 ? nullptr : &someInts[i % 2]; });
+#endif
+
+  // Generic implementations.
+  CheckRoundTrips<tiny::optional<int>>([](std::size_t i) { return static_cast<int>(i); });
+  CheckRoundTrips<tiny::optional<std::string>>([](std::size_t i) { return std::to_string(i); });
+
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  // NaNs and infinities remain values; only the library's own sentinel NaN is empty.
+  {
+    std::vector<std::optional<double>> const original
+        = {std::numeric_limits<double>::quiet_NaN(), std::nullopt, std::numeric_limits<double>::infinity()};
+    std::vector<tiny::optional<double>> converted(original.size());
+    tiny::convert_optionals(original.data(), original.size(), converted.data());
+    ASSERT_TRUE(converted[0].has_value() && std::isnan(*converted[0]));
+    ASSERT_FALSE(converted[1].has_value());
+    ASSERT_TRUE(converted[2] == std::numeric_limits<double>::infinity());
+  }
+#endif
+
+  // A floating point sentinel specified by the user is compared by value, so +0.0 also indicates the empty state.
+  {
+    using Optional = tiny::optional_sentinel_via_type<double, NegativeZeroSentinel>;
+    double const values[3] = {1.0, 0.0, -0.0};
+    std::uint8_t const bitmap = 0x1; // Only values[0] is valid.
+    Optional fromBitmap[3];
+    tiny::optionals_from_bitmap(values, &bitmap, 3, fromBitmap);
+    ASSERT_TRUE(fromBitmap[0] == 1.0);
+    ASSERT_FALSE(fromBitmap[1].has_value());
+    ASSERT_FALSE(fromBitmap[2].has_value());
+
+    std::optional<double> asStd[3];
+    tiny::convert_optionals(fromBitmap, 3, asStd);
+    ASSERT_TRUE(asStd[0] == 1.0);
+    ASSERT_FALSE(asStd[1].has_value());
+    ASSERT_FALSE(asStd[2].has_value());
+  }
+
+  // Conversion between two different tiny optionals.
+  {
+    tiny::optional<int, -1> const source[3] = {5, std::nullopt, -7};
+    tiny::optional<int, 42> destination[3];
+    tiny::convert_optionals(source, 3, destination);
+    ASSERT_TRUE(destination[0] == 5);
+    ASSERT_FALSE(destination[1].has_value());
+    ASSERT_TRUE(destination[2] == -7);
+
+    tiny::optional<int> withSeparateBool[3];
+    tiny::convert_optionals(destination, 3, withSeparateBool);
+    ASSERT_TRUE(withSeparateBool[0] == 5);
+    ASSERT_FALSE(withSeparateBool[1].has_value());
+    ASSERT_TRUE(withSeparateBool[2] == -7);
+  }
+}
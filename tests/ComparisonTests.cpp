@@ -4,6 +4,11 @@
 #include "TestUtilities.h"
 #include "tiny/optional.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
 
 namespace
 {
@@ -121,6 +126,23 @@ void test_Comparisons()
     (TestCompareOptWithOpt<tiny::optional<int>, tiny::optional_aip<int>>(42, 43, comparer), ...);
     (TestCompareOptWithOpt<std::optional<int>, tiny::optional_aip<int>>(42, 43, comparer), ...);
 
+    // clang-format off
+    // Optionals whose sentinel is at one end of the integer range are compared via their biased payload bits.
+    (TestCompareOptWithOpt<tiny::optional<int, INT_MIN>, tiny::optional<int, INT_MIN>>(INT_MIN + 1, INT_MAX, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<int, INT_MIN>, tiny::optional<int, INT_MIN>>(-42, 42, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<int, INT_MIN>, tiny::optional<int, INT_MIN>>(INT_MIN + 1, std::nullopt, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<int, INT_MIN>, tiny::optional<int, INT_MIN>>(std::nullopt, std::nullopt, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<unsigned, UINT_MAX>, tiny::optional<unsigned, UINT_MAX>>(0u, UINT_MAX - 1, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<unsigned, UINT_MAX>, tiny::optional<unsigned, UINT_MAX>>(0u, std::nullopt, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<unsigned, UINT_MAX>, tiny::optional<unsigned, UINT_MAX>>(std::nullopt, std::nullopt, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<std::int16_t, INT16_MAX>, tiny::optional<std::int16_t, INT16_MAX>>(std::int16_t{INT16_MIN}, std::nullopt, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<std::int16_t, INT16_MAX>, tiny::optional<std::int16_t, INT16_MAX>>(std::int16_t{-1}, std::int16_t{INT16_MAX - 1}, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<std::uint16_t, 0>, tiny::optional<std::uint16_t, 0>>(std::uint16_t{UINT16_MAX}, std::nullopt, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional<std::uint16_t, 0>, tiny::optional<std::uint16_t, 0>>(std::uint16_t{1}, std::uint16_t{2}, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional_aip<long long>, tiny::optional_aip<long long>>(LLONG_MIN + 1, LLONG_MAX, comparer), ...);
+    (TestCompareOptWithOpt<tiny::optional_aip<long long>, tiny::optional_aip<long long>>(std::nullopt, LLONG_MIN + 1, comparer), ...);
+    // clang-format on
+
     // Comparisons with std::nullopt
     (TestCompareOptWithValue<tiny::optional<int>>(42, std::nullopt, comparer), ...);
     (TestCompareOptWithValue<tiny::optional<int>>(std::nullopt, std::nullopt, comparer), ...);
@@ -183,4 +205,33 @@ void test_Comparisons()
 #endif
   );
   // clang-format on
+
+  // Sorting and binary search with the biased comparison give the same results as with std::optional.
+  {
+    std::vector<tiny::optional<int, INT_MIN>> tinyKeys;
+    std::vector<std::optional<int>> stdKeys;
+    for (int i = 0; i < 200; ++i) {
+      if (i % 7 == 0) {
+        tinyKeys.emplace_back();
+        stdKeys.emplace_back();
+      }
+      else {
+        int const value = (i * 7919) % 201 - 100;
+        tinyKeys.emplace_back(value);
+        stdKeys.emplace_back(value);
+      }
+    }
+    std::sort(tinyKeys.begin(), tinyKeys.end());
+    std::sort(stdKeys.begin(), stdKeys.end());
+    ASSERT_TRUE(std::equal(tinyKeys.begin(), tinyKeys.end(), stdKeys.begin(), stdKeys.end()));
+
+    for (int value = -101; value <= 101; ++value) {
+      tiny::optional<int, INT_MIN> const tinyKey{value};
+      auto const tinyIt = std::lower_bound(tinyKeys.begin(), tinyKeys.end(), tinyKey);
+      auto const stdIt = std::lower_bound(stdKeys.begin(), stdKeys.end(), std::optional<int>{value});
+      ASSERT_TRUE(tinyIt - tinyKeys.begin() == stdIt - stdKeys.begin());
+    }
+    auto const firstValue = std::upper_bound(tinyKeys.begin(), tinyKeys.end(), tiny::optional<int, INT_MIN>{});
+    ASSERT_TRUE(firstValue - tinyKeys.begin() == 29);
+  }
 }
@@ -139,6 +139,26 @@ void test_ExpressionsThatShouldNotCompile()
         o.transform([](int) { return std::nullopt; });
      )",
      /*expected regex*/ "The standard requires 'f' to not return a std::nullopt_t"}
+    ,
+    {/*code*/ R"(
+        tiny::optional<int> o = 42;
+        o.transform<std::optional<int>>([](int v) { return v; });
+     )",
+     /*expected regex*/ "TargetOptional must be a tiny optional type"}
+    ,
+    {/*code*/ R"(
+        tiny::optional<int> o = 42;
+        o.transform<tiny::optional<int *>>([](int v) { return v; });
+     )",
+     /*expected regex*/ "The payload of TargetOptional must be constructible from the result of f"}
+
+    ,
+
+    // Conversions between optionals
+    {/*code*/ R"(
+        [[maybe_unused]] auto o = tiny::optional_cast<tiny::optional<long>>(42);
+     )",
+     /*expected regex*/ "optional_cast: The source must be a tiny optional or a std::optional"}
 #ifdef TINY_OPTIONAL_ENABLE_ORELSE
     ,
     {/*code*/ R"(
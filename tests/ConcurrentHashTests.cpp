@@ -0,0 +1,123 @@
+#include "ConcurrentHashTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/concurrent_hash.h"
+
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+void test_ConcurrentHash()
+{
+  using Key = tiny::optional<std::uint64_t, ~0ull>;
+
+  // Set, single-threaded.
+  {
+    tiny::concurrent_hash_set<Key> set(6);
+    ASSERT_TRUE(set.capacity() == 8);
+    ASSERT_FALSE(set.contains(0));
+    ASSERT_TRUE(set.insert(0));
+    ASSERT_TRUE(set.insert(8)); // Collides with 0 for an identity hash.
+    ASSERT_TRUE(set.insert(1ull << 40));
+    ASSERT_FALSE(set.insert(8));
+    ASSERT_TRUE(set.contains(0) && set.contains(8) && set.contains(1ull << 40));
+    ASSERT_FALSE(set.contains(16));
+    ASSERT_TRUE(set.size() == 3);
+
+    for (std::uint64_t i = 100; i < 105; ++i) {
+      ASSERT_TRUE(set.insert(i));
+    }
+    ASSERT_TRUE(set.size() == 8);
+    ASSERT_FALSE(set.contains(7)); // Terminates although there is no empty bucket.
+    EXPECT_EXCEPTION(set.insert(7), std::length_error);
+
+    set.rehash(100, 3);
+    ASSERT_TRUE(set.capacity() == 128);
+    ASSERT_TRUE(set.size() == 8);
+    std::set<std::uint64_t> keys;
+    set.for_each([&](std::uint64_t key) { keys.insert(key); });
+    ASSERT_TRUE(keys == (std::set<std::uint64_t>{0, 8, 1ull << 40, 100, 101, 102, 103, 104}));
+    ASSERT_TRUE(set.insert(7));
+
+    // A too small capacity fails also if several threads are used, and does not modify the set.
+    EXPECT_EXCEPTION(set.rehash(4, 4), std::length_error);
+    ASSERT_TRUE(set.capacity() == 128);
+    ASSERT_TRUE(set.size() == 9);
+    ASSERT_TRUE(set.contains(7) && set.contains(1ull << 40));
+  }
+
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  // Map, single-threaded, with pointer values.
+  {
+    int objects[3] = {};
+    tiny::concurrent_hash_map<tiny::optional<int, -1>, tiny::optional<int *>> map(16);
+    ASSERT_FALSE(map.find(1).has_value());
+    ASSERT_TRUE(map.insert(1, &objects[0]));
+    ASSERT_FALSE(map.insert(1, &objects[1]));
+    ASSERT_TRUE(map.find(1) == &objects[0]);
+    map.insert_or_assign(1, &objects[1]);
+    map.insert_or_assign(2, nullptr);
+    ASSERT_TRUE(map.find(1) == &objects[1]);
+    ASSERT_TRUE(map.find(2) == nullptr);
+    ASSERT_TRUE(map.contains(2));
+    ASSERT_FALSE(map.contains(3));
+    ASSERT_TRUE(map.size() == 2);
+
+    map.rehash(2);
+    ASSERT_TRUE(map.capacity() == 2);
+    ASSERT_TRUE(map.find(1) == &objects[1]);
+    ASSERT_TRUE(map.find(2) == nullptr);
+    EXPECT_EXCEPTION(map.insert(3, &objects[2]), std::length_error);
+  }
+#endif
+
+  // Concurrent deduplication: Every key is reported as inserted by exactly one thread.
+  {
+    constexpr unsigned numThreads = 4;
+    constexpr std::uint64_t numKeysPerThread = 20000;
+    tiny::concurrent_hash_set<Key> set(2 * numKeysPerThread * numThreads);
+    tiny::concurrent_hash_map<Key, Key> map(2 * numKeysPerThread * numThreads);
+    std::atomic<std::uint64_t> numInserted{0};
+    std::atomic<bool> allFound{true};
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&, t] {
+        // Neighboring threads share half of their keys.
+        std::uint64_t const firstKey = t * numKeysPerThread / 2;
+        for (std::uint64_t key = firstKey; key < firstKey + numKeysPerThread; ++key) {
+          if (set.insert(key * 3)) {
+            ++numInserted;
+          }
+          bool const insertedIntoMap = map.insert(key, key + 1);
+          // If another thread inserted the key, it might not have stored the value yet.
+          auto const found = map.find(key);
+          if (!set.contains(key * 3) || (found != key + 1 && (insertedIntoMap || found.has_value()))) {
+            allFound = false;
+          }
+        }
+      });
+    }
+    for (std::thread & t : threads) {
+      t.join();
+    }
+
+    std::uint64_t const numDistinctKeys = (numThreads + 1) * numKeysPerThread / 2;
+    ASSERT_TRUE(numInserted == numDistinctKeys);
+    ASSERT_TRUE(allFound);
+    ASSERT_TRUE(set.size() == numDistinctKeys);
+    ASSERT_TRUE(map.size() == numDistinctKeys);
+
+    map.rehash(4 * numDistinctKeys, numThreads);
+    bool allValuesCorrect = true;
+    map.for_each([&](std::uint64_t key, std::uint64_t value) {
+      allValuesCorrect = allValuesCorrect && value == key + 1;
+    });
+    ASSERT_TRUE(allValuesCorrect);
+    ASSERT_TRUE(map.size() == numDistinctKeys);
+  }
+}
@@ -0,0 +1,147 @@
+#include "ConstexprTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/optional.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+namespace
+{
+struct NonTrivialPayload
+{
+  constexpr NonTrivialPayload(int value)
+    : value(value)
+  {
+  }
+
+  constexpr NonTrivialPayload(NonTrivialPayload const & rhs)
+    : value(rhs.value)
+  {
+  }
+
+  constexpr NonTrivialPayload & operator=(NonTrivialPayload const & rhs)
+  {
+    value = rhs.value;
+    return *this;
+  }
+
+  constexpr ~NonTrivialPayload() { }
+
+  int value;
+};
+
+
+template <class OptionalType, class PayloadType>
+constexpr bool ExerciseOptional(PayloadType value1, PayloadType value2)
+{
+  OptionalType o;
+  if (o.has_value() || o != std::nullopt) {
+    return false;
+  }
+
+  o = value1;
+  if (!o || *o != value1 || o.value() != value1 || o.value_or(value2) != value1) {
+    return false;
+  }
+
+  OptionalType copy = o;
+  o.reset();
+  if (o.has_value() || !copy.has_value() || o.value_or(value2) != value2) {
+    return false;
+  }
+
+  o.emplace(value2);
+  o.swap(copy);
+  if (*o != value1 || *copy != value2 || !(o != copy) || o == copy) {
+    return false;
+  }
+
+  copy = std::move(o);
+  o = std::nullopt;
+  OptionalType moved = std::move(copy);
+  return !o && moved == value1 && moved.transform([](PayloadType const & v) { return v; }) == value1;
+}
+
+
+constexpr tiny::optional<double> MakeHalf(int i)
+{
+  if (i % 2 != 0) {
+    return std::nullopt;
+  }
+  return i / 2.0;
+}
+
+
+// A lookup table that is computed and stored at compile time, with half the size of std::optional<double>.
+constexpr auto halfTable = []() {
+  std::array<tiny::optional<double>, 8> table{};
+  for (int i = 0; i < 8; ++i) {
+    table[static_cast<std::size_t>(i)] = MakeHalf(i);
+  }
+  return table;
+}();
+} // namespace
+#endif
+
+
+void test_Constexpr()
+{
+#ifdef TINY_OPTIONAL_ENABLE_CONSTEXPR
+  // Sentinels exploiting unused bits (via std::bit_cast during constant evaluation).
+  static_assert(ExerciseOptional<tiny::optional<double>>(1.5, -2.0));
+  static_assert(ExerciseOptional<tiny::optional<float>>(1.5f, -2.0f));
+
+  // User specified sentinels (assigned and compared via operator=).
+  static_assert(ExerciseOptional<tiny::optional<int, -1>>(42, 43));
+  static_assert(ExerciseOptional<tiny::optional<std::uint64_t, ~std::uint64_t{0}>>(std::uint64_t{1}, std::uint64_t{2}));
+  static_assert(ExerciseOptional<tiny::optional_aip<int>>(42, 43));
+
+  // Separate bool.
+  static_assert(ExerciseOptional<tiny::optional<int>>(42, 43));
+  static_assert(ExerciseOptional<tiny::optional<char>>('a', 'b'));
+
+  // Non-trivial payload.
+  static_assert([]() {
+    tiny::optional<NonTrivialPayload> o{std::in_place, 4};
+    tiny::optional<NonTrivialPayload> copy = o;
+    o = NonTrivialPayload{5};
+    copy.reset();
+    return o->value == 5 && !copy.has_value();
+  }());
+
+  // Comparisons and make_optional.
+  static_assert(tiny::optional<double>(1.0) < 2.0);
+  static_assert(tiny::optional<double>() < tiny::optional<double>(-1.0));
+  static_assert(tiny::make_optional(2.0f) == 2.0f);
+  static_assert(tiny::optional<int, -1>(3) == std::optional<int>(3));
+  // The default value must not be converted if the optional contains a value (the conversion would overflow).
+  static_assert(tiny::optional<int, -1>(5).value_or(1e100) == 5);
+
+  // Conversions between optionals, both via the fast path and the checked one.
+  static_assert([]() {
+    tiny::optional<int, -1> const source = 5;
+    tiny::optional<long long, -1> const widened = source;
+    tiny::optional<long, std::numeric_limits<int>::min()> const otherSentinel = source;
+    tiny::optional<long long> const fromEmpty = tiny::optional<int, -1>{};
+    return *widened == 5 && *otherSentinel == 5 && !fromEmpty.has_value();
+  }());
+
+  // Tables of optionals initialized at compile time.
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  static_assert(halfTable.size() * sizeof(double) == sizeof(halfTable));
+#endif
+  static_assert(halfTable[4] == 2.0 && !halfTable[3].has_value());
+  ASSERT_TRUE(halfTable[6] == 3.0);
+  ASSERT_FALSE(halfTable[5].has_value());
+
+  constexpr tiny::optional<double> emptyDouble;
+  ASSERT_FALSE(emptyDouble.has_value());
+  constexpr tiny::optional<unsigned> emptyWithSeparateBool;
+  ASSERT_FALSE(emptyWithSeparateBool.has_value());
+#endif
+}
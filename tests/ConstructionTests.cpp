@@ -10,6 +10,12 @@
 
 #include "tiny/optional.h"
 
+#include <climits>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
 namespace
 {
 struct Probe
@@ -241,7 +247,7 @@ void test_TinyOptionalCopyConstruction()
     static_assert(std::is_swappable_v<tiny::optional<DeletedCopy>>);
   }
 
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
   {
     static_assert(std::is_trivially_copy_constructible_v<tiny::optional<int, -1>>);
     static_assert(std::is_trivially_copy_constructible_v<tiny::optional<int>>);
@@ -329,7 +335,7 @@ void test_TinyOptionalMoveConstruction()
     [[maybe_unused]] tiny::optional<DeletedCopy> moveTarget(std::move(orig));
   }
 
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
   {
     static_assert(std::is_trivially_move_constructible_v<tiny::optional<int, -1>>);
     static_assert(std::is_trivially_move_constructible_v<tiny::optional<int>>);
@@ -408,7 +414,7 @@ void test_TinyOptionalCopyAssignment()
     static_assert(std::is_swappable_v<tiny::optional<NotCopyAssignable>>);
   }
 
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
   {
     static_assert(std::is_trivially_copy_assignable_v<tiny::optional<int, -1>>);
     static_assert(std::is_trivially_copy_assignable_v<tiny::optional<int>>);
@@ -568,7 +574,7 @@ void test_TinyOptionalMoveAssignment()
   }
 
 
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
   {
     static_assert(std::is_trivially_move_assignable_v<tiny::optional<int, -1>>);
     static_assert(std::is_trivially_move_assignable_v<tiny::optional<int>>);
@@ -583,7 +589,7 @@ void test_TinyOptionalMoveAssignment()
 
 void test_TinyOptionalDestruction()
 {
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
   {
     static_assert(std::is_trivially_destructible_v<tiny::optional<int, -1>>);
     static_assert(std::is_trivially_destructible_v<tiny::optional<int>>);
@@ -665,6 +671,155 @@ void test_TinyOptionalConversions()
   }
 }
 
+void test_ConversionsBetweenOptionals()
+{
+  using IntMinusOne = tiny::optional<int, -1>;
+  using LongIntMin = tiny::optional<long, INT_MIN>;
+  using LongLongMinusOne = tiny::optional<long long, -1>;
+
+  // Which conversions take the fast path (a single conversion of the payload bits, including the sentinel).
+  {
+    static_assert(tiny::impl::IsBitwiseOptionalConversion<LongLongMinusOne, IntMinusOne>());
+    static_assert(
+        tiny::impl::IsBitwiseOptionalConversion<tiny::optional<unsigned, 0>, tiny::optional<std::uint16_t, 0>>());
+    // The sentinel of optional<int, -1> becomes -1, not INT_MIN.
+    static_assert(!tiny::impl::IsBitwiseOptionalConversion<LongIntMin, IntMinusOne>());
+    // Narrowing would map other values onto the sentinel.
+    static_assert(!tiny::impl::IsBitwiseOptionalConversion<tiny::optional<short, -1>, IntMinusOne>());
+    // Separate bool or std::optional.
+    static_assert(!tiny::impl::IsBitwiseOptionalConversion<tiny::optional<long long>, tiny::optional<int>>());
+    static_assert(!tiny::impl::IsBitwiseOptionalConversion<LongLongMinusOne, std::optional<int>>());
+  }
+
+  // Which conversions are available. Same rules as for std::optional.
+  {
+    static_assert(std::is_convertible_v<IntMinusOne, LongIntMin>);
+    static_assert(std::is_convertible_v<std::optional<int>, LongIntMin>);
+    static_assert(std::is_convertible_v<std::optional<char const *>, tiny::optional<std::string>>);
+    static_assert(!std::is_constructible_v<tiny::optional<int>, tiny::optional<std::string>>);
+    static_assert(!std::is_assignable_v<tiny::optional<int> &, tiny::optional<std::string>>);
+
+    struct ExplicitFromInt
+    {
+      explicit ExplicitFromInt(int v)
+        : value(v)
+      {
+      }
+      int value;
+    };
+    static_assert(std::is_constructible_v<tiny::optional<ExplicitFromInt>, tiny::optional<int>>);
+    static_assert(!std::is_convertible_v<tiny::optional<int>, tiny::optional<ExplicitFromInt>>);
+    tiny::optional<ExplicitFromInt> const o(tiny::optional<int>(3));
+    ASSERT_TRUE(o.has_value() && o->value == 3);
+  }
+
+  // Converting constructors and assignments via the checked path.
+  {
+    IntMinusOne const source = 42;
+    LongIntMin target = source;
+    ASSERT_TRUE(target == 42L);
+
+    LongIntMin const fromEmpty = IntMinusOne{};
+    ASSERT_FALSE(fromEmpty.has_value());
+
+    target = IntMinusOne{-1 + 2};
+    ASSERT_TRUE(target == 1L);
+    target = IntMinusOne{};
+    ASSERT_FALSE(target.has_value());
+    target = std::optional<int>(INT_MAX);
+    ASSERT_TRUE(target == long{INT_MAX});
+  }
+
+  // Converting constructors and assignments via the fast path.
+  {
+    LongLongMinusOne target = IntMinusOne{INT_MIN};
+    ASSERT_TRUE(target == static_cast<long long>(INT_MIN));
+    target = IntMinusOne{};
+    ASSERT_FALSE(target.has_value());
+    target = IntMinusOne{7};
+    ASSERT_TRUE(target == 7LL);
+
+    tiny::optional<unsigned, 0> const unsignedTarget = tiny::optional<std::uint16_t, 0>{};
+    ASSERT_FALSE(unsignedTarget.has_value());
+  }
+
+  // Non-trivial payloads: Assignment reuses the payload of the target.
+  {
+    tiny::optional<std::string> target = std::optional<char const *>("abc");
+    ASSERT_TRUE(target == std::string("abc"));
+    target = tiny::optional<char const *>("def");
+    ASSERT_TRUE(target == std::string("def"));
+    target = tiny::optional<char const *>();
+    ASSERT_FALSE(target.has_value());
+
+    tiny::optional<std::vector<int>> const vec(tiny::optional<std::size_t>(std::size_t{3}));
+    ASSERT_TRUE(vec.has_value() && vec->size() == 3);
+  }
+
+  // A nested optional is constructed from the inner optional, not converted.
+  {
+    tiny::optional<tiny::optional<int>> const nested = tiny::optional<int>();
+    ASSERT_TRUE(nested.has_value());
+    ASSERT_FALSE(nested->has_value());
+  }
+
+  // Hinted and non-hinted optionals.
+  {
+    using Hinted = tiny::optional_with_hint<IntMinusOne, tiny::emptiness_hint::rarely_empty>;
+    Hinted hinted = IntMinusOne{3};
+    ASSERT_TRUE(hinted == 3);
+    IntMinusOne plain = hinted;
+    ASSERT_TRUE(plain == 3);
+    plain = Hinted{};
+    ASSERT_FALSE(plain.has_value());
+  }
+
+  // optional_cast() and assign_optional() with the different policies. 42 is the sentinel of the target.
+  {
+    using Target = tiny::optional<long, 42>;
+    IntMinusOne const source = 42;
+
+    Target const empty = tiny::optional_cast<Target, tiny::sentinel_collision::make_empty>(source);
+    ASSERT_FALSE(empty.has_value());
+    auto const castThrowing = [&]() {
+      return tiny::optional_cast<Target, tiny::sentinel_collision::throw_exception>(source);
+    };
+    EXPECT_EXCEPTION(castThrowing(), tiny::bad_optional_conversion);
+
+    Target target = 1L;
+    tiny::assign_optional<tiny::sentinel_collision::make_empty>(target, source);
+    ASSERT_FALSE(target.has_value());
+    target = 1L;
+    EXPECT_EXCEPTION(
+        tiny::assign_optional<tiny::sentinel_collision::throw_exception>(target, source), tiny::bad_optional_conversion);
+    ASSERT_FALSE(target.has_value());
+
+    // No collision.
+    Target const noCollision
+        = tiny::optional_cast<Target, tiny::sentinel_collision::throw_exception>(IntMinusOne{41});
+    ASSERT_TRUE(noCollision == 41L);
+    ASSERT_TRUE(tiny::assign_optional(target, IntMinusOne{43}) == 43L);
+  }
+
+  // optional_cast() to std::optional.
+  {
+    std::optional<std::uint64_t> const target
+        = tiny::optional_cast<std::optional<std::uint64_t>>(tiny::optional_aip<std::uint32_t>(7u));
+    ASSERT_TRUE(target == std::uint64_t{7});
+    ASSERT_FALSE(tiny::optional_cast<std::optional<std::uint64_t>>(tiny::optional_aip<std::uint32_t>()).has_value());
+
+    std::optional<long> stdTarget = 5L;
+    tiny::assign_optional(stdTarget, IntMinusOne{});
+    ASSERT_FALSE(stdTarget.has_value());
+    tiny::assign_optional(stdTarget, IntMinusOne{6});
+    ASSERT_TRUE(stdTarget == 6L);
+
+    IntMinusOne const same = tiny::optional_cast<IntMinusOne>(IntMinusOne{8});
+    ASSERT_TRUE(same == 8);
+  }
+}
+
+
 
 void test_MakeOptional()
 {
@@ -12,5 +12,6 @@ void test_TinyOptionalMoveAssignment();
 void test_TinyOptionalDestruction();
 
 void test_TinyOptionalConversions();
+void test_ConversionsBetweenOptionals();
 
 void test_MakeOptional();
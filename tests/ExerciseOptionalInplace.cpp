@@ -63,7 +63,7 @@ void test_OptionalInplace()
           EXPECT_INPLACE,
           UniqueObjectRepr{1},
           UniqueObjectRepr{2});
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
       static_assert(std::is_trivially_copy_constructible_v<tiny::optional<UniqueObjectRepr>>);
       static_assert(std::is_trivially_move_constructible_v<tiny::optional<UniqueObjectRepr>>);
       static_assert(std::is_trivially_move_assignable_v<tiny::optional<UniqueObjectRepr>>);
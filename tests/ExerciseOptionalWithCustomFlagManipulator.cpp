@@ -378,8 +378,8 @@ void test_TinyOptionalWithRegisteredCustomFlagManipulator()
         EXPECT_INPLACE,
         OuterClass::NestedClass{},
         OuterClass::NestedClass{});
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
-    // NestedClass is trivially copyable/movable, and so should tiny::optional be in C++20.
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+    // NestedClass is trivially copyable/movable, and so should tiny::optional be.
     static_assert(std::is_trivially_copy_constructible_v<tiny::optional<OuterClass::NestedClass>>);
     static_assert(std::is_trivially_move_constructible_v<tiny::optional<OuterClass::NestedClass>>);
     static_assert(std::is_trivially_move_assignable_v<tiny::optional<OuterClass::NestedClass>>);
@@ -436,8 +436,8 @@ void test_TinyOptionalWithRegisteredCustomFlagManipulator()
         EXPECT_INPLACE,
         EnumNamespace::UNSCOPED_VALUE1,
         EnumNamespace::UNSCOPED_VALUE2);
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
-    // TestUnscopedEnum is trivially copyable/movable, and so should tiny::optional be in C++20.
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+    // TestUnscopedEnum is trivially copyable/movable, and so should tiny::optional be.
     static_assert(std::is_trivially_copy_constructible_v<tiny::optional<EnumNamespace::TestUnscopedEnum>>);
     static_assert(std::is_trivially_move_constructible_v<tiny::optional<EnumNamespace::TestUnscopedEnum>>);
     static_assert(std::is_trivially_move_assignable_v<tiny::optional<EnumNamespace::TestUnscopedEnum>>);
@@ -449,8 +449,8 @@ void test_TinyOptionalWithRegisteredCustomFlagManipulator()
         EXPECT_INPLACE,
         TestScopedEnum::VALUE1,
         TestScopedEnum::VALUE2);
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
-    // TestScopedEnum is trivially copyable/movable, and so should tiny::optional be in C++20.
+#ifndef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+    // TestScopedEnum is trivially copyable/movable, and so should tiny::optional be.
     static_assert(std::is_trivially_copy_constructible_v<tiny::optional<TestScopedEnum>>);
     static_assert(std::is_trivially_move_constructible_v<tiny::optional<TestScopedEnum>>);
     static_assert(std::is_trivially_move_assignable_v<tiny::optional<TestScopedEnum>>);
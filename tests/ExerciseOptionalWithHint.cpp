@@ -0,0 +1,75 @@
+#include "ExerciseOptionalWithHint.h"
+
+#include "Exercises.h"
+#include "TestTypes.h"
+#include "tiny/optional.h"
+
+#include <climits>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+template <class Opt>
+using MostlyEmpty = tiny::optional_with_hint<Opt, tiny::emptiness_hint::mostly_empty>;
+
+template <class Opt>
+using RarelyEmpty = tiny::optional_with_hint<Opt, tiny::emptiness_hint::rarely_empty>;
+} // namespace
+
+
+void test_OptionalWithHint()
+{
+  //----------------------
+  // The hint must not change the memory layout.
+  static_assert(sizeof(MostlyEmpty<tiny::optional<int, -1>>) == sizeof(int));
+  static_assert(sizeof(RarelyEmpty<tiny::optional<double>>) == sizeof(tiny::optional<double>));
+  static_assert(sizeof(RarelyEmpty<tiny::optional<TestClass>>) == sizeof(tiny::optional<TestClass>));
+  static_assert(tiny::impl::SentinelLayoutTraits<MostlyEmpty<tiny::optional<int, -1>>>::isWholePayloadTheFlag);
+  static_assert(tiny::is_tiny_optional_v<RarelyEmpty<tiny::optional_aip<unsigned>>>);
+
+  // A new hint replaces an existing one, and emptiness_hint::none removes it.
+  static_assert(
+      std::is_same_v<MostlyEmpty<RarelyEmpty<tiny::optional<char, 'a'>>>, MostlyEmpty<tiny::optional<char, 'a'>>>);
+  static_assert(std::is_same_v<
+                tiny::optional_with_hint<MostlyEmpty<tiny::optional<double>>, tiny::emptiness_hint::none>,
+                tiny::optional_with_hint<tiny::optional<double>, tiny::emptiness_hint::none>>);
+
+  //----------------------
+  // The hint must not change the behavior.
+  EXERCISE_OPTIONAL((MostlyEmpty<tiny::optional<int, -1>>{}), EXPECT_INPLACE, INT_MIN, INT_MAX);
+  EXERCISE_OPTIONAL((RarelyEmpty<tiny::optional<int, -1>>{}), EXPECT_INPLACE, INT_MIN, INT_MAX);
+  EXERCISE_OPTIONAL((RarelyEmpty<tiny::optional_aip<unsigned int>>{}), EXPECT_INPLACE, 10u, 42u);
+  EXERCISE_OPTIONAL((MostlyEmpty<tiny::optional<char, 'a'>>{}), EXPECT_INPLACE, 'b', 'c');
+
+  EXERCISE_OPTIONAL((MostlyEmpty<tiny::optional<double>>{}), cInPlaceExpectationForUnusedBits, 43.0, 44.0);
+  EXERCISE_OPTIONAL((RarelyEmpty<tiny::optional<double>>{}), cInPlaceExpectationForUnusedBits, 43.0, 44.0);
+  EXERCISE_OPTIONAL((RarelyEmpty<tiny::optional<bool>>{}), cInPlaceExpectationForUnusedBits, true, false);
+
+  TestClass c1, c2;
+  EXERCISE_OPTIONAL((MostlyEmpty<tiny::optional<TestClass *>>{}), cInPlaceExpectationForUnusedBits, &c1, &c2);
+
+  EXERCISE_OPTIONAL(
+      (RarelyEmpty<tiny::optional<TestClassForInplace, &TestClassForInplace::someInt, 42>>{}),
+      cInPlaceExpectationForMemPtr,
+      TestClassForInplace{},
+      TestClassForInplace(43, 44.0, 45, nullptr));
+
+  {
+    std::vector<int> testValue1{1, 2, 3, 4};
+    std::vector<int> testValue2{5, 6, 7};
+    EXERCISE_OPTIONAL((MostlyEmpty<tiny::optional<std::vector<int>>>{}), EXPECT_SEPARATE, testValue1, testValue2);
+  }
+
+  // Comparisons with the unhinted type.
+  {
+    tiny::optional<int, -1> const plain = 5;
+    RarelyEmpty<tiny::optional<int, -1>> const hinted = 5;
+    MostlyEmpty<tiny::optional<int, -1>> const empty;
+    ASSERT_TRUE(hinted == plain);
+    ASSERT_TRUE(plain == hinted);
+    ASSERT_TRUE(empty < plain);
+    ASSERT_TRUE(plain != empty);
+    ASSERT_TRUE(empty == std::nullopt);
+  }
+}
@@ -132,22 +132,19 @@ void ExerciseOptional(
       std::is_copy_assignable_v<Optional>
       == (std::is_copy_assignable_v<PayloadType> && std::is_copy_constructible_v<PayloadType>));
 
-  constexpr bool trivialDestructorExpected = std::is_trivially_destructible_v<PayloadType>
-#ifndef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
-                                             && !tiny::is_tiny_optional_v<Optional>
-#endif
-      ;
-  static_assert(std::is_trivially_destructible_v<Optional> == trivialDestructorExpected);
-
   constexpr bool trivialMoveCopyPossible =
-#ifdef TINY_OPTIONAL_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
-      // C++20: Same conditions for trivial copies/moves as for std::optional.
-      true;
-#else
-      // C++17: tiny::optional always has non-trivial copies/moves while std::optional implements the conditions.
+#ifdef TINY_OPTIONAL_NO_TRIVIAL_SPECIAL_MEMBER_FUNCTIONS
+      // tiny::optional always has non-trivial special member functions while std::optional implements the conditions.
       !tiny::is_tiny_optional_v<Optional>;
+#else
+      // Same conditions for trivial special member functions as for std::optional.
+      true;
 #endif
 
+  static_assert(
+      std::is_trivially_destructible_v<Optional>
+      == (trivialMoveCopyPossible && std::is_trivially_destructible_v<PayloadType>));
+
   static_assert(
       std::is_trivially_move_constructible_v<Optional>
       == (trivialMoveCopyPossible && std::is_trivially_move_constructible_v<PayloadType>));
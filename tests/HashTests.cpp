@@ -0,0 +1,101 @@
+#include "HashTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/hash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+template <class OptionalType>
+std::size_t Hash(OptionalType const & o)
+{
+  return tiny::hash<OptionalType>{}(o);
+}
+
+
+// Checks that hash_span() computes the same hashes as tiny::hash.
+template <class OptionalType>
+void CheckHashSpan(std::vector<OptionalType> const & optionals)
+{
+  std::vector<std::size_t> hashes(optionals.size());
+  tiny::hash_span(optionals.data(), optionals.size(), hashes.data());
+  for (std::size_t i = 0; i < optionals.size(); ++i) {
+    ASSERT_TRUE(hashes[i] == Hash(optionals[i]));
+  }
+}
+} // namespace
+
+
+void test_Hash()
+{
+  // Optionals storing the sentinel in the payload are hashed via their bits.
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  static_assert(noexcept(tiny::hash<tiny::optional<double>>{}(std::declval<tiny::optional<double>>())));
+#endif
+  static_assert(noexcept(tiny::hash<tiny::optional<int, -1>>{}(std::declval<tiny::optional<int, -1>>())));
+  static_assert(!noexcept(tiny::hash<tiny::optional<std::string>>{}(std::declval<tiny::optional<std::string>>())));
+
+  // Equal optionals must have equal hashes, especially -0.0 and +0.0.
+  {
+    ASSERT_TRUE(Hash(tiny::optional<double>{-0.0}) == Hash(tiny::optional<double>{0.0}));
+    ASSERT_TRUE(Hash(tiny::optional<float>{-0.0f}) == Hash(tiny::optional<float>{0.0f}));
+    ASSERT_TRUE(Hash(std::optional<double>{-0.0}) == Hash(std::optional<double>{0.0}));
+    ASSERT_TRUE(Hash(tiny::optional<double>{}) == Hash(tiny::optional<double>{}));
+    ASSERT_TRUE(Hash(tiny::optional<double>{1.0}) == Hash(tiny::optional<double>{1.0}));
+    ASSERT_TRUE(Hash(tiny::optional<double>{1.0}) != Hash(tiny::optional<double>{-1.0}));
+    ASSERT_TRUE(Hash(tiny::optional<double>{0.0}) != Hash(tiny::optional<double>{}));
+    ASSERT_TRUE(Hash(tiny::optional<std::string>{"abc"}) == Hash(tiny::optional<std::string>{"abc"}));
+    ASSERT_TRUE(Hash(tiny::optional<std::string>{}) == Hash(std::optional<std::string>{}));
+  }
+
+  // The empty state hashes to a constant that is not 0 and differs from the hash of typical values.
+  {
+    ASSERT_TRUE(Hash(tiny::optional<int, -1>{}) != 0);
+    ASSERT_TRUE(Hash(tiny::optional<int, -1>{}) != Hash(tiny::optional<int, -1>{0}));
+    ASSERT_TRUE(Hash(std::optional<int>{}) != 0);
+    ASSERT_TRUE(Hash(std::optional<int>{}) != Hash(std::optional<int>{0}));
+    ASSERT_TRUE(Hash(tiny::optional<int *>{}) != Hash(tiny::optional<int *>{nullptr}));
+  }
+
+  // Consecutive integers (for which std::hash is the identity in libstdc++) are distributed over all buckets, even if
+  // the number of buckets is a power of 2.
+  {
+    std::set<std::size_t> usedBuckets;
+    std::set<std::size_t> usedBucketsStd;
+    for (int i = 0; i < 1024; ++i) {
+      usedBuckets.insert(Hash(tiny::optional<int, -1>{i * 64}) % 64);
+      usedBucketsStd.insert(Hash(std::optional<int>{i * 64}) % 64);
+    }
+    ASSERT_TRUE(usedBuckets.size() == 64);
+    ASSERT_TRUE(usedBucketsStd.size() == 64);
+  }
+
+  // Usage in a hash table
+  {
+    std::unordered_set<tiny::optional<int, -1>, tiny::hash<tiny::optional<int, -1>>> set;
+    set.insert(42);
+    set.insert(tiny::optional<int, -1>{});
+    set.insert(42);
+    ASSERT_TRUE(set.size() == 2);
+    ASSERT_TRUE(set.count(tiny::optional<int, -1>{}) == 1);
+  }
+
+  // hash_span()
+  {
+    CheckHashSpan(std::vector<tiny::optional<double>>{1.0, std::nullopt, -0.0, 0.0, 2.5, std::nullopt, 3.0});
+    CheckHashSpan(std::vector<tiny::optional<int, -1>>{0, 1, std::nullopt, 3, 4, 5, 6, 7, 8, std::nullopt});
+    CheckHashSpan(std::vector<tiny::optional<int>>{0, std::nullopt, 2});
+    CheckHashSpan(std::vector<std::optional<int>>{0, std::nullopt, 2});
+    CheckHashSpan(std::vector<tiny::optional<std::string>>{"a", std::nullopt, "b"});
+    CheckHashSpan(std::vector<tiny::optional<double>>{});
+  }
+}
@@ -106,3 +106,75 @@ void test_SelectDecomposition()
 
   // clang-format on
 }
+
+
+namespace
+{
+template <class PayloadType>
+using DecompositionFor = tiny::impl::SelectDecomposition<PayloadType, tiny::UseDefaultType, tiny::UseDefaultValue>;
+
+template <class PayloadType>
+using StorageFor = tiny::impl::StorageBase<
+    typename DecompositionFor<PayloadType>::StoredTypeDecomposition,
+    typename DecompositionFor<PayloadType>::FlagManipulator>;
+} // namespace
+
+
+void test_BitwiseValueOrAndSwap()
+{
+  // Compressed and trivially copyable payloads use the bitwise implementations; the others do not.
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  static_assert(StorageFor<double>::isBitwiseCopyable && StorageFor<double>::isBitwiseSelectable);
+  static_assert(StorageFor<int *>::isBitwiseCopyable && StorageFor<int *>::isBitwiseSelectable);
+  static_assert(StorageFor<bool>::isBitwiseCopyable && !StorageFor<bool>::isBitwiseSelectable);
+#endif
+  static_assert(!StorageFor<int>::isBitwiseCopyable && !StorageFor<int>::isBitwiseSelectable);
+  static_assert(!StorageFor<std::string>::isBitwiseCopyable);
+
+  {
+    tiny::optional<double> empty;
+    tiny::optional<double> const negativeZero = -0.0;
+    ASSERT_TRUE(empty.value_or(42.0) == 42.0);
+    ASSERT_TRUE(empty.value_or(1) == 1.0); // Conversion of the default value
+    ASSERT_TRUE(std::signbit(negativeZero.value_or(42.0)));
+    ASSERT_TRUE(std::signbit(empty.value_or(-0.0)));
+    ASSERT_TRUE(tiny::optional<double>(1.5).value_or(2.5) == 1.5);
+  }
+  {
+    int value = 0;
+    tiny::optional<int *> empty;
+    tiny::optional<int *> const nonEmpty = &value;
+    ASSERT_TRUE(empty.value_or(nullptr) == nullptr);
+    ASSERT_TRUE(nonEmpty.value_or(nullptr) == &value);
+  }
+  {
+    // The default value may equal the sentinel.
+    tiny::optional<int, -1> empty;
+    tiny::optional<int, -1> const nonEmpty = 42;
+    ASSERT_TRUE(empty.value_or(-1) == -1);
+    ASSERT_TRUE(empty.value_or(7) == 7);
+    ASSERT_TRUE(nonEmpty.value_or(-1) == 42);
+  }
+  {
+    // Conversions that might be UB must only happen for empty optionals, i.e. they cannot use the bitwise version.
+    static_assert(tiny::impl::IsConversionFreeOfSideEffects<long, int>());
+    static_assert(tiny::impl::IsConversionFreeOfSideEffects<int, double>());
+    static_assert(!tiny::impl::IsConversionFreeOfSideEffects<double, int>());
+    static_assert(!tiny::impl::IsConversionFreeOfSideEffects<double, float>());
+    static_assert(!tiny::impl::IsConversionFreeOfSideEffects<int volatile &, int>());
+    tiny::optional<int, -1> empty;
+    tiny::optional<int, -1> const nonEmpty = 5;
+    ASSERT_TRUE(nonEmpty.value_or(1e100) == 5);
+    ASSERT_TRUE(empty.value_or(2.5) == 2);
+  }
+  {
+    tiny::optional<double> o1 = 1.0;
+    tiny::optional<double> o2;
+    o1.swap(o2);
+    ASSERT_TRUE(!o1.has_value());
+    ASSERT_TRUE(o2 == 1.0);
+    swap(o1, o2);
+    ASSERT_TRUE(o1 == 1.0);
+    ASSERT_TRUE(!o2.has_value());
+  }
+}
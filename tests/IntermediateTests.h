@@ -5,3 +5,5 @@ void test_IsIntegralInRange();
 void test_NanExploit();
 
 void test_SelectDecomposition();
+
+void test_BitwiseValueOrAndSwap();
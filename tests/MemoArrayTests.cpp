@@ -0,0 +1,193 @@
+#include "MemoArrayTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/memo_array.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace
+{
+template <class MemoT, class Compute>
+void ComputeAllInParallel(MemoT & memo, Compute const & compute, unsigned numThreads)
+{
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < numThreads; ++t) {
+    threads.emplace_back([&memo, &compute, t, numThreads]() {
+      // All threads run over all elements, with different start positions to provoke collisions.
+      std::size_t const size = memo.size();
+      for (std::size_t k = 0; k < size; ++k) {
+        std::size_t const i = (k + t * size / numThreads) % size;
+        ASSERT_TRUE(memo.get_or_compute(i, compute) == compute(i));
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+} // namespace
+
+
+void test_MemoArray()
+{
+  // Optionals of double and float store a separate bool with TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UB_TRICKS.
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  // The elements are as large as the payload.
+  {
+    tiny::memo_array<tiny::optional<double>> memo(100);
+    ASSERT_TRUE(memo.size() == 100);
+    static_assert(decltype(memo)::has_busy_state);
+    static_assert(!decltype(memo)::collects_statistics);
+    static_assert(!std::is_copy_constructible_v<decltype(memo)>);
+    static_assert(std::is_nothrow_move_constructible_v<decltype(memo)>);
+  }
+
+  // Sequential use.
+  {
+    tiny::memo_array<tiny::optional<double>, true> memo(10);
+    ASSERT_FALSE(memo.is_computed(3));
+    ASSERT_FALSE(memo.get(3).has_value());
+    ASSERT_TRUE(memo.count_computed() == 0);
+
+    int numCalls = 0;
+    auto const square = [&numCalls](std::size_t i) {
+      ++numCalls;
+      return static_cast<double>(i * i);
+    };
+    ASSERT_TRUE(memo.get_or_compute(3, square) == 9.0);
+    ASSERT_TRUE(memo.get_or_compute(3, square) == 9.0);
+    ASSERT_TRUE(memo.get_or_compute(4, square) == 16.0);
+    ASSERT_TRUE(numCalls == 2);
+    ASSERT_TRUE(memo.is_computed(3));
+    ASSERT_TRUE(memo.get(4) == 16.0);
+    ASSERT_TRUE(memo.count_computed() == 2);
+
+    tiny::memo_array_statistics const stats = memo.statistics();
+    ASSERT_TRUE(stats.hits == 1);
+    ASSERT_TRUE(stats.computations == 2);
+    ASSERT_TRUE(stats.collisions == 0);
+    ASSERT_TRUE(stats.calls == 3);
+    ASSERT_TRUE(stats.hit_rate() == 1.0 / 3.0);
+    memo.reset_statistics();
+    ASSERT_TRUE(memo.statistics().hits == 0);
+
+    ASSERT_TRUE(memo.set(5, -1.0));
+    ASSERT_FALSE(memo.set(5, -2.0));
+    ASSERT_TRUE(memo.get_or_compute(5, square) == -1.0);
+    ASSERT_TRUE(numCalls == 2);
+
+    memo.clear();
+    ASSERT_TRUE(memo.count_computed() == 0);
+    ASSERT_TRUE(memo.get_or_compute(3, square) == 9.0);
+    ASSERT_TRUE(numCalls == 3);
+
+    std::uint64_t const numCallsBeforeMove = memo.statistics().calls;
+    ASSERT_TRUE(numCallsBeforeMove > 0);
+    tiny::memo_array<tiny::optional<double>, true> moved = std::move(memo);
+    ASSERT_TRUE(moved.size() == 10);
+    ASSERT_TRUE(moved.get(3) == 9.0);
+    ASSERT_TRUE(memo.size() == 0); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+    ASSERT_TRUE(memo.count_computed() == 0);
+    memo.clear();
+    ASSERT_TRUE(memo.statistics().calls == 0);
+    memo.reset_statistics();
+
+    memo = std::move(moved);
+    ASSERT_TRUE(memo.size() == 10);
+    ASSERT_TRUE(memo.get(3) == 9.0);
+    ASSERT_TRUE(moved.size() == 0); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+    ASSERT_TRUE(moved.count_computed() == 0);
+    moved.clear();
+    ASSERT_TRUE(moved.statistics().hits == 0);
+    moved.reset_statistics();
+    ASSERT_TRUE(memo.statistics().calls == numCallsBeforeMove);
+  }
+
+  // A computation that loses the race against a concurrent store counts as one call, although it is both a computation
+  // and a collision. The race is simulated by storing the value from within the compute function.
+  {
+    tiny::memo_array<tiny::optional<int, -1>, true> memo(4);
+    auto const computeAndRace = [&memo](std::size_t i) {
+      memo.set(i, 10);
+      return 20;
+    };
+    ASSERT_TRUE(memo.get_or_compute(1, computeAndRace) == 10);
+    ASSERT_TRUE(memo.get_or_compute(1, computeAndRace) == 10);
+    tiny::memo_array_statistics const stats = memo.statistics();
+    ASSERT_TRUE(stats.calls == 2);
+    ASSERT_TRUE(stats.hits == 1);
+    ASSERT_TRUE(stats.computations == 1);
+    ASSERT_TRUE(stats.collisions == 1);
+    ASSERT_TRUE(stats.hit_rate() == 0.5);
+  }
+
+  // An exception leaves the element not computed.
+  {
+    tiny::memo_array<tiny::optional<float>> memo(4);
+    auto const throwing = [](std::size_t) -> float { throw std::runtime_error("compute"); };
+    EXPECT_EXCEPTION((void)memo.get_or_compute(1, throwing), std::runtime_error);
+    ASSERT_FALSE(memo.is_computed(1));
+    ASSERT_TRUE(memo.get_or_compute(1, [](std::size_t i) { return static_cast<float>(i) + 0.5f; }) == 1.5f);
+  }
+#endif
+
+  // Dynamic programming: Recursion into the table itself.
+  {
+    tiny::memo_array<tiny::optional<std::uint64_t, ~std::uint64_t{0}>> memo(91);
+    static_assert(!decltype(memo)::has_busy_state);
+    auto fibonacci = [&memo](std::size_t n, auto const & self) -> std::uint64_t {
+      return memo.get_or_compute(n, [&self](std::size_t i) -> std::uint64_t {
+        return i < 2 ? i : self(i - 1, self) + self(i - 2, self);
+      });
+    };
+    ASSERT_TRUE(fibonacci(90, fibonacci) == 2880067194370816120ull);
+    ASSERT_TRUE(memo.count_computed() == 91);
+  }
+
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  // Concurrent computation with de-duplication via the busy state: Every element is computed exactly once.
+  {
+    constexpr std::size_t size = 2000;
+    tiny::memo_array<tiny::optional<double>, true> memo(size);
+    ComputeAllInParallel(memo, [](std::size_t i) { return static_cast<double>(i) * 0.5; }, 4);
+    tiny::memo_array_statistics const stats = memo.statistics();
+    ASSERT_TRUE(stats.computations == size);
+    ASSERT_TRUE(stats.hits + stats.collisions == 3 * size);
+    ASSERT_TRUE(stats.calls == 4 * size);
+  }
+#endif
+
+  // Concurrent computation without busy state: Duplicate computations are possible, but all threads see the same value.
+  {
+    constexpr std::size_t size = 2000;
+    tiny::memo_array<tiny::optional<int, -1>, true> memo(size);
+    std::size_t numCorrect = 0;
+    auto const compute = [](std::size_t i) { return static_cast<int>(i % 1000); };
+    ComputeAllInParallel(memo, compute, 4);
+    for (std::size_t i = 0; i < size; ++i) {
+      numCorrect += memo.get(i) == compute(i) ? 1 : 0;
+    }
+    ASSERT_TRUE(numCorrect == size);
+    tiny::memo_array_statistics const stats = memo.statistics();
+    ASSERT_TRUE(stats.computations >= size);
+    ASSERT_TRUE(stats.computations - size <= stats.collisions);
+    ASSERT_TRUE(stats.hits + stats.computations == 4 * size);
+    ASSERT_TRUE(stats.calls == 4 * size);
+    ASSERT_TRUE(stats.hit_rate() == static_cast<double>(stats.hits) / static_cast<double>(4 * size));
+  }
+
+  // A user specified busy value enables de-duplication for other sentinels.
+  {
+    tiny::memo_array<tiny::optional<int, -1>, false, std::integral_constant<int, -2>> memo(16);
+    static_assert(decltype(memo)::has_busy_state);
+    ASSERT_TRUE(memo.get_or_compute(7, [](std::size_t i) { return static_cast<int>(i); }) == 7);
+    ASSERT_FALSE(memo.is_computed(6));
+  }
+}
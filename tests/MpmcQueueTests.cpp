@@ -0,0 +1,108 @@
+#include "MpmcQueueTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/mpmc_queue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+void test_MpmcQueue()
+{
+  using Optional = tiny::optional<std::uint32_t, ~0u>;
+  static_assert(sizeof(tiny::atomic_optional<Optional>) == sizeof(std::uint32_t));
+
+  // Single-threaded: FIFO order, full and empty detection, wrap-around.
+  {
+    tiny::mpmc_queue<Optional> queue(5);
+    ASSERT_TRUE(queue.capacity() == 8);
+    ASSERT_FALSE(queue.try_pop().has_value());
+
+    std::uint32_t nextPush = 0;
+    std::uint32_t nextPop = 0;
+    for (int round = 0; round < 10; ++round) {
+      while (queue.try_push(nextPush)) {
+        ++nextPush;
+      }
+      ASSERT_TRUE(nextPush - nextPop == 8);
+      for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(queue.try_pop() == nextPop);
+        ++nextPop;
+      }
+      queue.push(nextPush++);
+      ASSERT_TRUE(queue.pop() == nextPop++);
+    }
+    while (Optional const value = queue.try_pop()) {
+      ASSERT_TRUE(*value == nextPop);
+      ++nextPop;
+    }
+    ASSERT_TRUE(nextPop == nextPush);
+  }
+
+  // Several producers and consumers, mixing the blocking and non-blocking functions. Every value must be received
+  // exactly once.
+  {
+    constexpr std::uint32_t numProducers = 4;
+    constexpr std::uint32_t numConsumers = 3;
+    constexpr std::uint32_t numValuesPerProducer = 20000;
+    constexpr std::uint32_t numValues = numProducers * numValuesPerProducer;
+
+    tiny::mpmc_queue<Optional> queue(16);
+    std::vector<std::atomic<int>> received(numValues);
+    std::atomic<std::uint32_t> numReceived{0};
+    std::vector<std::thread> threads;
+
+    for (std::uint32_t p = 0; p < numProducers; ++p) {
+      threads.emplace_back([&, p] {
+        for (std::uint32_t i = 0; i < numValuesPerProducer; ++i) {
+          std::uint32_t const value = p * numValuesPerProducer + i;
+          if (p % 2 == 0) {
+            queue.push(value);
+          }
+          else {
+            while (!queue.try_push(value)) {
+              std::this_thread::yield();
+            }
+          }
+        }
+      });
+    }
+
+    for (std::uint32_t c = 0; c < numConsumers; ++c) {
+      threads.emplace_back([&] {
+        while (numReceived.load() < numValues) {
+          if (Optional const value = queue.try_pop()) {
+            ++received[*value];
+            ++numReceived;
+          }
+          else {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    for (std::thread & t : threads) {
+      t.join();
+    }
+
+    bool allReceivedOnce = true;
+    for (std::atomic<int> const & r : received) {
+      allReceivedOnce = allReceivedOnce && r.load() == 1;
+    }
+    ASSERT_TRUE(allReceivedOnce);
+    ASSERT_FALSE(queue.try_pop().has_value());
+  }
+
+  // Blocking pop() waits for values that are pushed later.
+  {
+    tiny::mpmc_queue<tiny::optional<int, -1>> queue(4);
+    int received = 0;
+    std::thread consumer([&] { received = queue.pop(); });
+    queue.push(42);
+    consumer.join();
+    ASSERT_TRUE(received == 42);
+  }
+}
@@ -0,0 +1,118 @@
+#include "OnceCellTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/once_cell.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+namespace
+{
+template <class CellType>
+void TestSingleThreaded(typename CellType::payload_type value1, typename CellType::payload_type value2)
+{
+  CellType cell;
+  ASSERT_FALSE(cell.is_initialized());
+  ASSERT_FALSE(cell.get().has_value());
+
+  // A throwing initialization leaves the cell uninitialized.
+  EXPECT_EXCEPTION((void)cell.get_or_init([]() -> typename CellType::payload_type { throw std::runtime_error("x"); }),
+                   std::runtime_error);
+  ASSERT_FALSE(cell.is_initialized());
+
+  int numCalls = 0;
+  auto const init = [&] {
+    ++numCalls;
+    return value1;
+  };
+  ASSERT_TRUE(cell.get_or_init(init) == value1);
+  ASSERT_TRUE(cell.get_or_init(init) == value1);
+  ASSERT_TRUE(numCalls == 1);
+  ASSERT_TRUE(cell.is_initialized());
+  ASSERT_TRUE(cell.get() == value1);
+  ASSERT_FALSE(cell.set(value2));
+  ASSERT_TRUE(cell.get() == value1);
+
+  CellType cell2;
+  ASSERT_TRUE(cell2.set(value2));
+  ASSERT_TRUE(cell2.get_or_init(init) == value2);
+  ASSERT_TRUE(numCalls == 1);
+}
+
+
+template <class CellType>
+void TestConcurrentInitialization(bool expectSingleInitialization)
+{
+  constexpr int numThreads = 8;
+  CellType cell;
+  std::atomic<int> numCalls{0};
+  std::atomic<bool> start{false};
+  std::vector<typename CellType::payload_type> results(numThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&, i] {
+      while (!start) {
+      }
+      results[static_cast<size_t>(i)] = cell.get_or_init([&] {
+        ++numCalls;
+        std::this_thread::yield();
+        return static_cast<typename CellType::payload_type>(100 + i);
+      });
+    });
+  }
+  start = true;
+  for (std::thread & t : threads) {
+    t.join();
+  }
+
+  ASSERT_TRUE(numCalls >= 1);
+  if (expectSingleInitialization) {
+    ASSERT_TRUE(numCalls == 1);
+  }
+  for (auto const & result : results) {
+    ASSERT_TRUE(result == results.front());
+    ASSERT_TRUE(cell.get() == result);
+  }
+}
+} // namespace
+
+
+void test_OnceCell()
+{
+  static_assert(sizeof(tiny::once_cell<tiny::optional<int, -1>>) == sizeof(int));
+
+  // Library-chosen sentinels provide an 'initializing' state automatically, user-defined ones do not.
+  static_assert(!tiny::once_cell<tiny::optional<int, -1>>::has_busy_state);
+  static_assert(tiny::once_cell<tiny::optional<int, -1>, std::integral_constant<int, -2>>::has_busy_state);
+
+  TestSingleThreaded<tiny::once_cell<tiny::optional<int, -1>>>(0, 42);
+  TestSingleThreaded<tiny::once_cell<tiny::optional<int, -1>, std::integral_constant<int, -2>>>(-3, 42);
+
+  TestConcurrentInitialization<tiny::once_cell<tiny::optional<int, -1>, std::integral_constant<int, -2>>>(true);
+  TestConcurrentInitialization<tiny::once_cell<tiny::optional<int, -1>>>(false);
+
+  // The BusyValue may differ from the sentinel in any single bit.
+  using CellWithBusyBit7 = tiny::once_cell<tiny::optional<unsigned, 0>, std::integral_constant<unsigned, 0x80>>;
+  TestSingleThreaded<CellWithBusyBit7>(0x81u, 1u);
+  TestConcurrentInitialization<CellWithBusyBit7>(true);
+
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  static_assert(sizeof(tiny::once_cell<tiny::optional<double>>) == sizeof(double));
+  static_assert(tiny::once_cell<tiny::optional<double>>::has_busy_state);
+  static_assert(tiny::once_cell<tiny::optional<float>>::has_busy_state);
+  static_assert(tiny::once_cell<tiny::optional<bool>>::has_busy_state);
+  static_assert(tiny::once_cell<tiny::optional<int *>>::has_busy_state);
+
+  int dummy1 = 0;
+  int dummy2 = 0;
+  TestSingleThreaded<tiny::once_cell<tiny::optional<double>>>(1.5, -2.0);
+  TestSingleThreaded<tiny::once_cell<tiny::optional<float>>>(0.0f, 3.0f);
+  TestSingleThreaded<tiny::once_cell<tiny::optional<bool>>>(false, true);
+  TestSingleThreaded<tiny::once_cell<tiny::optional<int *>>>(&dummy1, &dummy2);
+  TestConcurrentInitialization<tiny::once_cell<tiny::optional<double>>>(true);
+#endif
+}
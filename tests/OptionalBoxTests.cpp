@@ -0,0 +1,287 @@
+#include "OptionalBoxTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/optional_box.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+// Stand-in for a large payload that is mostly absent.
+struct LargePayload
+{
+  int id = 0;
+  char data[200] = {};
+};
+
+
+// std::allocator that counts the allocations and deallocations.
+template <class T>
+struct CountingAllocator
+{
+  using value_type = T;
+
+  CountingAllocator() noexcept = default;
+
+  template <class U>
+  CountingAllocator(CountingAllocator<U> const &) noexcept
+  {
+  }
+
+  T * allocate(std::size_t n)
+  {
+    ++numAllocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T * p, std::size_t n) noexcept
+  {
+    ++numDeallocations;
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  friend bool operator==(CountingAllocator const &, CountingAllocator const &) noexcept
+  {
+    return true;
+  }
+
+  friend bool operator!=(CountingAllocator const &, CountingAllocator const &) noexcept
+  {
+    return false;
+  }
+
+  static inline int numAllocations = 0;
+  static inline int numDeallocations = 0;
+};
+
+
+struct ThrowingConstructor
+{
+  explicit ThrowingConstructor(bool doThrow)
+  {
+    if (doThrow) {
+      throw std::runtime_error("ThrowingConstructor");
+    }
+  }
+};
+} // namespace
+
+
+void test_OptionalBox()
+{
+  // Sizes: A single pointer for stateless allocators, also inside a tiny::optional.
+  {
+    static_assert(sizeof(tiny::optional_box<LargePayload>) == sizeof(void *));
+    static_assert(sizeof(tiny::optional<tiny::optional_box<LargePayload>>) == sizeof(void *));
+    static_assert(sizeof(tiny::optional_box<LargePayload, CountingAllocator<LargePayload>>) == sizeof(void *));
+    static_assert(sizeof(tiny::optional_box<LargePayload, tiny::arena_allocator<LargePayload>>) == 2 * sizeof(void *));
+    using ArenaBox = tiny::optional_box<LargePayload, tiny::arena_allocator<LargePayload>>;
+    static_assert(sizeof(tiny::optional<ArenaBox>) == sizeof(ArenaBox));
+    static_assert(std::is_nothrow_move_constructible_v<tiny::optional_box<std::string>>);
+    static_assert(std::is_nothrow_move_assignable_v<tiny::optional_box<std::string>>);
+    static_assert(!std::is_nothrow_move_assignable_v<ArenaBox>);
+  }
+
+  // Value semantics.
+  {
+    tiny::optional_box<std::string> o;
+    ASSERT_FALSE(o.has_value());
+    ASSERT_FALSE(o);
+    ASSERT_TRUE(o.value_or("default") == "default");
+    EXPECT_EXCEPTION((void)o.value(), std::bad_optional_access);
+
+    o = "some string that does not fit into the small string buffer";
+    ASSERT_TRUE(o.has_value());
+    ASSERT_TRUE(o->size() == 58);
+
+    // Deep copy.
+    tiny::optional_box<std::string> copy = o;
+    ASSERT_TRUE(copy == o);
+    ASSERT_TRUE(&*copy != &*o);
+
+    // Assignment reuses the allocation.
+    std::string const * const addressBefore = &*copy;
+    copy = std::string("other");
+    ASSERT_TRUE(&*copy == addressBefore);
+    ASSERT_TRUE(*copy == "other");
+    copy = o;
+    ASSERT_TRUE(&*copy == addressBefore);
+    ASSERT_TRUE(copy == o);
+
+    // Moving transfers the allocation.
+    std::string const * const addressOfO = &*o;
+    tiny::optional_box<std::string> moved = std::move(o);
+    ASSERT_FALSE(o.has_value()); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+    ASSERT_TRUE(&*moved == addressOfO);
+    copy = std::move(moved);
+    ASSERT_FALSE(moved.has_value()); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+    ASSERT_TRUE(&*copy == addressOfO);
+
+    copy.emplace(3, 'x');
+    ASSERT_TRUE(copy == "xxx");
+    ASSERT_TRUE(std::move(copy).value() == "xxx");
+
+    tiny::optional_box<std::string> other(std::in_place, "abc");
+    copy.swap(other);
+    ASSERT_TRUE(copy == "abc" && other == "xxx");
+    other = std::nullopt;
+    ASSERT_FALSE(other.has_value());
+
+    tiny::optional_box<std::vector<int>> vec(std::in_place, {1, 2, 3});
+    ASSERT_TRUE(vec->size() == 3);
+    vec.emplace({4, 5});
+    ASSERT_TRUE(vec->size() == 2 && vec->back() == 5);
+  }
+
+  // Comparisons, with the same semantics as for tiny::optional.
+  {
+    tiny::optional_box<int> const empty;
+    tiny::optional_box<int> const one = 1;
+    tiny::optional_box<long> const two = 2L;
+
+    ASSERT_TRUE(empty == tiny::optional_box<int>());
+    ASSERT_TRUE(empty == std::nullopt);
+    ASSERT_TRUE(std::nullopt == empty);
+    ASSERT_TRUE(one != std::nullopt);
+    ASSERT_TRUE(empty < one);
+    ASSERT_TRUE(one < two);
+    ASSERT_TRUE(two >= one);
+    ASSERT_TRUE(empty <= std::nullopt);
+    ASSERT_FALSE(empty > std::nullopt);
+    ASSERT_TRUE(one == 1);
+    ASSERT_TRUE(2 == two);
+    ASSERT_TRUE(empty < 0);
+    ASSERT_TRUE(0 > empty);
+    ASSERT_FALSE(empty == 0);
+    ASSERT_TRUE(one != 2);
+#ifdef TINY_OPTIONAL_ENABLE_THREEWAY_COMPARISON
+    ASSERT_TRUE((one <=> two) < 0);
+    ASSERT_TRUE((empty <=> one) < 0);
+    ASSERT_TRUE((empty <=> std::nullopt) == 0);
+    ASSERT_TRUE((one <=> 0) > 0);
+#endif
+
+    ASSERT_TRUE(std::hash<tiny::optional_box<int>>{}(one) == std::hash<int>{}(1));
+    ASSERT_TRUE(std::hash<tiny::optional_box<int>>{}(empty) == 0);
+  }
+
+  // Allocations: None for empty boxes, and none for moves.
+  {
+    using Box = tiny::optional_box<LargePayload, CountingAllocator<LargePayload>>;
+    CountingAllocator<LargePayload>::numAllocations = 0;
+    CountingAllocator<LargePayload>::numDeallocations = 0;
+    {
+      std::vector<Box> boxes(100);
+      ASSERT_TRUE(CountingAllocator<LargePayload>::numAllocations == 0);
+      boxes[5].emplace().id = 5;
+      boxes[50] = LargePayload{50, {}};
+      ASSERT_TRUE(CountingAllocator<LargePayload>::numAllocations == 2);
+
+      std::vector<Box> copies = boxes;
+      ASSERT_TRUE(CountingAllocator<LargePayload>::numAllocations == 4);
+      ASSERT_TRUE(copies[50]->id == 50);
+      std::vector<Box> moved = std::move(boxes);
+      Box movedBox = std::move(copies[5]);
+      ASSERT_TRUE(CountingAllocator<LargePayload>::numAllocations == 4);
+      ASSERT_TRUE(movedBox->id == 5);
+    }
+    ASSERT_TRUE(CountingAllocator<LargePayload>::numDeallocations == 4);
+  }
+
+  // A throwing payload constructor frees the memory.
+  {
+    using Box = tiny::optional_box<ThrowingConstructor, CountingAllocator<ThrowingConstructor>>;
+    CountingAllocator<ThrowingConstructor>::numAllocations = 0;
+    CountingAllocator<ThrowingConstructor>::numDeallocations = 0;
+    EXPECT_EXCEPTION(Box(std::in_place, true), std::runtime_error);
+    Box box(std::in_place, false);
+    EXPECT_EXCEPTION(box.emplace(true), std::runtime_error);
+    ASSERT_FALSE(box.has_value());
+    ASSERT_TRUE(CountingAllocator<ThrowingConstructor>::numAllocations == 2);
+    ASSERT_TRUE(CountingAllocator<ThrowingConstructor>::numDeallocations == 2);
+  }
+
+  // Arena allocation.
+  {
+    using Box = tiny::optional_box<LargePayload, tiny::arena_allocator<LargePayload>>;
+    tiny::box_arena arena(1024);
+    {
+      std::vector<Box> boxes(100, Box(arena));
+      for (std::size_t i = 0; i < boxes.size(); i += 10) {
+        boxes[i].emplace().id = static_cast<int>(i);
+      }
+      ASSERT_TRUE(arena.bytes_used() == 10 * sizeof(LargePayload));
+      ASSERT_TRUE(boxes[90]->id == 90);
+      ASSERT_TRUE(boxes[1].get_allocator().arena() == &arena);
+    }
+
+    // Blocks larger than the block size.
+    struct Huge
+    {
+      char data[4000];
+    };
+    tiny::optional_box<Huge, tiny::arena_allocator<Huge>> huge(std::allocator_arg, arena, std::in_place);
+    ASSERT_TRUE(huge.has_value());
+    huge.reset();
+
+    arena.release();
+    ASSERT_TRUE(arena.bytes_used() == 0);
+    Box afterRelease(std::allocator_arg, arena, std::in_place, LargePayload{7, {}});
+    ASSERT_TRUE(afterRelease->id == 7);
+
+    // Without an arena, nothing can be allocated.
+    EXPECT_EXCEPTION(Box(std::in_place), std::bad_alloc);
+  }
+
+  // Boxes of different arenas: The payload stays in the arena of the target.
+  {
+    using Box = tiny::optional_box<std::string, tiny::arena_allocator<std::string>>;
+    tiny::box_arena arena1;
+    tiny::box_arena arena2;
+    Box box1(std::allocator_arg, arena1, std::in_place, "abc");
+    Box box2(arena2);
+
+    box2 = std::move(box1);
+    ASSERT_FALSE(box1.has_value()); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+    ASSERT_TRUE(box2 == std::string("abc"));
+    ASSERT_TRUE(box2.get_allocator().arena() == &arena2);
+
+    box1 = box2;
+    ASSERT_TRUE(box1 == box2);
+    ASSERT_TRUE(box1.get_allocator().arena() == &arena1);
+    ASSERT_TRUE(arena1.bytes_used() == 2 * sizeof(std::string));
+    ASSERT_TRUE(arena2.bytes_used() == sizeof(std::string));
+  }
+
+  // tiny::optional<optional_box> distinguishes "no box" from "empty box" without additional memory.
+  {
+    tiny::optional<tiny::optional_box<int>> o;
+    ASSERT_FALSE(o.has_value());
+    o.emplace();
+    ASSERT_TRUE(o.has_value());
+    ASSERT_FALSE(o->has_value());
+    o->emplace(42);
+    ASSERT_TRUE(**o == 42);
+
+    tiny::optional<tiny::optional_box<int>> copy = o;
+    ASSERT_TRUE(copy.has_value() && **copy == 42);
+    ASSERT_TRUE(&**copy != &**o);
+    o.reset();
+    ASSERT_FALSE(o.has_value());
+    o = std::move(copy);
+    ASSERT_TRUE(o.has_value() && **o == 42);
+    o = tiny::optional_box<int>();
+    ASSERT_TRUE(o.has_value());
+    ASSERT_FALSE(o->has_value());
+  }
+}
@@ -0,0 +1,120 @@
+#include "OptionalSpanTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/optional.h"
+
+#ifdef TINY_OPTIONAL_CPP20
+  #include "tiny/optional_span.h"
+
+  #include <cmath>
+  #include <cstdint>
+  #include <cstring>
+  #include <optional>
+  #include <span>
+  #include <string>
+  #include <vector>
+#endif
+
+
+void test_OptionalSpan()
+{
+  // std::span only exists since C++20.
+#ifdef TINY_OPTIONAL_CPP20
+  // Compile time checks of the layout requirements.
+  {
+    static_assert(tiny::is_optional_span_compatible_v<tiny::optional<int, -1>, int>);
+    static_assert(tiny::is_optional_span_compatible_v<tiny::optional<int, -1>, int const>);
+    static_assert(tiny::is_optional_span_compatible_v<tiny::optional_aip<std::uint32_t>, std::uint32_t>);
+    static_assert(
+        tiny::is_optional_span_compatible_v<tiny::optional_sentinel_via_type<int, std::integral_constant<int, 0>>, int>);
+  #ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+    static_assert(tiny::is_optional_span_compatible_v<tiny::optional<double>, double>);
+    static_assert(tiny::is_optional_span_compatible_v<tiny::optional<float>, float>);
+    static_assert(tiny::is_optional_span_compatible_v<tiny::optional<bool>, bool>);
+    static_assert(tiny::is_optional_span_compatible_v<tiny::optional<int *>, int *>);
+  #endif
+
+    // Wrong payload type.
+    static_assert(!tiny::is_optional_span_compatible_v<tiny::optional<int, -1>, unsigned>);
+    static_assert(!tiny::is_optional_span_compatible_v<tiny::optional<int, -1>, int volatile>);
+    // Not a tiny optional.
+    static_assert(!tiny::is_optional_span_compatible_v<std::optional<int>, int>);
+    static_assert(!tiny::is_optional_span_compatible_v<int, int>);
+    // Separate bool.
+    static_assert(!tiny::is_optional_span_compatible_v<tiny::optional<int>, int>);
+    // Not trivially copyable.
+    static_assert(!tiny::is_optional_span_compatible_v<tiny::optional<std::string>, std::string>);
+  }
+
+  // Legacy int buffer with -1 as 'missing'.
+  {
+    std::vector<std::int32_t> raw = {1, -1, 3, -1, 5};
+    std::span<tiny::optional<std::int32_t, -1>> const view
+        = tiny::as_optional_span<tiny::optional<std::int32_t, -1>>(std::span{raw});
+    ASSERT_TRUE(view.size() == raw.size());
+    ASSERT_TRUE(static_cast<void *>(view.data()) == static_cast<void *>(raw.data()));
+    ASSERT_TRUE(view[0] == 1);
+    ASSERT_FALSE(view[1].has_value());
+    ASSERT_TRUE(view[2] == 3);
+    ASSERT_FALSE(view[3].has_value());
+    ASSERT_TRUE(view[4] == 5);
+
+    // Writing through the view modifies the original memory.
+    view[0].reset();
+    view[1] = 42;
+    view[2].emplace(43);
+
+    std::span<std::int32_t> const back = tiny::as_payload_span(view);
+    ASSERT_TRUE(back.data() == raw.data());
+    ASSERT_TRUE(back[0] == -1);
+    ASSERT_TRUE(back[1] == 42);
+    ASSERT_TRUE(back[2] == 43);
+    ASSERT_TRUE(back[3] == -1);
+  }
+
+  // Constness and static extents are preserved.
+  {
+    std::int64_t const raw[3] = {-7, 0, 7};
+    auto const view = tiny::as_optional_span<tiny::optional<std::int64_t, 0>>(std::span{raw});
+    static_assert(std::is_same_v<decltype(view), std::span<tiny::optional<std::int64_t, 0> const, 3> const>);
+    ASSERT_TRUE(view[0] == -7);
+    ASSERT_FALSE(view[1].has_value());
+    ASSERT_TRUE(view[2] == 7);
+
+    auto const back = tiny::as_payload_span(view);
+    static_assert(std::is_same_v<decltype(back), std::span<std::int64_t const, 3> const>);
+    ASSERT_TRUE(back.data() == raw);
+  }
+
+  // Empty spans.
+  {
+    std::span<int> const raw;
+    auto const view = tiny::as_optional_span<tiny::optional<int, -1>>(raw);
+    ASSERT_TRUE(view.empty());
+  }
+
+  #ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  // Doubles: The library's NaN sentinel and a custom NaN of some existing data format.
+  {
+    std::vector<double> raw(3, 1.5);
+    auto const view = tiny::as_optional_span<tiny::optional<double>>(std::span{raw});
+    view[1] = std::nullopt;
+    ASSERT_TRUE(view[0] == 1.5);
+    ASSERT_FALSE(view[1].has_value());
+    ASSERT_TRUE(std::isnan(tiny::as_payload_span(view)[1]));
+
+    constexpr std::uint64_t customNaN = UINT64_C(0x7ff80000deadbeef);
+    using CustomNaNOptional = tiny::optional_inplace<double, tiny::bit_pattern_flag_manipulator<double, customNaN>>;
+    static_assert(tiny::is_optional_span_compatible_v<CustomNaNOptional, double>);
+    double customNaNAsDouble;
+    std::memcpy(&customNaNAsDouble, &customNaN, sizeof(double));
+    std::vector<double> legacy = {customNaNAsDouble, 2.0, std::nan("")};
+    auto const legacyView = tiny::as_optional_span<CustomNaNOptional>(std::span{legacy});
+    ASSERT_FALSE(legacyView[0].has_value());
+    ASSERT_TRUE(legacyView[1] == 2.0);
+    // Only the specific NaN indicates the empty state, other NaNs are ordinary values.
+    ASSERT_TRUE(legacyView[2].has_value());
+  }
+  #endif
+#endif
+}
@@ -0,0 +1,132 @@
+#include "ParallelAlgorithmsTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/parallel_algorithms.h"
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// A user-defined executor that starts new threads for every invocation.
+struct NewThreadsExecutor
+{
+  std::size_t size() const
+  {
+    return 3;
+  }
+
+  template <class Func>
+  void parallel_invoke(std::size_t numWorkers, Func const & func)
+  {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numWorkers; ++i) {
+      threads.emplace_back([&func, i] { func(i); });
+    }
+    func(0);
+    for (std::thread & t : threads) {
+      t.join();
+    }
+  }
+};
+
+
+template <class OptionalType, class Executor>
+void TestAlgorithms(Executor & executor, std::size_t count, std::size_t grainSize)
+{
+  using T = typename OptionalType::value_type;
+
+  std::mt19937 rng(42);
+  std::vector<OptionalType> data(count);
+  std::size_t expectedCount = 0;
+  T expectedSum = 0;
+  std::vector<T> expectedValues;
+  std::vector<std::size_t> expectedIndices;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (rng() % 3 != 0) {
+      T const value = static_cast<T>(rng() % 100);
+      data[i] = value;
+      ++expectedCount;
+      expectedSum += value;
+      expectedValues.push_back(value);
+      expectedIndices.push_back(i);
+    }
+  }
+
+  ASSERT_TRUE(tiny::parallel_count_present(executor, data.data(), count, grainSize) == expectedCount);
+
+  T const sum = tiny::parallel_reduce_present(
+      executor, data.data(), count, T{1}, [](T a, T b) { return a + b; }, grainSize);
+  ASSERT_TRUE(sum == expectedSum + 1);
+
+  std::vector<T> values(expectedCount);
+  std::vector<std::size_t> indices(expectedCount);
+  ASSERT_TRUE(
+      tiny::parallel_compact(executor, data.data(), count, values.data(), indices.data(), grainSize) == expectedCount);
+  ASSERT_TRUE(values == expectedValues);
+  ASSERT_TRUE(indices == expectedIndices);
+
+  std::vector<std::optional<std::int64_t>> transformed(count);
+  tiny::parallel_transform_present(
+      executor,
+      data.data(),
+      count,
+      transformed.data(),
+      [](T v) { return static_cast<std::int64_t>(v) * 2; },
+      grainSize);
+  bool transformedCorrectly = true;
+  for (std::size_t i = 0; i < count; ++i) {
+    transformedCorrectly = transformedCorrectly && transformed[i].has_value() == data[i].has_value()
+                           && (!data[i].has_value() || *transformed[i] == static_cast<std::int64_t>(*data[i]) * 2);
+  }
+  ASSERT_TRUE(transformedCorrectly);
+
+  tiny::parallel_fill_empty(executor, data.data(), count, T{-1}, grainSize);
+  ASSERT_TRUE(tiny::parallel_count_present(executor, data.data(), count, grainSize) == count);
+  ASSERT_TRUE(
+      tiny::parallel_reduce_present(executor, data.data(), count, T{0}, [](T a, T b) { return a + b; }, grainSize)
+      == expectedSum - static_cast<T>(count - expectedCount));
+}
+} // namespace
+
+
+void test_ParallelAlgorithms()
+{
+  tiny::thread_pool pool(4);
+  ASSERT_TRUE(pool.size() == 4);
+
+  std::vector<std::size_t> const counts = {0, 1, 5, 1000, 100000};
+  std::vector<std::size_t> const grainSizes = {1, 7, 1024, tiny::default_parallel_grain_size};
+  for (std::size_t const count : counts) {
+    for (std::size_t const grainSize : grainSizes) {
+      if (count / grainSize > 20000) {
+        continue;
+      }
+      TestAlgorithms<tiny::optional<double>>(pool, count, grainSize);
+      TestAlgorithms<tiny::optional<int, -1000>>(pool, count, grainSize);
+      TestAlgorithms<std::optional<std::int64_t>>(pool, count, grainSize);
+    }
+  }
+
+  NewThreadsExecutor executor;
+  TestAlgorithms<tiny::optional<float>>(executor, 10000, 100);
+
+  tiny::thread_pool singleThreadPool(1);
+  TestAlgorithms<tiny::optional<double>>(singleThreadPool, 10000, 100);
+
+  // Exceptions are propagated to the caller, and the pool remains usable.
+  {
+    std::vector<tiny::optional<int, -1>> data(1000, 1);
+    EXPECT_EXCEPTION(
+        tiny::parallel_transform_present(
+            pool, data.data(), data.size(), data.data(),
+            [](int) -> int { throw std::runtime_error("parallel_transform_present"); }, 10),
+        std::runtime_error);
+    ASSERT_TRUE(tiny::parallel_count_present(pool, data.data(), data.size(), 10) == 1000);
+  }
+}
@@ -0,0 +1,221 @@
+#include "RelocationTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/relocation.h"
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+namespace
+{
+// Owns a heap allocated int, like std::unique_ptr. Counts the calls of its move constructor and destructor.
+struct OwningHandle
+{
+  static inline int numMoves = 0;
+  static inline int numDestructions = 0;
+
+  explicit OwningHandle(int value)
+    : ptr(new int(value))
+  {
+  }
+
+  OwningHandle(OwningHandle && rhs) noexcept
+    : ptr(rhs.ptr)
+  {
+    rhs.ptr = nullptr;
+    ++numMoves;
+  }
+
+  OwningHandle & operator=(OwningHandle && rhs) noexcept
+  {
+    std::swap(ptr, rhs.ptr);
+    return *this;
+  }
+
+  ~OwningHandle()
+  {
+    delete ptr;
+    ++numDestructions;
+  }
+
+  int * ptr;
+};
+
+
+// Like OwningHandle, but not marked as trivially relocatable. Its move constructor throws on request.
+struct ThrowingPayload
+{
+  static inline int numAlive = 0;
+  static inline int throwOnMoveOfValue = -1;
+
+  explicit ThrowingPayload(int value)
+    : value(value)
+  {
+    ++numAlive;
+  }
+
+  ThrowingPayload(ThrowingPayload && rhs)
+    : value(rhs.value)
+  {
+    if (rhs.value == throwOnMoveOfValue) {
+      throw std::runtime_error("ThrowingPayload");
+    }
+    ++numAlive;
+  }
+
+  ~ThrowingPayload()
+  {
+    --numAlive;
+  }
+
+  int value;
+};
+
+
+// Points into itself, so it must never be relocated via memcpy.
+struct SelfReferencing
+{
+  SelfReferencing()
+    : self(this)
+  {
+  }
+
+  SelfReferencing(SelfReferencing const &)
+    : self(this)
+  {
+  }
+
+  SelfReferencing * self;
+};
+} // namespace
+
+
+template <>
+struct tiny::is_trivially_relocatable<OwningHandle> : std::true_type
+{
+};
+
+
+void test_Relocation()
+{
+  // The trait
+  {
+    static_assert(tiny::is_trivially_relocatable_v<int>);
+    static_assert(tiny::is_trivially_relocatable_v<double *>);
+    static_assert(tiny::is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(tiny::is_trivially_relocatable_v<OwningHandle>);
+    static_assert(!tiny::is_trivially_relocatable_v<SelfReferencing>);
+    static_assert(!tiny::is_trivially_relocatable_v<ThrowingPayload>);
+
+    // Propagation through tiny::optional, both with separate flag and with the flag inside the payload.
+    static_assert(tiny::is_trivially_relocatable_v<tiny::optional<double>>);
+    static_assert(tiny::is_trivially_relocatable_v<tiny::optional<int, -1>>);
+    static_assert(tiny::is_trivially_relocatable_v<tiny::optional<std::unique_ptr<int>>>);
+    static_assert(tiny::is_trivially_relocatable_v<tiny::optional<OwningHandle>>);
+    static_assert(!tiny::is_trivially_relocatable_v<tiny::optional<SelfReferencing>>);
+    static_assert(!tiny::is_trivially_relocatable_v<tiny::optional<ThrowingPayload>>);
+    static_assert(!std::is_trivially_copyable_v<tiny::optional<std::unique_ptr<int>>>);
+  }
+
+  // relocate_at() of a trivially relocatable type copies the bytes without calling the move constructor or destructor.
+  {
+    OwningHandle::numMoves = 0;
+    OwningHandle::numDestructions = 0;
+    alignas(OwningHandle) unsigned char sourceBuffer[sizeof(OwningHandle)];
+    alignas(OwningHandle) unsigned char destBuffer[sizeof(OwningHandle)];
+    OwningHandle * source = ::new (static_cast<void *>(sourceBuffer)) OwningHandle(42);
+    OwningHandle * dest = tiny::relocate_at(source, reinterpret_cast<OwningHandle *>(destBuffer));
+    ASSERT_TRUE(*dest->ptr == 42);
+    ASSERT_TRUE(OwningHandle::numMoves == 0);
+    ASSERT_TRUE(OwningHandle::numDestructions == 0);
+    dest->~OwningHandle();
+  }
+
+  // relocate_at() of other types moves and destroys.
+  {
+    ThrowingPayload::numAlive = 0;
+    ThrowingPayload::throwOnMoveOfValue = -1;
+    alignas(ThrowingPayload) unsigned char sourceBuffer[sizeof(ThrowingPayload)];
+    alignas(ThrowingPayload) unsigned char destBuffer[sizeof(ThrowingPayload)];
+    ThrowingPayload * source = ::new (static_cast<void *>(sourceBuffer)) ThrowingPayload(42);
+    ThrowingPayload * dest = tiny::relocate_at(source, reinterpret_cast<ThrowingPayload *>(destBuffer));
+    ASSERT_TRUE(dest->value == 42);
+    ASSERT_TRUE(ThrowingPayload::numAlive == 1);
+    dest->~ThrowingPayload();
+  }
+
+  // uninitialized_relocate() of empty and non-empty optionals.
+  {
+    using Optional = tiny::optional<OwningHandle>;
+    constexpr int numElements = 10;
+    std::allocator<Optional> alloc;
+    Optional * const source = alloc.allocate(numElements);
+    Optional * const dest = alloc.allocate(numElements);
+    for (int i = 0; i < numElements; ++i) {
+      if (i % 3 == 0) {
+        ::new (static_cast<void *>(source + i)) Optional();
+      }
+      else {
+        ::new (static_cast<void *>(source + i)) Optional(std::in_place, i);
+      }
+    }
+
+    OwningHandle::numMoves = 0;
+    OwningHandle::numDestructions = 0;
+    Optional * const destEnd = tiny::uninitialized_relocate(source, source + numElements, dest);
+    ASSERT_TRUE(destEnd == dest + numElements);
+    ASSERT_TRUE(OwningHandle::numMoves == 0);
+    ASSERT_TRUE(OwningHandle::numDestructions == 0);
+    for (int i = 0; i < numElements; ++i) {
+      ASSERT_TRUE(dest[i].has_value() == (i % 3 != 0));
+      if (dest[i].has_value()) {
+        ASSERT_TRUE(*dest[i]->ptr == i);
+      }
+    }
+
+    std::destroy(dest, destEnd);
+    ASSERT_TRUE(OwningHandle::numDestructions == numElements - 4);
+    alloc.deallocate(source, numElements);
+    alloc.deallocate(dest, numElements);
+  }
+
+  // uninitialized_relocate() with a throwing move constructor destroys everything.
+  {
+    ThrowingPayload::numAlive = 0;
+    constexpr int numElements = 5;
+    std::allocator<ThrowingPayload> alloc;
+    ThrowingPayload * const source = alloc.allocate(numElements);
+    ThrowingPayload * const dest = alloc.allocate(numElements);
+
+    for (int i = 0; i < numElements; ++i) {
+      ::new (static_cast<void *>(source + i)) ThrowingPayload(i);
+    }
+    ThrowingPayload::throwOnMoveOfValue = -1;
+    ThrowingPayload * destEnd = tiny::uninitialized_relocate(source, source + numElements, dest);
+    ASSERT_TRUE(destEnd == dest + numElements);
+    ASSERT_TRUE(ThrowingPayload::numAlive == numElements);
+    for (int i = 0; i < numElements; ++i) {
+      ASSERT_TRUE(dest[i].value == i);
+    }
+
+    ThrowingPayload::throwOnMoveOfValue = 3;
+    EXPECT_EXCEPTION(tiny::uninitialized_relocate(dest, dest + numElements, source), std::runtime_error);
+    ASSERT_TRUE(ThrowingPayload::numAlive == 0);
+
+    alloc.deallocate(source, numElements);
+    alloc.deallocate(dest, numElements);
+  }
+
+  // Empty ranges
+  {
+    std::string * const p = nullptr;
+    ASSERT_TRUE(tiny::uninitialized_relocate(p, p, p) == nullptr);
+    int * const q = nullptr;
+    ASSERT_TRUE(tiny::uninitialized_relocate(q, q, q) == nullptr);
+  }
+}
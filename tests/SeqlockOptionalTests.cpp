@@ -0,0 +1,114 @@
+#include "SeqlockOptionalTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/seqlock_optional.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// A payload whose fields are all equal if it was not torn.
+struct Quote
+{
+  std::uint64_t fields[8];
+  std::uint8_t odd[3]; // Size is not a multiple of the word size.
+
+  static Quote Make(std::uint64_t value)
+  {
+    Quote q{};
+    for (std::uint64_t & f : q.fields) {
+      f = value;
+    }
+    for (std::uint8_t & o : q.odd) {
+      o = static_cast<std::uint8_t>(value);
+    }
+    return q;
+  }
+
+  bool IsConsistent() const
+  {
+    for (std::uint64_t const f : fields) {
+      if (f != fields[0]) {
+        return false;
+      }
+    }
+    for (std::uint8_t const o : odd) {
+      if (o != static_cast<std::uint8_t>(fields[0])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+} // namespace
+
+
+void test_SeqlockOptional()
+{
+  // Single-threaded.
+  {
+    tiny::seqlock_optional<Quote> s;
+    ASSERT_FALSE(s.has_value());
+    ASSERT_FALSE(s.load().has_value());
+
+    s.store(Quote::Make(5));
+    ASSERT_TRUE(s.has_value());
+    tiny::optional<Quote> const loaded = s.load();
+    ASSERT_TRUE(loaded.has_value() && loaded->IsConsistent() && loaded->fields[0] == 5);
+
+    s.reset();
+    ASSERT_FALSE(s.has_value());
+    ASSERT_FALSE(s.load().has_value());
+    s.store(Quote::Make(6));
+    ASSERT_TRUE(s.load()->fields[0] == 6);
+
+    tiny::seqlock_optional<double> const d(2.5);
+    ASSERT_TRUE(d.load() == 2.5);
+
+    tiny::seqlock_optional<char> c;
+    c.store('x');
+    ASSERT_TRUE(c.load() == 'x');
+  }
+
+  // One writer, several readers: Readers never observe torn payloads, and the versions they see never decrease.
+  {
+    constexpr std::uint64_t numWrites = 20000;
+    tiny::seqlock_optional<Quote> s;
+    std::atomic<bool> done{false};
+    std::atomic<bool> allConsistent{true};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+      readers.emplace_back([&] {
+        std::uint64_t lastSeen = 0;
+        while (!done) {
+          if (tiny::optional<Quote> const q = s.load()) {
+            if (!q->IsConsistent() || q->fields[0] < lastSeen) {
+              allConsistent = false;
+            }
+            lastSeen = q->fields[0];
+          }
+        }
+      });
+    }
+
+    for (std::uint64_t i = 1; i <= numWrites; ++i) {
+      if (i % 7 == 0) {
+        s.reset();
+      }
+      else {
+        s.store(Quote::Make(i));
+      }
+    }
+    done = true;
+    for (std::thread & t : readers) {
+      t.join();
+    }
+    ASSERT_TRUE(allConsistent);
+    ASSERT_TRUE(s.load()->fields[0] == numWrites);
+  }
+}
@@ -0,0 +1,205 @@
+#include "SlotPoolTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/slot_pool.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+struct CountedPayload
+{
+  static inline int numAlive = 0;
+
+  explicit CountedPayload(int value, bool throwInConstructor = false)
+    : value(value)
+  {
+    if (throwInConstructor) {
+      throw std::runtime_error("CountedPayload");
+    }
+    ++numAlive;
+  }
+
+  CountedPayload(CountedPayload const & rhs)
+    : value(rhs.value)
+  {
+    ++numAlive;
+  }
+
+  ~CountedPayload()
+  {
+    --numAlive;
+  }
+
+  int value;
+};
+
+
+template <class PoolT>
+std::vector<int> CollectValues(PoolT const & pool)
+{
+  std::vector<int> values;
+  for (auto const & v : pool) {
+    values.push_back(v.value);
+  }
+  return values;
+}
+} // namespace
+
+
+void test_SlotPool()
+{
+  // Basic insertion, lookup and erasure.
+  {
+    tiny::slot_pool<std::string> pool;
+    ASSERT_TRUE(pool.empty());
+    ASSERT_TRUE(pool.capacity() == 0);
+    ASSERT_FALSE(pool.contains(tiny::slot_pool_handle{}));
+    ASSERT_TRUE(pool.get(tiny::slot_pool_handle{}) == nullptr);
+
+    auto const h1 = pool.insert("first");
+    auto const h2 = pool.emplace(3u, 'x');
+    ASSERT_TRUE(pool.size() == 2);
+    ASSERT_TRUE(pool.capacity() == decltype(pool)::chunk_size);
+    ASSERT_TRUE(h1 != h2);
+    ASSERT_TRUE(pool.contains(h1));
+    ASSERT_TRUE(pool[h1] == "first");
+    ASSERT_TRUE(*pool.get(h2) == "xxx");
+
+    ASSERT_TRUE(pool.erase(h1));
+    ASSERT_TRUE(pool.size() == 1);
+    ASSERT_FALSE(pool.contains(h1));
+    ASSERT_TRUE(pool.get(h1) == nullptr);
+    ASSERT_FALSE(pool.erase(h1));
+
+    // The freed slot is reused (LIFO free list), but the stale handle must not match the new element.
+    auto const h3 = pool.insert("third");
+    ASSERT_TRUE(h3.index == h1.index);
+    ASSERT_TRUE(h3.generation != h1.generation);
+    ASSERT_FALSE(pool.contains(h1));
+    ASSERT_TRUE(pool[h3] == "third");
+  }
+
+  // Free list is threaded through the payloads: Erasing in arbitrary order and re-inserting reuses the slots
+  // without growing the pool.
+  {
+    tiny::slot_pool<double, 64> pool;
+    std::vector<tiny::slot_pool_handle> handles;
+    for (int i = 0; i < 64; ++i) {
+      handles.push_back(pool.insert(i * 1.5));
+    }
+    ASSERT_TRUE(pool.capacity() == 64);
+
+    for (int i = 0; i < 64; i += 3) {
+      ASSERT_TRUE(pool.erase(handles[static_cast<size_t>(i)]));
+    }
+    for (int i = 0; i < 64; i += 3) {
+      handles[static_cast<size_t>(i)] = pool.insert(-1.0 * i);
+    }
+    ASSERT_TRUE(pool.capacity() == 64);
+    ASSERT_TRUE(pool.size() == 64);
+    for (int i = 0; i < 64; ++i) {
+      double const expected = (i % 3 == 0) ? -1.0 * i : i * 1.5;
+      ASSERT_TRUE(pool[handles[static_cast<size_t>(i)]] == expected);
+    }
+  }
+
+  // Iteration skips free slots, also across chunk and mask-word boundaries.
+  {
+    tiny::slot_pool<CountedPayload, 128> pool;
+    std::vector<tiny::slot_pool_handle> handles;
+    for (int i = 0; i < 300; ++i) {
+      handles.push_back(pool.emplace(i));
+    }
+    ASSERT_TRUE(pool.capacity() == 384);
+    for (int i = 0; i < 300; ++i) {
+      if (i % 7 != 0 && i != 299) {
+        pool.erase(handles[static_cast<size_t>(i)]);
+      }
+    }
+
+    std::vector<int> expected;
+    for (int i = 0; i < 300; ++i) {
+      if (i % 7 == 0 || i == 299) {
+        expected.push_back(i);
+      }
+    }
+    ASSERT_TRUE(CollectValues(pool) == expected);
+    ASSERT_TRUE(pool.size() == expected.size());
+    ASSERT_TRUE(CountedPayload::numAlive == static_cast<int>(expected.size()));
+
+    // The iterator exposes the handles.
+    for (auto it = pool.begin(); it != pool.end(); ++it) {
+      ASSERT_TRUE(pool.get(it.get_handle()) == &*it);
+    }
+  }
+  ASSERT_TRUE(CountedPayload::numAlive == 0);
+
+  // Addresses are stable when the pool grows.
+  {
+    tiny::slot_pool<int, 64> pool;
+    auto const h = pool.insert(42);
+    int const * const address = pool.get(h);
+    for (int i = 0; i < 1000; ++i) {
+      pool.insert(i);
+    }
+    ASSERT_TRUE(pool.get(h) == address);
+    ASSERT_TRUE(*address == 42);
+  }
+
+  // A throwing constructor leaves the pool intact.
+  {
+    tiny::slot_pool<CountedPayload, 64> pool;
+    auto const h1 = pool.emplace(1);
+    auto const h2 = pool.emplace(2);
+    pool.erase(h1);
+    EXPECT_EXCEPTION(pool.emplace(3, true), std::runtime_error);
+    ASSERT_TRUE(pool.size() == 1);
+    auto const h4 = pool.emplace(4);
+    ASSERT_TRUE(h4.index == h1.index);
+    auto const h5 = pool.emplace(5);
+    ASSERT_TRUE(h5.index != h2.index && h5.index != h4.index);
+    ASSERT_TRUE(CollectValues(pool) == (std::vector<int>{4, 2, 5}));
+  }
+  ASSERT_TRUE(CountedPayload::numAlive == 0);
+
+  // clear() destroys everything and invalidates all handles; move transfers ownership.
+  {
+    tiny::slot_pool<CountedPayload, 64> pool;
+    auto const h1 = pool.emplace(1);
+    pool.emplace(2);
+    pool.clear();
+    ASSERT_TRUE(pool.empty());
+    ASSERT_TRUE(CountedPayload::numAlive == 0);
+    ASSERT_FALSE(pool.contains(h1));
+    ASSERT_TRUE(pool.capacity() == 64);
+
+    auto const h3 = pool.emplace(3);
+    ASSERT_TRUE(h3.index == 0);
+    ASSERT_TRUE(h3 != h1);
+
+    tiny::slot_pool<CountedPayload, 64> moved = std::move(pool);
+    ASSERT_TRUE(moved.size() == 1);
+    ASSERT_TRUE(moved[h3].value == 3);
+    ASSERT_TRUE(pool.empty()); // NOLINT(clang-analyzer-cplusplus.Move)
+    ASSERT_TRUE(CountedPayload::numAlive == 1);
+
+    moved.reserve(200);
+    ASSERT_TRUE(moved.capacity() == 256);
+  }
+  ASSERT_TRUE(CountedPayload::numAlive == 0);
+
+  // Move-only payloads.
+  {
+    tiny::slot_pool<std::unique_ptr<int>> pool;
+    auto const h = pool.insert(std::make_unique<int>(42));
+    ASSERT_TRUE(**pool.get(h) == 42);
+    tiny::slot_pool<std::unique_ptr<int>> const & constPool = pool;
+    ASSERT_TRUE(*constPool[h] == 42);
+    ASSERT_TRUE(std::distance(constPool.begin(), constPool.end()) == 1);
+  }
+}
@@ -0,0 +1,158 @@
+#include "SparseColumnTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/sparse_column.h"
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+// Compares all access paths of the column against a plain vector of std::optionals.
+template <class Column, class T>
+void CheckColumn(Column const & column, std::vector<std::optional<T>> const & expected)
+{
+  ASSERT_TRUE(column.size() == expected.size());
+
+  std::size_t numPresent = 0;
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_TRUE(column[i] == expected[i]);
+    numPresent += expected[i].has_value() ? 1 : 0;
+  }
+  ASSERT_TRUE(column.count_present() == numPresent);
+
+  std::size_t idx = 0;
+  for (auto it = column.begin(); it != column.end(); ++it, ++idx) {
+    ASSERT_TRUE(it.get_index() == idx);
+    ASSERT_TRUE(*it == expected[idx]);
+  }
+  ASSERT_TRUE(idx == expected.size());
+
+  std::vector<std::pair<std::size_t, T>> visited;
+  column.for_each_present([&](std::size_t index, T const & value) { visited.emplace_back(index, value); });
+  ASSERT_TRUE(visited.size() == numPresent);
+  for (auto const & [index, value] : visited) {
+    ASSERT_TRUE(expected[index] == value);
+  }
+}
+} // namespace
+
+
+void test_SparseColumn()
+{
+  // Adaptive choice of the representation per chunk.
+  {
+    tiny::sparse_column<tiny::optional<double>, 64> column;
+    std::vector<std::optional<double>> expected;
+    auto const add = [&](std::optional<double> v) {
+      column.push_back(v.has_value() ? tiny::optional<double>(*v) : tiny::optional<double>());
+      expected.push_back(v);
+    };
+
+    // Chunk 0: Dense, all present.
+    for (int i = 0; i < 64; ++i) {
+      add(i * 0.5);
+    }
+    // Chunk 1: A few runs of values in a sea of empty elements ==> sparse.
+    for (int i = 0; i < 64; ++i) {
+      add((i == 0 || (i >= 10 && i < 13) || i == 63) ? std::optional<double>(-i) : std::nullopt);
+    }
+    // Chunk 2: Alternating ==> many runs, dense is smaller.
+    for (int i = 0; i < 64; ++i) {
+      add(i % 2 == 0 ? std::optional<double>(i) : std::nullopt);
+    }
+    // Chunk 3: Incomplete, remains dense for now.
+    for (int i = 0; i < 5; ++i) {
+      add(i == 3 ? std::optional<double>(3.0) : std::nullopt);
+    }
+
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+    std::size_t const numSparseChunks = 1;
+#else
+    // With the separate bool, the optional is twice as large, so also chunks 0 and 2 are smaller in sparse form.
+    std::size_t const numSparseChunks = 3;
+#endif
+    ASSERT_TRUE(column.num_sparse_chunks() == numSparseChunks);
+    CheckColumn(column, expected);
+
+    // Modifications in all kinds of chunks.
+    column.set(70, 42.0);
+    expected[70] = 42.0;
+    column.set(64, tiny::optional<double>{});
+    expected[64] = std::nullopt;
+    column.set(1, std::nullopt);
+    expected[1] = std::nullopt;
+    column.set(194, 1.0);
+    expected[194] = 1.0;
+    ASSERT_TRUE(column.num_sparse_chunks() == numSparseChunks);
+    CheckColumn(column, expected);
+
+    // Filling a sparse chunk makes it dense.
+    for (std::size_t i = 64; i < 128; ++i) {
+      column.set(i, static_cast<double>(i));
+      expected[i] = static_cast<double>(i);
+    }
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+    ASSERT_TRUE(column.num_sparse_chunks() == 0);
+#endif
+    CheckColumn(column, expected);
+
+    EXPECT_EXCEPTION(column.set(expected.size(), 1.0), std::out_of_range);
+    EXPECT_EXCEPTION((void)column.at(expected.size()), std::out_of_range);
+    ASSERT_TRUE(column.at(3) == 1.5);
+  }
+
+  // Whole chunks of empty elements.
+  {
+    tiny::sparse_column<tiny::optional<int, -1>, 64> column;
+    std::vector<std::optional<int>> expected;
+    column.push_back(7);
+    expected.push_back(7);
+    column.append_empty(1000);
+    expected.resize(expected.size() + 1000);
+    column.push_back(8);
+    expected.push_back(8);
+    CheckColumn(column, expected);
+    ASSERT_TRUE(column.num_sparse_chunks() == 15);
+    ASSERT_TRUE(column.memory_usage() < 1002 * sizeof(int) / 2);
+
+    column.set(50, 9);
+    expected[50] = 9;
+    CheckColumn(column, expected);
+
+    column.clear();
+    ASSERT_TRUE(column.empty());
+    ASSERT_TRUE(column.begin() == column.end());
+  }
+
+  // Random data with long runs, and a payload that is not trivially copyable.
+  {
+    std::mt19937 rng(42);
+    tiny::sparse_column<tiny::optional<std::string>, 128> column;
+    std::vector<std::optional<std::string>> expected;
+    bool present = false;
+    while (expected.size() < 5000) {
+      std::size_t const runLength = rng() % (present ? 10 : 300);
+      for (std::size_t i = 0; i < runLength; ++i) {
+        if (present) {
+          std::string const value = std::to_string(expected.size());
+          column.push_back(value);
+          expected.emplace_back(value);
+        }
+        else {
+          column.push_back(std::nullopt);
+          expected.emplace_back(std::nullopt);
+        }
+      }
+      present = !present;
+    }
+    ASSERT_TRUE(column.num_sparse_chunks() > 0);
+    CheckColumn(column, expected);
+  }
+}
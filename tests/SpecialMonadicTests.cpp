@@ -3,6 +3,9 @@
 #include "TestUtilities.h"
 #include "tiny/optional.h"
 
+#include <climits>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 
 
@@ -90,6 +93,65 @@ void test_SpecialTestsFor_transform()
 }
 
 
+
+void test_SpecialTestsFor_transformWithTargetOptional()
+{
+  // The returned optional type can be specified explicitly, so that e.g. sentinels keep the result small.
+  {
+    tiny::optional<double> const original = 2.5;
+    auto const transformed = original.transform<tiny::optional<int, -1>>([](double v) { return static_cast<int>(v); });
+    static_assert(std::is_same_v<std::remove_const_t<decltype(transformed)>, tiny::optional<int, -1>>);
+    static_assert(sizeof(transformed) == sizeof(int));
+    ASSERT_TRUE(transformed == 2);
+
+    using Target = tiny::optional<int, -1>;
+    tiny::optional<double> const empty;
+    ASSERT_TRUE(!empty.transform<Target>([](double v) { return static_cast<int>(v); }).has_value());
+  }
+
+  // UseOptionalAip infers a tiny::optional_aip of the type returned by the function.
+  {
+    tiny::optional<int, -1> original = 42;
+    auto transformed = std::move(original).transform<tiny::UseOptionalAip>([](int v) { return std::uint32_t(v) + 1; });
+    static_assert(std::is_same_v<decltype(transformed), tiny::optional_aip<std::uint32_t>>);
+    ASSERT_TRUE(transformed == 43u);
+
+    original.reset();
+    ASSERT_TRUE(!original.transform<tiny::UseOptionalAip>([](int v) { return std::int64_t{v}; }).has_value());
+  }
+
+  // The payload of the target optional may differ from the type returned by the function, as long as it is
+  // constructible from it.
+  {
+    tiny::optional<int, -1> original = 42;
+    auto const transformed = original.transform<tiny::optional_aip<std::int64_t>>([](int v) { return v * 2; });
+    static_assert(std::is_same_v<std::remove_const_t<decltype(transformed)>, tiny::optional_aip<std::int64_t>>);
+    ASSERT_TRUE(transformed == std::int64_t{84});
+  }
+
+  // Also for non-movable payloads, the target optional is directly initialized from the returned value. Here the empty
+  // state is stored in a member of the payload.
+  {
+    struct NonCopyableAndNonMovable
+    {
+      int value;
+
+      explicit NonCopyableAndNonMovable(int value)
+        : value(value)
+      {
+      }
+
+      NonCopyableAndNonMovable(NonCopyableAndNonMovable const &) = delete;
+      NonCopyableAndNonMovable(NonCopyableAndNonMovable &&) = delete;
+    };
+
+    using Target = tiny::optional<NonCopyableAndNonMovable, &NonCopyableAndNonMovable::value, INT_MIN>;
+    tiny::optional<int> original = 42;
+    Target const transformed = original.transform<Target>([](int v) { return NonCopyableAndNonMovable{v}; });
+    ASSERT_TRUE(transformed.value().value == 42);
+  }
+}
+
 void test_SpecialTestsFor_or_else()
 {
 #ifdef TINY_OPTIONAL_ENABLE_ORELSE
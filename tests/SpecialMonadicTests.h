@@ -4,4 +4,5 @@
 // But we need to tests a few additional things that do not fit there.
 void test_SpecialTestsFor_and_then();
 void test_SpecialTestsFor_transform();
+void test_SpecialTestsFor_transformWithTargetOptional();
 void test_SpecialTestsFor_or_else();
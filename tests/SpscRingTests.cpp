@@ -0,0 +1,108 @@
+#include "SpscRingTests.h"
+
+#include "TestUtilities.h"
+#include "tiny/spsc_ring.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+void test_SpscRing()
+{
+  using Optional = tiny::optional<std::uint64_t, ~0ull>;
+
+  // Single-threaded: Full and empty detection, wrap-around.
+  {
+    tiny::spsc_ring<Optional> ring(3);
+    ASSERT_TRUE(ring.capacity() == 4);
+    ASSERT_FALSE(ring.try_pop().has_value());
+
+    for (std::uint64_t round = 0; round < 5; ++round) {
+      for (std::uint64_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_push(round * 10 + i));
+      }
+      ASSERT_FALSE(ring.try_push(999));
+      ASSERT_TRUE(ring.try_pop() == round * 10);
+      ASSERT_TRUE(ring.try_push(round * 10 + 4));
+      for (std::uint64_t i = 1; i < 5; ++i) {
+        ASSERT_TRUE(ring.try_pop() == round * 10 + i);
+      }
+      ASSERT_FALSE(ring.try_pop().has_value());
+    }
+  }
+
+#ifndef TINY_OPTIONAL_USE_SEPARATE_BOOL_INSTEAD_OF_UNUSED_BITS
+  // Single-threaded batches, including partially fitting ones.
+  {
+    tiny::spsc_ring<tiny::optional<int *>> ring(8);
+    std::vector<int> objects(20);
+    std::vector<int *> pointers;
+    for (int & o : objects) {
+      pointers.push_back(&o);
+    }
+    pointers[3] = nullptr; // A nullptr is a valid value of tiny::optional<int*>.
+
+    ASSERT_TRUE(ring.try_push_batch(pointers.data(), 5) == 5);
+    ASSERT_TRUE(ring.try_push_batch(pointers.data() + 5, 5) == 3);
+    ASSERT_TRUE(ring.try_push_batch(pointers.data() + 8, 1) == 0);
+
+    std::vector<int *> out(20);
+    ASSERT_TRUE(ring.try_pop_batch(out.data(), 6) == 6);
+    ASSERT_TRUE(ring.try_push_batch(pointers.data() + 8, 12) == 6);
+    ASSERT_TRUE(ring.try_pop_batch(out.data() + 6, 20) == 8);
+    ASSERT_TRUE(ring.try_pop_batch(out.data() + 14, 20) == 0);
+    for (std::size_t i = 0; i < 14; ++i) {
+      ASSERT_TRUE(out[i] == pointers[i]);
+    }
+  }
+#endif
+
+  // One producer and one consumer thread transfer a sequence of numbers, mixing single and batched operations.
+  {
+    constexpr std::uint64_t numValues = 200000;
+    tiny::spsc_ring<Optional> ring(64);
+    std::thread producer([&] {
+      std::uint64_t next = 0;
+      std::vector<std::uint64_t> batch(16);
+      while (next < numValues) {
+        if (next % 3 == 0) {
+          if (!ring.try_push(next)) {
+            std::this_thread::yield();
+            continue;
+          }
+          ++next;
+        }
+        else {
+          std::size_t num = 0;
+          while (num < batch.size() && next + num < numValues) {
+            batch[num] = next + num;
+            ++num;
+          }
+          std::size_t const numPushed = ring.try_push_batch(batch.data(), num);
+          if (numPushed == 0) {
+            std::this_thread::yield();
+          }
+          next += numPushed;
+        }
+      }
+    });
+
+    std::uint64_t expected = 0;
+    bool inOrder = true;
+    std::vector<std::uint64_t> out(10);
+    while (expected < numValues) {
+      std::size_t const numPopped = ring.try_pop_batch(out.data(), expected % 2 == 0 ? out.size() : 1);
+      if (numPopped == 0) {
+        std::this_thread::yield();
+      }
+      for (std::size_t i = 0; i < numPopped; ++i) {
+        inOrder = inOrder && out[i] == expected;
+        ++expected;
+      }
+    }
+    producer.join();
+    ASSERT_TRUE(inOrder);
+    ASSERT_FALSE(ring.try_pop().has_value());
+  }
+}
@@ -1,15 +1,33 @@
+#include "AsyncSlotTests.h"
+#include "AtomicOptionalTests.h"
+#include "BulkConversionsTests.h"
 #include "ComparisonTests.h"
 #include "CompilationErrorTests.h"
+#include "ConcurrentHashTests.h"
+#include "ConstexprTests.h"
 #include "ConstructionTests.h"
 #include "ExerciseOptionalAIP.h"
 #include "ExerciseOptionalEmptyViaType.h"
 #include "ExerciseOptionalInplace.h"
 #include "ExerciseOptionalWithCustomFlagManipulator.h"
+#include "ExerciseOptionalWithHint.h"
 #include "ExerciseStdOptional.h"
 #include "ExerciseTinyOptionalPayload.h"
+#include "HashTests.h"
 #include "IntermediateTests.h"
+#include "MemoArrayTests.h"
+#include "MpmcQueueTests.h"
 #include "NatvisTests.h"
+#include "OnceCellTests.h"
+#include "OptionalBoxTests.h"
+#include "OptionalSpanTests.h"
+#include "ParallelAlgorithmsTests.h"
+#include "RelocationTests.h"
+#include "SeqlockOptionalTests.h"
+#include "SlotPoolTests.h"
+#include "SparseColumnTests.h"
 #include "SpecialMonadicTests.h"
+#include "SpscRingTests.h"
 #include "TestUtilities.h"
 #include "tiny/optional.h"
 
@@ -33,6 +51,7 @@ void RunTests()
          ADD_TEST(test_IsIntegralInRange),
          ADD_TEST(test_NanExploit),
          ADD_TEST(test_SelectDecomposition),
+         ADD_TEST(test_BitwiseValueOrAndSwap),
          ADD_TEST(test_TinyOptionalPayload_Bool),
          ADD_TEST(test_TinyOptionalPayload_FloatingPoint),
          ADD_TEST(test_TinyOptionalPayload_IntegersAndEnums),
@@ -51,17 +70,37 @@ void RunTests()
          ADD_TEST(test_TinyOptionalMoveAssignment),
          ADD_TEST(test_TinyOptionalDestruction),
          ADD_TEST(test_TinyOptionalConversions),
+         ADD_TEST(test_ConversionsBetweenOptionals),
          ADD_TEST(test_TinyOptionalWithRegisteredCustomFlagManipulator),
          ADD_TEST(test_OptionalEmptyViaType),
          ADD_TEST(test_OptionalInplace),
          ADD_TEST(test_OptionalAIP),
+         ADD_TEST(test_OptionalWithHint),
          ADD_TEST(test_CrosscheckStdOptional),
          ADD_TEST(test_Exceptions),
          ADD_TEST(test_MakeOptional),
          ADD_TEST(test_Comparisons),
          ADD_TEST(test_SpecialTestsFor_and_then),
          ADD_TEST(test_SpecialTestsFor_transform),
+         ADD_TEST(test_SpecialTestsFor_transformWithTargetOptional),
          ADD_TEST(test_SpecialTestsFor_or_else),
+         ADD_TEST(test_SlotPool),
+         ADD_TEST(test_OptionalSpan),
+         ADD_TEST(test_BulkConversions),
+         ADD_TEST(test_SparseColumn),
+         ADD_TEST(test_AtomicOptional),
+         ADD_TEST(test_OnceCell),
+         ADD_TEST(test_SpscRing),
+         ADD_TEST(test_MpmcQueue),
+         ADD_TEST(test_ConcurrentHash),
+         ADD_TEST(test_ParallelAlgorithms),
+         ADD_TEST(test_SeqlockOptional),
+         ADD_TEST(test_AsyncSlot),
+         ADD_TEST(test_MemoArray),
+         ADD_TEST(test_Constexpr),
+         ADD_TEST(test_Relocation),
+         ADD_TEST(test_Hash),
+         ADD_TEST(test_OptionalBox),
          ADD_TEST(test_ExpressionsThatShouldNotCompile)};
 
   for (size_t testIdx = 0; testIdx < tests.size(); ++testIdx) {